@@ -123,11 +123,11 @@ namespace Gui
     void backgroundAnimatedBottom(void);
 
     void clearTextBufs(void);
-    void dynamicText(const std::string& str, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY);
+    void dynamicText(std::string_view str, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY);
 
     C2D_Text cacheStaticText(const std::string& strKey);
     void clearStaticText(void);
-    void staticText(const std::string& strKey, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY);
+    void staticText(std::string_view strKey, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY);
 
     void setScreen(std::unique_ptr<Screen> screen);
     void screenBack(void);
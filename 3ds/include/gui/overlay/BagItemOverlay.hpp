@@ -33,19 +33,28 @@
 #include <string>
 #include "ClickButton.hpp"
 #include "gui.hpp"
+#include "searchindex.hpp"
 
 class BagItemOverlay : public Overlay
 {
 public:
-    BagItemOverlay(Screen& screen, std::vector<std::pair<const std::string*, int>>& items, size_t selected, std::pair<Pouch, int> pouch, int slot, int& firstEmpty)
+    BagItemOverlay(Screen& screen, std::vector<std::pair<std::string_view, int>>& items, size_t selected, std::pair<Pouch, int> pouch, int slot, int& firstEmpty)
         : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("L_PAGE_PREV") + '\n'
                           + i18n::localize("R_PAGE_NEXT") + '\n' + i18n::localize("B_BACK")),
-        hid(40,2), validItems(items), items(items), origItem(selected), pouch(pouch), slot(slot), firstEmpty(firstEmpty)
+        hid(40,2), validItems(items), search(i18n::itemIndex(Configuration::getInstance().language())), items(items), origItem(selected), pouch(pouch), slot(slot), firstEmpty(firstEmpty)
     {
         instructions.addBox(false, 75, 30, 170, 23, COLOR_GREY, i18n::localize("SEARCH"), COLOR_WHITE);
         searchButton = new ClickButton(75, 30, 170, 23, [this](){ startSearch = true; return false; }, ui_sheet_emulated_box_search_idx, "", 0, 0);
         hid.update(items.size());
         hid.select(selected);
+        for (size_t i = 1; i < validItems.size(); i++)
+        {
+            if ((size_t)validItems[i].second >= positions.size())
+            {
+                positions.resize(validItems[i].second + 1);
+            }
+            positions[validItems[i].second] = i;
+        }
     }
     ~BagItemOverlay()
     {
@@ -56,8 +65,11 @@ public:
 private:
     void searchBar();
     HidVertical hid;
-    const std::vector<std::pair<const std::string*, int>> validItems;
-    std::vector<std::pair<const std::string*, int>> items;
+    const std::vector<std::pair<std::string_view, int>> validItems;
+    // Position of each item id in validItems, or 0 for None and ids that aren't there
+    std::vector<int> positions;
+    SearchIndex::Search search;
+    std::vector<std::pair<std::string_view, int>> items;
     int origItem;
     std::pair<Pouch, int> pouch;
     int slot;
@@ -31,8 +31,8 @@
 #include "HidVertical.hpp"
 #include "Button.hpp"
 #include "PKX.hpp"
+#include "searchindex.hpp"
 #include <memory>
-#include <map>
 
 class LocationOverlay : public Overlay
 {
@@ -44,8 +44,9 @@ private:
     std::shared_ptr<PKX> pkm;
     void searchBar();
     HidVertical hid;
-    const std::map<u16, std::string>& validLocations;
-    std::map<u16, std::string> locations;
+    std::vector<std::pair<u16, std::string_view>> validLocations;
+    SearchIndex::Search search;
+    std::vector<std::pair<u16, std::string_view>> locations;
     std::string searchString = "";
     std::string oldSearchString = "";
     std::unique_ptr<Button> searchButton;
@@ -34,6 +34,7 @@
 #include "PK6.hpp"
 #include "loader.hpp"
 #include "Button.hpp"
+#include "searchindex.hpp"
 
 class MoveOverlay : public Overlay
 {
@@ -53,6 +54,9 @@ private:
     HidVertical hid;
     std::vector<std::pair<int, std::string>> moves;
     std::vector<std::pair<int, std::string>> validMoves;
+    // Position of each id in validMoves, or 0 for None and ids that aren't there
+    std::vector<int> positions;
+    SearchIndex::Search search;
     std::string searchString = "";
     std::string oldSearchString = "";
     Button* searchButton;
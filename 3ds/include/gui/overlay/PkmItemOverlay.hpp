@@ -32,6 +32,7 @@
 #include "Configuration.hpp"
 #include "loader.hpp"
 #include "Button.hpp"
+#include "searchindex.hpp"
 
 class PkmItemOverlay : public Overlay
 {
@@ -49,6 +50,9 @@ private:
     HidVertical hid;
     std::vector<std::pair<int, std::string>> items;
     std::vector<std::pair<int, std::string>> validItems;
+    // Position of each id in validItems, or 0 for None and ids that aren't there
+    std::vector<int> positions;
+    SearchIndex::Search search;
     std::string searchString = "";
     std::string oldSearchString = "";
     Button* searchButton;
@@ -31,6 +31,7 @@
 #include "HidHorizontal.hpp"
 #include "Button.hpp"
 #include "PKX.hpp"
+#include "searchindex.hpp"
 #include <memory>
 
 class SpeciesOverlay : public Overlay
@@ -51,6 +52,8 @@ private:
     std::string searchString = "";
     std::string oldSearchString = "";
     std::vector<int> dispPkm;
+    std::vector<int> validPkm;
+    SearchIndex::Search search;
     bool justSwitched = true;
 };
 
@@ -42,7 +42,7 @@ public:
 private:
     std::shared_ptr<PKX> pkm;
     HidVertical hid;
-    std::vector<std::pair<u8, const std::string&>> games;
+    std::vector<std::pair<u8, std::string_view>> games;
 };
 
 #endif
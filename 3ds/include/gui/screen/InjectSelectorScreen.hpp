@@ -49,7 +49,7 @@ private:
     bool toggleFilter(const std::string& lang);
     bool toggleFilter(u8 type);
     HidHorizontal hid;
-    std::vector<nlohmann::json> wondercards;
+    std::vector<MysteryGift::giftMatch> wondercards;
     std::vector<Button*> buttons;
     std::vector<ToggleButton*> langFilters;
     std::vector<ToggleButton*> typeFilters;
@@ -32,8 +32,13 @@
 
 namespace Threads
 {
-    void create(ThreadFunc entrypoint);
+    // priorityOffset is relative to the calling thread. Lower values run first, so the default preempts
+    // the caller and a positive offset only runs while the caller waits
+    void create(ThreadFunc entrypoint, size_t stackSize = 4*1024, s32 priorityOffset = -1);
     void destroy(void);
+    // Starts entrypoint(arg) on the New 3DS's extra application core, or returns nullptr on systems
+    // without one. The caller joins and frees the thread
+    Thread spare(ThreadFunc entrypoint, void* arg);
 }
 
 #endif
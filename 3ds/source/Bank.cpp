@@ -28,8 +28,10 @@
 #include "Configuration.hpp"
 #include "FSStream.hpp"
 #include "archive.hpp"
+#include "crc.hpp"
 #include "gui.hpp"
 #include "PB7.hpp"
+#include "PKXView.hpp"
 
 // TODO actually do stuff with the name
 Bank::Bank(const std::string& name, int maxBoxes) : bankName(name)
@@ -41,6 +43,66 @@ Bank::Bank(const std::string& name, int maxBoxes) : bankName(name)
     }
 }
 
+Bank::Bank(const std::string& name, ReadOnly) : bankName(name)
+{
+    std::string bankPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnk" : "/3ds/PKSM/banks/" + bankName + ".bnk";
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    FSStream in(archive, bankPath, FS_OPEN_READ);
+    BankHeader h{"BAD_MGC", 0, 0};
+    if (in.good())
+    {
+        size = in.size();
+        in.read((char*)&h, sizeof(BankHeader) - sizeof(int));
+    }
+    if (memcmp(&h, BANK_MAGIC.data(), 8))
+    {
+        // Missing or corrupt banks read as empty
+        in.close();
+        createBank(0);
+    }
+    else if (h.version < BANK_VERSION)
+    {
+        // Older versions are just the entries after the header, with the box count only from version 2
+        if (h.version == 1)
+        {
+            h.boxes = (size - (sizeof(BankHeader) - sizeof(int))) / sizeof(BankEntry) / 30;
+        }
+        else
+        {
+            in.read(&h.boxes, sizeof(int));
+        }
+        data = new u8[size = sizeof(BankHeader) + sizeof(BankEntry) * h.boxes * 30];
+        std::copy((char*)&h, (char*)(&h + 1), data);
+        std::fill_n(data + sizeof(BankHeader), sizeof(BankEntry) * h.boxes * 30, 0xFF);
+        in.read(data + sizeof(BankHeader), sizeof(BankEntry) * h.boxes * 30);
+        in.close();
+        rebuildIndex();
+    }
+    else
+    {
+        in.read(&h.boxes, sizeof(int));
+        data = new u8[size = sizeof(BankHeader) + sizeof(BankEntry) * h.boxes * 30];
+        std::copy((char*)&h, (char*)(&h + 1), data);
+        std::vector<bool> mismatched;
+        bool intact = readTables(in, mismatched);
+        in.close();
+        staleBoxes.assign(boxes(), false);
+        if (!intact || !readIndex())
+        {
+            rebuildIndex();
+        }
+        if (intact)
+        {
+            replayJournal();
+        }
+    }
+    if (boxNames.size() != (size_t)boxes())
+    {
+        createJSON();
+    }
+    resetTracking();
+}
+
 void Bank::load(int maxBoxes)
 {
     if (data)
@@ -48,7 +110,10 @@ void Bank::load(int maxBoxes)
         delete[] data;
         data = nullptr;
     }
-    needsCheck = false;
+    rewrite = true;
+    namesChanged = false;
+    tableSequence = 0;
+    journalRecords = 0;
     if (name() == "pksm_1" && io::exists("/3ds/PKSM/bank/bank.bin"))
     {
         convert();
@@ -59,6 +124,11 @@ void Bank::load(int maxBoxes)
         std::string jsonPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".json" : "/3ds/PKSM/banks/" + bankName + ".json";
         auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
         bool needSave = false;
+        // Versions before 3 keep the box names in a separate JSON file
+        bool namesInJson = true;
+        bool indexed = false;
+        bool compactNow = false;
+        recoverRewrite(bankPath);
         FSStream in(archive, bankPath, FS_OPEN_READ);
         if (in.good())
         {
@@ -86,14 +156,52 @@ void Bank::load(int maxBoxes)
                     h.version = BANK_VERSION;
                     needSave = true;
                 }
-                else
+                else if (h.version == 2)
                 {
                     data = new u8[size];
                     in.read(&h.boxes, sizeof(int));
+                    h.version = BANK_VERSION;
+                    needSave = true;
+                }
+                else
+                {
+                    in.read(&h.boxes, sizeof(int));
+                    data = new u8[size = sizeof(BankHeader) + sizeof(BankEntry) * h.boxes * 30];
+                    namesInJson = false;
                 }
                 std::copy((char*)&h, (char*)(&h + 1), data);
-                in.read(data + sizeof(BankHeader), size - sizeof(BankHeader));
-                in.close();
+                if (namesInJson)
+                {
+                    in.read(data + sizeof(BankHeader), size - sizeof(BankHeader));
+                    in.close();
+                }
+                else
+                {
+                    std::vector<bool> mismatched;
+                    bool intact = readTables(in, mismatched);
+                    in.close();
+                    staleBoxes.assign(boxes(), false);
+                    staleNames = false;
+                    bool journalClean = true;
+                    if (intact)
+                    {
+                        indexed = readIndex();
+                        journalClean = replayJournal();
+                        // Boxes restored from the journal may have been torn by an interrupted compaction
+                        for (int i = 0; i < boxes(); i++)
+                        {
+                            intact = intact && (!mismatched[i] || staleBoxes[i]);
+                        }
+                    }
+                    if (!intact)
+                    {
+                        Gui::warn(i18n::localize("BANK_CORRUPT"));
+                    }
+                    // The loaded file can be updated in place unless something in it was off
+                    rewrite = !intact;
+                    compactNow = !rewrite && (!journalClean || journalRecords >= JOURNAL_LIMIT ||
+                                                 (journalRecords != 0 && !Configuration::getInstance().bankJournal()));
+                }
             }
         }
         else
@@ -103,59 +211,55 @@ void Bank::load(int maxBoxes)
             createBank(maxBoxes);
             needSave = true;
         }
-        
-        in = FSStream(archive, StringUtils::UTF8toUTF16(jsonPath), FS_OPEN_READ);
-        if (in.good())
+
+        if (!indexed)
         {
-            size_t jsonSize = in.size();
-            char jsonData[jsonSize + 1];
-            in.read(jsonData, jsonSize);
-            in.close();
-            jsonData[jsonSize] = '\0';
-            boxNames = nlohmann::json::parse(jsonData, nullptr, false);
-            if (boxNames.is_discarded())
+            rebuildIndex();
+        }
+        if (compactNow)
+        {
+            writeBank();
+        }
+
+        if (namesInJson)
+        {
+            in = FSStream(archive, StringUtils::UTF8toUTF16(jsonPath), FS_OPEN_READ);
+            if (in.good())
             {
-                createJSON();
-                needSave = true;
+                size_t jsonSize = in.size();
+                char jsonData[jsonSize + 1];
+                in.read(jsonData, jsonSize);
+                in.close();
+                jsonData[jsonSize] = '\0';
+                boxNames = nlohmann::json::parse(jsonData, nullptr, false);
+                if (boxNames.is_discarded())
+                {
+                    createJSON();
+                }
             }
             else
             {
-                for (int i = boxNames.size(); i < boxes(); i++)
-                {
-                    boxNames[i] = i18n::localize("STORAGE") + " " + std::to_string(i + 1);
-                    if (!needSave)
-                    {
-                        needSave = true;
-                    }
-                }
+                in.close();
+                createJSON();
             }
         }
-        else
+        for (int i = boxNames.size(); i < boxes(); i++)
         {
-            in.close();
-            boxNames = nlohmann::json::array();
-            for (int i = 0; i < boxes(); i++)
-            {
-                boxNames[i] = i18n::localize("STORAGE") + " " + std::to_string(i + 1);
-            }
-
+            boxNames[i] = i18n::localize("STORAGE") + " " + std::to_string(i + 1);
             needSave = true;
         }
-
         if (boxes() != maxBoxes)
         {
             resize(maxBoxes);
         }
-        
-        if (needSave)
-        {
-            save();
-        }
-        else
+
+        if (needSave && save() && namesInJson)
         {
-            sha256(prevHash.data(), data, size);
+            // The names now live in the bank file itself
+            FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(jsonPath).c_str()));
         }
     }
+    resetTracking();
 
     if (Configuration::getInstance().autoBackup())
     {
@@ -164,61 +268,514 @@ void Bank::load(int maxBoxes)
 }
 
 bool Bank::save() const
+{
+    Gui::waitFrame(i18n::localize("BANK_SAVE"));
+
+    Result res = 0;
+    if (!rewrite && Configuration::getInstance().bankJournal() && journalRecords + pendingRecords() <= JOURNAL_LIMIT)
+    {
+        res = appendJournal();
+        if (R_SUCCEEDED(res) && journalRecords >= JOURNAL_LIMIT)
+        {
+            res = writeBank();
+        }
+    }
+    else
+    {
+        markStale();
+        res = writeBank();
+    }
+
+    if (R_FAILED(res))
+    {
+        Gui::error(i18n::localize("BANK_SAVE_ERROR"), res);
+        return false;
+    }
+    namesChanged = false;
+    resetTracking();
+    return true;
+}
+
+bool Bank::compact() const
+{
+    // Unsaved edits would end up in the bank file along with the journaled ones
+    if (hasChanged())
+    {
+        return false;
+    }
+    if (journalRecords == 0 && !rewrite)
+    {
+        return true;
+    }
+    Result res = writeBank();
+    if (R_FAILED(res))
+    {
+        Gui::error(i18n::localize("BANK_SAVE_ERROR"), res);
+        return false;
+    }
+    return true;
+}
+
+void Bank::markStale() const
+{
+    // A full rewrite covers everything anyway
+    if (rewrite)
+    {
+        return;
+    }
+    for (int slot : changedSlots())
+    {
+        staleBoxes[slot / 30] = true;
+    }
+    staleNames = staleNames || namesChanged;
+}
+
+Result Bank::writeBank() const
 {
     std::string bankPath;
-    std::string jsonPath;
     FS_Archive archive;
     if (Configuration::getInstance().useExtData())
     {
         bankPath = "/banks/" + bankName + ".bnk";
-        jsonPath = "/banks/" + bankName + ".json";
         archive = Archive::data();
     }
     else
     {
         bankPath = "/3ds/PKSM/banks/" + bankName + ".bnk";
-        jsonPath = "/3ds/PKSM/banks/" + bankName + ".json";
         archive = Archive::sd();
     }
-    Gui::waitFrame(i18n::localize("BANK_SAVE"));
-    FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(bankPath).c_str()));
-    FSStream out(archive, bankPath, FS_OPEN_WRITE, sizeof(BankHeader) + sizeof(BankEntry) * boxes() * 30);
-    if (out.good())
+
+    Result res = 0;
+    bool whole = rewrite;
+    if (!rewrite)
     {
-        out.write(data, sizeof(BankHeader) + sizeof(BankEntry) * boxes() * 30);
-        out.close();
+        FSStream out(archive, bankPath, FS_OPEN_WRITE);
+        // Anything that doesn't look like the file we loaded gets rewritten from scratch
+        if (out.good() && out.size() == fileSize(boxes()))
+        {
+            res = writeChanges(out);
+            out.close();
+        }
+        else
+        {
+            out.close();
+            rewrite = whole = true;
+        }
+    }
+    if (rewrite)
+    {
+        std::vector<u16> checksums;
+        // Bump the sequence so a journal written against the old file is never replayed onto this one
+        res = writeWhole(rewritePath(), tableSequence + 1, checksums);
+        if (R_SUCCEEDED(res))
+        {
+            res = writeWhole(bankPath, tableSequence + 1, checksums);
+        }
+        if (R_SUCCEEDED(res))
+        {
+            FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(rewritePath()).c_str()));
+            boxChecksums = std::move(checksums);
+            tableSequence++;
+        }
+    }
+
+    if (R_SUCCEEDED(res))
+    {
+        writeIndex(whole);
+        rewrite = false;
+        staleBoxes.assign(boxes(), false);
+        staleNames = false;
+        // Everything journaled is in the bank file now
+        resetJournal();
+    }
+    return res;
+}
+
+std::string Bank::rewritePath() const
+{
+    return Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnkt" : "/3ds/PKSM/banks/" + bankName + ".bnkt";
+}
+
+bool Bank::completeFile(const std::vector<u8>& file)
+{
+    if (file.size() < sizeof(BankHeader))
+    {
+        return false;
+    }
+    const BankHeader* header = (const BankHeader*)file.data();
+    if (memcmp(header->MAGIC, BANK_MAGIC.data(), BANK_MAGIC.size()) || header->version != BANK_VERSION || header->boxes <= 0 ||
+        file.size() != fileSize(header->boxes))
+    {
+        return false;
+    }
+    // writeFile puts the same table in both copies and the entries last, so an intact first table whose
+    // checksums match every box means the whole file made it
+    u32 len = tableSize(header->boxes);
+    const u8* table = file.data() + sizeof(BankHeader);
+    if (((const TableHeader*)table)->checksum != tableChecksum(table, len))
+    {
+        return false;
+    }
+    const BoxInfo* info = (const BoxInfo*)(table + sizeof(TableHeader));
+    const u8* entries = table + 2 * len;
+    for (int i = 0; i < header->boxes; i++)
+    {
+        if (info[i].checksum != CRC::ccitt16(entries + sizeof(BankEntry) * i * 30, sizeof(BankEntry) * 30))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Bank::recoverRewrite(const std::string& bankPath)
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    std::u16string tempPath = StringUtils::UTF8toUTF16(rewritePath());
+    FSStream in(archive, tempPath, FS_OPEN_READ);
+    if (!in.good())
+    {
+        in.close();
+        return;
+    }
+    std::vector<u8> file(in.size());
+    in.read(file.data(), file.size());
+    in.close();
 
-        std::string jsonData = boxNames.dump(2);
-        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(jsonPath).c_str()));
-        out = FSStream(archive, jsonPath, FS_OPEN_WRITE, jsonData.size());
+    // A torn copy means the bank file was never touched, so it's simply dropped
+    if (completeFile(file))
+    {
+        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(bankPath).c_str()));
+        FSStream out(archive, bankPath, FS_OPEN_WRITE, file.size());
         if (out.good())
         {
-            out.write(jsonData.data(), jsonData.size() + 1);
-            sha256(prevHash.data(), data, sizeof(BankHeader) + sizeof(BankEntry) * boxes() * 30);
+            out.write(file.data(), file.size());
         }
-        else
+        Result res = out.result();
+        out.close();
+        if (R_FAILED(res))
         {
-            Gui::error(i18n::localize("BANK_NAME_ERROR"), out.result());
+            // Keep the copy for the next attempt
+            return;
         }
+    }
+    FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, tempPath.c_str()));
+}
+
+std::string Bank::journalPath() const
+{
+    return Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnkj" : "/3ds/PKSM/banks/" + bankName + ".bnkj";
+}
+
+u32 Bank::journalSize()
+{
+    return sizeof(JournalHeader) + sizeof(JournalRecord) * JOURNAL_LIMIT;
+}
+
+u32 Bank::pendingRecords() const
+{
+    return dirtyCount + std::count(renamed.begin(), renamed.end(), true) + 1;
+}
+
+u16 Bank::recordChecksum(const JournalRecord& record)
+{
+    const u8* bytes = (const u8*)&record;
+    u16 crc = CRC::ccitt16(bytes, offsetof(JournalRecord, checksum));
+    return CRC::ccitt16(bytes + offsetof(JournalRecord, entry), sizeof(JournalRecord) - offsetof(JournalRecord, entry), crc);
+}
+
+void Bank::resetJournal() const
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    std::u16string path = StringUtils::UTF8toUTF16(journalPath());
+    journalRecords = 0;
+    if (!Configuration::getInstance().bankJournal())
+    {
+        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, path.c_str()));
+        return;
+    }
+
+    JournalHeader header{};
+    std::copy(JOURNAL_MAGIC.begin(), JOURNAL_MAGIC.end(), header.MAGIC);
+    header.sequence = tableSequence;
+    header.records = 0;
+    // An existing journal of the right size is reused by rewriting its header
+    FSStream out(archive, path, FS_OPEN_WRITE);
+    if (!out.good() || out.size() != journalSize())
+    {
         out.close();
-        return true;
+        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, path.c_str()));
+        out = FSStream(archive, path, FS_OPEN_WRITE, journalSize());
     }
-    else
+    if (out.good())
+    {
+        out.write(&header, sizeof(JournalHeader));
+    }
+    out.close();
+}
+
+Result Bank::appendJournal() const
+{
+    BankEntry* bank = (BankEntry*)(data + sizeof(BankHeader));
+    std::vector<JournalRecord> records;
+    for (int slot : changedSlots())
+    {
+        JournalRecord& record = records.emplace_back();
+        record.op = JournalOp::Slot;
+        record.index = slot;
+        record.entry = bank[slot];
+        staleBoxes[slot / 30] = true;
+    }
+    for (int box = 0; box < boxes(); box++)
+    {
+        if (renamed[box])
+        {
+            JournalRecord& record = records.emplace_back();
+            std::string name = boxNames[box].get<std::string>();
+            record.op = JournalOp::Name;
+            record.index = box;
+            std::copy_n(name.data(), std::min(name.size(), sizeof(BoxInfo::name)), record.name);
+            staleNames = true;
+        }
+    }
+    if (records.empty())
+    {
+        return 0;
+    }
+    // Nothing before this record is applied on load unless it made it to the card
+    records.emplace_back().op = JournalOp::Commit;
+    for (auto& record : records)
+    {
+        record.checksum = recordChecksum(record);
+    }
+
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    FSStream out(archive, journalPath(), FS_OPEN_WRITE);
+    if (!out.good() || out.size() != journalSize())
     {
-        Gui::error(i18n::localize("BANK_SAVE_ERROR"), out.result());
         out.close();
+        resetJournal();
+        out = FSStream(archive, journalPath(), FS_OPEN_WRITE);
+        if (!out.good())
+        {
+            Result res = out.result();
+            out.close();
+            return res;
+        }
+    }
+    out.seek(sizeof(JournalHeader) + sizeof(JournalRecord) * journalRecords, SEEK_SET);
+    out.write(records.data(), sizeof(JournalRecord) * records.size());
+    Result res = out.result();
+    if (R_SUCCEEDED(res))
+    {
+        // The records only count once the header says so
+        u32 count = journalRecords + records.size();
+        out.seek(offsetof(JournalHeader, records), SEEK_SET);
+        out.write(&count, sizeof(u32));
+        res = out.result();
+    }
+    out.close();
+    if (R_SUCCEEDED(res))
+    {
+        journalRecords += records.size();
+    }
+    return res;
+}
+
+bool Bank::replayJournal()
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    FSStream in(archive, journalPath(), FS_OPEN_READ);
+    if (!in.good())
+    {
+        in.close();
+        return true;
+    }
+    JournalHeader header{};
+    bool valid = in.size() == journalSize() && in.read(&header, sizeof(JournalHeader)) == sizeof(JournalHeader);
+    // A journal from before the last compaction is already part of the bank file
+    if (!valid || memcmp(header.MAGIC, JOURNAL_MAGIC.data(), JOURNAL_MAGIC.size()) || header.sequence != tableSequence ||
+        header.records > JOURNAL_LIMIT)
+    {
+        in.close();
         return false;
     }
+    std::vector<JournalRecord> journal(header.records);
+    in.read(journal.data(), sizeof(JournalRecord) * journal.size());
+    in.close();
 
-    needsCheck = false;
+    BankEntry* bank = (BankEntry*)(data + sizeof(BankHeader));
+    const JournalRecord* records = journal.data();
+    size_t count = journal.size();
+    size_t committed = 0;
+    for (size_t i = 0; i < count && records[i].checksum == recordChecksum(records[i]); i++)
+    {
+        if (records[i].op == JournalOp::Commit)
+        {
+            for (size_t j = committed; j < i; j++)
+            {
+                if (records[j].op == JournalOp::Slot && records[j].index < boxes() * 30)
+                {
+                    bank[records[j].index] = records[j].entry;
+                    staleBoxes[records[j].index / 30] = true;
+                    indexSlot(records[j].index);
+                }
+                else if (records[j].op == JournalOp::Name && records[j].index < boxes())
+                {
+                    boxNames[records[j].index] = std::string(records[j].name, strnlen(records[j].name, sizeof(BoxInfo::name)));
+                    staleNames = true;
+                }
+            }
+            committed = i + 1;
+        }
+    }
+    // Records after the last commit were torn by a crash and are dropped
+    journalRecords = committed;
+    return committed == count;
+}
+
+u32 Bank::tableSize(int boxes)
+{
+    return sizeof(TableHeader) + sizeof(BoxInfo) * boxes;
+}
+
+u32 Bank::fileSize(int boxes)
+{
+    return sizeof(BankHeader) + 2 * tableSize(boxes) + sizeof(BankEntry) * boxes * 30;
+}
+
+u16 Bank::boxChecksum(int box) const
+{
+    return CRC::ccitt16(data + sizeof(BankHeader) + sizeof(BankEntry) * box * 30, sizeof(BankEntry) * 30);
+}
+
+std::vector<u8> Bank::buildTable(u32 sequence, const std::vector<u16>& checksums) const
+{
+    std::vector<u8> table(tableSize(boxes()), 0);
+    TableHeader* header = (TableHeader*)table.data();
+    BoxInfo* info = (BoxInfo*)(table.data() + sizeof(TableHeader));
+    header->sequence = sequence;
+    for (int i = 0; i < boxes(); i++)
+    {
+        std::string name = boxNames[i].get<std::string>();
+        std::copy_n(name.data(), std::min(name.size(), sizeof(BoxInfo::name)), info[i].name);
+        info[i].checksum = checksums[i];
+    }
+    header->checksum = tableChecksum(table.data(), table.size());
+    return table;
+}
+
+u16 Bank::tableChecksum(const u8* table, u32 len)
+{
+    // Covers the sequence number and every box entry, so an all-zero table doesn't pass
+    u16 crc = CRC::ccitt16(table, sizeof(TableHeader::sequence));
+    return CRC::ccitt16(table + sizeof(TableHeader), len - sizeof(TableHeader), crc);
+}
+
+bool Bank::readTables(FSStream& in, std::vector<bool>& mismatched)
+{
+    u32 len = tableSize(boxes());
+    std::vector<u8> tables(2 * len);
+    // A truncated file leaves empty slots behind and fails the checks below
+    std::fill_n(data + sizeof(BankHeader), sizeof(BankEntry) * boxes() * 30, 0xFF);
+    in.read(tables.data(), tables.size());
+    in.read(data + sizeof(BankHeader), sizeof(BankEntry) * boxes() * 30);
+
+    boxChecksums.resize(boxes());
+    for (int i = 0; i < boxes(); i++)
+    {
+        boxChecksums[i] = boxChecksum(i);
+    }
+
+    // Take the newest copy of the table that is intact
+    const u8* table = nullptr;
+    for (int copy = 0; copy < 2; copy++)
+    {
+        const u8* candidate = tables.data() + copy * len;
+        const TableHeader* header = (const TableHeader*)candidate;
+        if (header->checksum == tableChecksum(candidate, len) &&
+            (!table || header->sequence > ((const TableHeader*)table)->sequence))
+        {
+            table = candidate;
+        }
+    }
+
+    boxNames = nlohmann::json::array();
+    mismatched.assign(boxes(), false);
+    if (table)
+    {
+        tableSequence = ((const TableHeader*)table)->sequence;
+        const BoxInfo* info = (const BoxInfo*)(table + sizeof(TableHeader));
+        for (int i = 0; i < boxes(); i++)
+        {
+            boxNames[i] = std::string(info[i].name, strnlen(info[i].name, sizeof(BoxInfo::name)));
+            mismatched[i] = info[i].checksum != boxChecksums[i];
+        }
+    }
+    return table != nullptr;
+}
+
+Result Bank::writeFile(FSStream& out, u32 sequence, std::vector<u16>& checksums) const
+{
+    checksums.resize(boxes());
+    for (int i = 0; i < boxes(); i++)
+    {
+        checksums[i] = boxChecksum(i);
+    }
+    std::vector<u8> table = buildTable(sequence, checksums);
+    out.write(data, sizeof(BankHeader));
+    out.write(table.data(), table.size());
+    out.write(table.data(), table.size());
+    out.write(data + sizeof(BankHeader), sizeof(BankEntry) * boxes() * 30);
+    return out.result();
+}
+
+Result Bank::writeWhole(const std::string& path, u32 sequence, std::vector<u16>& checksums) const
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(path).c_str()));
+    FSStream out(archive, path, FS_OPEN_WRITE, fileSize(boxes()));
+    Result res = out.good() ? writeFile(out, sequence, checksums) : out.result();
+    out.close();
+    return res;
+}
+
+Result Bank::writeChanges(FSStream& out) const
+{
+    bool wrote = false;
+    for (int box = 0; box < boxes(); box++)
+    {
+        if (staleBoxes[box])
+        {
+            out.seek(sizeof(BankHeader) + 2 * tableSize(boxes()) + sizeof(BankEntry) * box * 30, SEEK_SET);
+            out.write(data + sizeof(BankHeader) + sizeof(BankEntry) * box * 30, sizeof(BankEntry) * 30);
+            if (R_FAILED(out.result()))
+            {
+                return out.result();
+            }
+            boxChecksums[box] = boxChecksum(box);
+            wrote = true;
+        }
+    }
+
+    if (wrote || staleNames)
+    {
+        // Overwrite the older copy, so a torn write still leaves the previous table to load
+        std::vector<u8> table = buildTable(tableSequence + 1, boxChecksums);
+        out.seek(sizeof(BankHeader) + ((tableSequence + 1) % 2) * table.size(), SEEK_SET);
+        out.write(table.data(), table.size());
+        if (R_FAILED(out.result()))
+        {
+            return out.result();
+        }
+        tableSequence++;
+    }
+    return 0;
 }
 
 void Bank::resize(size_t boxes)
 {
     size_t newSize = sizeof(BankHeader) + sizeof(BankEntry) * boxes * 30;
-    std::string bankPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnk" : "/3ds/PKSM/banks/" + bankName + ".bnk";
-    std::string jsonPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".json" : "/3ds/PKSM/banks/" + bankName + ".json";
-    FS_Archive archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
     if (newSize != size)
     {
         Gui::showResizeStorage();
@@ -231,10 +788,12 @@ void Bank::resize(size_t boxes)
         }
         data = newData;
 
-        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(bankPath).c_str()));
-        FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(jsonPath).c_str()));
-
         ((BankHeader*)data)->boxes = boxes;
+        slotIndex.resize(boxes * 30);
+        // Done before saving, as a failed save still leaves the bank at its new size
+        resizeTracking();
+        // Every offset in the file moves, so it has to be written out whole
+        rewrite = true;
 
         for (size_t i = boxNames.size(); i < boxes; i++)
         {
@@ -246,59 +805,70 @@ void Bank::resize(size_t boxes)
     size = newSize;
 }
 
+std::vector<int> Bank::find(const BankIndex::Query& query) const
+{
+    std::vector<int> ret = slotIndex.find(query);
+    if (query.otName)
+    {
+        // The index only has a hash of each name, so rule out collisions against the names themselves
+        BankEntry* entries = (BankEntry*)(data + sizeof(BankHeader));
+        ret.erase(std::remove_if(ret.begin(), ret.end(),
+                      [&](int index) {
+                          return BankIndex::otName(entries[index].gen, entries[index].data, isParty(entries[index])) !=
+                                 *query.otName;
+                      }),
+            ret.end());
+    }
+    return ret;
+}
+
+u32 Bank::find(const PKFilter& filter, int box) const
+{
+    u32 ret = 0;
+    const BankEntry* entries = (const BankEntry*)(data + sizeof(BankHeader)) + box * 30;
+    for (int slot = 0; slot < 30; slot++)
+    {
+        if (filter.matches(entries[slot].gen, entries[slot].data))
+        {
+            ret |= 1 << slot;
+        }
+    }
+    return ret;
+}
+
+bool Bank::isParty(const BankEntry& entry)
+{
+    u32 boxLength = entry.gen == Generation::FOUR || entry.gen == Generation::FIVE ? 136 : 232;
+    for (int i = 260; i > (int)boxLength; i--)
+    {
+        if (entry.data[i] != 0xFF)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::shared_ptr<PKX> Bank::pkm(int box, int slot) const
 {
     BankEntry* bank = (BankEntry*)(data + sizeof(BankHeader));
     int index = box * 30 + slot;
-    bool party = false;
     switch (bank[index].gen)
     {
         case Generation::FOUR:
-            for (int i = 260; i > 136; i--)
-            {
-                if (bank[index].data[i] != 0xFF)
-                {
-                    party = true;
-                    break;
-                }
-            }
-            return std::make_shared<PK4>(bank[index].data, false, party);
+            return PKX::create<PK4>(bank[index].data, false, isParty(bank[index]));
 
         case Generation::FIVE:
-            for (int i = 260; i > 136; i--)
-            {
-                if (bank[index].data[i] != 0xFF)
-                {
-                    party = true;
-                    break;
-                }
-            }
-            return std::make_shared<PK5>(bank[index].data, false, party);
+            return PKX::create<PK5>(bank[index].data, false, isParty(bank[index]));
 
         case Generation::SIX:
-            for (int i = 260; i > 232; i--)
-            {
-                if (bank[index].data[i] != 0xFF)
-                {
-                    party = true;
-                    break;
-                }
-            }
-            return std::make_shared<PK6>(bank[index].data, false, party);
+            return PKX::create<PK6>(bank[index].data, false, isParty(bank[index]));
 
         case Generation::SEVEN:
-            for (int i = 260; i > 232; i--)
-            {
-                if (bank[index].data[i] != 0xFF)
-                {
-                    party = true;
-                    break;
-                }
-            }
-            return std::make_shared<PK7>(bank[index].data, false, party);
+            return PKX::create<PK7>(bank[index].data, false, isParty(bank[index]));
 
         case Generation::LGPE:
-            return std::make_shared<PB7>(bank[index].data, false);
+            return PKX::create<PB7>(bank[index].data, false);
 
         case Generation::UNUSED:
         default:
@@ -306,6 +876,35 @@ std::shared_ptr<PKX> Bank::pkm(int box, int slot) const
     }
 }
 
+PKX& Bank::pkmView(PKXView& view, int box, int slot)
+{
+    BankEntry* bank = (BankEntry*)(data + sizeof(BankHeader));
+    int index = box * 30 + slot;
+    prime(index);
+    switch (bank[index].gen)
+    {
+        case Generation::FOUR:
+            return view.emplace<PK4>(bank[index].data, false, isParty(bank[index]), true);
+
+        case Generation::FIVE:
+            return view.emplace<PK5>(bank[index].data, false, isParty(bank[index]), true);
+
+        case Generation::SIX:
+            return view.emplace<PK6>(bank[index].data, false, isParty(bank[index]), true);
+
+        case Generation::SEVEN:
+            return view.emplace<PK7>(bank[index].data, false, isParty(bank[index]), true);
+
+        case Generation::LGPE:
+            return view.emplace<PB7>(bank[index].data, false, true);
+
+        case Generation::UNUSED:
+        default:
+            // Empty entries are all 0xFF, so give back an owned blank instead
+            return view.emplace<PK7>();
+    }
+}
+
 void Bank::pkm(std::shared_ptr<PKX> pkm, int box, int slot)
 {
     BankEntry* bank = (BankEntry*)(data + sizeof(BankHeader));
@@ -314,8 +913,9 @@ void Bank::pkm(std::shared_ptr<PKX> pkm, int box, int slot)
     if (pkm->species() == 0)
     {
         std::fill_n((char*) &newEntry, sizeof(BankEntry), 0xFF);
+        prime(index);
         bank[index] = newEntry;
-        needsCheck = true;
+        markSlot(index);
         return;
     }
     newEntry.gen = pkm->generation();
@@ -324,25 +924,21 @@ void Bank::pkm(std::shared_ptr<PKX> pkm, int box, int slot)
     {
         std::fill_n(newEntry.data + pkm->getLength(), 260 - pkm->getLength(), 0xFF);
     }
+    prime(index);
     bank[index] = newEntry;
-    needsCheck = true;
+    markSlot(index);
 }
 
 void Bank::backup() const
 {
     Gui::waitFrame(i18n::localize("BANK_BACKUP"));
     std::string bankPath = "/3ds/PKSM/backups/" + bankName + ".bnk.bak";
-    std::string jsonPath = "/3ds/PKSM/backups/" + bankName + ".json.bak";
     FSUSER_DeleteFile(Archive::sd(), fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(bankPath).c_str()));
-    FSUSER_DeleteFile(Archive::sd(), fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(jsonPath).c_str()));
-
-    FSStream out(Archive::sd(), bankPath, FS_OPEN_WRITE, size);
-    out.write(data, size);
-    out.close();
 
-    std::string jsonData = boxNames.dump(2);
-    out = FSStream(Archive::sd(), jsonPath, FS_OPEN_WRITE, jsonData.size());
-    out.write(jsonData.data(), jsonData.size());
+    FSStream out(Archive::sd(), bankPath, FS_OPEN_WRITE, fileSize(boxes()));
+    // The checksums describe the snapshot, not the bank file, so they aren't kept
+    std::vector<u16> checksums;
+    writeFile(out, tableSequence, checksums);
     out.close();
 }
 
@@ -353,7 +949,12 @@ std::string Bank::boxName(int box) const
 
 void Bank::boxName(std::string name, int box)
 {
-    boxNames[box] = name;
+    if (boxNames[box] != name)
+    {
+        boxNames[box] = name;
+        renamed[box] = true;
+        namesChanged = true;
+    }
 }
 
 void Bank::createJSON()
@@ -380,20 +981,195 @@ void Bank::createBank(int maxBoxes)
 
 bool Bank::hasChanged() const
 {
-    if (!needsCheck)
+    return dirtyCount != 0 || namesChanged;
+}
+
+std::vector<int> Bank::changedSlots() const
+{
+    std::vector<int> ret;
+    for (size_t i = 0; i < dirty.size(); i++)
     {
-        return false;
+        if (dirty[i])
+        {
+            ret.push_back(i);
+        }
+    }
+    return ret;
+}
+
+u64 Bank::digest(const BankEntry& entry)
+{
+    // 64-bit FNV-1a; only used to tell whether a slot went back to its saved bytes
+    const u8* bytes = (const u8*)&entry;
+    u64 hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < sizeof(BankEntry); i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001B3;
     }
-    u8 hash[SHA256_BLOCK_SIZE];
-    sha256(hash, data, sizeof(BankHeader) + sizeof(BankEntry) * boxes() * 30);
-    if (memcmp(hash, prevHash.data(), SHA256_BLOCK_SIZE))
+    return hash;
+}
+
+void Bank::prime(int index)
+{
+    if (!primed[index])
     {
-        return true;
+        savedDigests[index] = digest(((BankEntry*)(data + sizeof(BankHeader)))[index]);
+        primed[index] = true;
+    }
+}
+
+void Bank::markSlot(int index)
+{
+    writeCount++;
+    bool changed = true;
+    // A slot written without being primed first has unknown saved contents, so it stays dirty
+    if (primed[index])
+    {
+        changed = digest(((BankEntry*)(data + sizeof(BankHeader)))[index]) != savedDigests[index];
+    }
+    if (changed != dirty[index])
+    {
+        dirty[index] = changed;
+        dirtyCount += changed ? 1 : -1;
+    }
+    indexSlot(index);
+}
+
+void Bank::resizeTracking() const
+{
+    size_t slots = boxes() * 30;
+    for (size_t i = slots; i < dirty.size(); i++)
+    {
+        if (dirty[i])
+        {
+            dirtyCount--;
+        }
     }
-    needsCheck = false;
+    savedDigests.resize(slots, 0);
+    primed.resize(slots, false);
+    dirty.resize(slots, false);
+    renamed.resize(boxes(), false);
+    staleBoxes.resize(boxes(), false);
+}
+
+void Bank::resetTracking() const
+{
+    size_t slots = boxes() * 30;
+    if (dirty.size() != slots)
+    {
+        savedDigests.assign(slots, 0);
+        primed.assign(slots, false);
+        dirty.assign(slots, false);
+    }
+    else if (dirtyCount != 0)
+    {
+        for (size_t i = 0; i < slots; i++)
+        {
+            if (dirty[i])
+            {
+                // What was saved is the current contents; re-prime on the next write
+                primed[i] = false;
+                dirty[i] = false;
+            }
+        }
+    }
+    dirtyCount = 0;
+    renamed.assign(boxes(), false);
+}
+
+std::string Bank::indexPath() const
+{
+    return Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnki" : "/3ds/PKSM/banks/" + bankName + ".bnki";
+}
+
+void Bank::indexSlot(int slot)
+{
+    BankEntry& entry = ((BankEntry*)(data + sizeof(BankHeader)))[slot];
+    slotIndex.update(slot, entry.gen, entry.data, isParty(entry));
+}
+
+void Bank::rebuildIndex()
+{
+    slotIndex.resize(boxes() * 30);
+    for (int i = 0; i < boxes() * 30; i++)
+    {
+        indexSlot(i);
+    }
+    indexOnDisk = false;
+}
+
+bool Bank::readIndex()
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    size_t slots = boxes() * 30;
+    FSStream in(archive, indexPath(), FS_OPEN_READ);
+    if (in.good() && in.size() == sizeof(IndexHeader) + sizeof(BankIndex::Entry) * slots)
+    {
+        IndexHeader header;
+        in.read(&header, sizeof(IndexHeader));
+        if (!memcmp(header.MAGIC, INDEX_MAGIC.data(), INDEX_MAGIC.size()) && header.sequence == tableSequence &&
+            header.boxes == (u32)boxes())
+        {
+            std::vector<BankIndex::Entry> entries(slots);
+            in.read(entries.data(), sizeof(BankIndex::Entry) * slots);
+            in.close();
+            slotIndex.assign(entries.data(), slots);
+            indexOnDisk = true;
+            return true;
+        }
+    }
+    in.close();
+    slotIndex.resize(slots);
     return false;
 }
 
+void Bank::writeIndex(bool whole) const
+{
+    auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    u32 len = sizeof(IndexHeader) + sizeof(BankIndex::Entry) * slotIndex.size();
+    IndexHeader header{};
+    // Written first and fixed up last, so an interrupted write leaves an index that gets rebuilt
+    IndexHeader invalid{};
+    std::copy(INDEX_MAGIC.begin(), INDEX_MAGIC.end(), header.MAGIC);
+    header.sequence = tableSequence;
+    header.boxes    = boxes();
+
+    // Only the stale boxes need writing if the rest of the file is what was loaded
+    if (!whole && indexOnDisk)
+    {
+        FSStream out(archive, indexPath(), FS_OPEN_WRITE);
+        if (out.good() && out.size() == len)
+        {
+            out.write(&invalid, sizeof(IndexHeader));
+            for (int box = 0; box < boxes(); box++)
+            {
+                if (staleBoxes[box])
+                {
+                    out.seek(sizeof(IndexHeader) + sizeof(BankIndex::Entry) * box * 30, SEEK_SET);
+                    out.write(slotIndex.entries() + box * 30, sizeof(BankIndex::Entry) * 30);
+                }
+            }
+            out.seek(0, SEEK_SET);
+            out.write(&header, sizeof(IndexHeader));
+            out.close();
+            return;
+        }
+        out.close();
+    }
+
+    FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(indexPath()).c_str()));
+    FSStream out(archive, indexPath(), FS_OPEN_WRITE, len);
+    if (out.good())
+    {
+        out.write(&invalid, sizeof(IndexHeader));
+        out.write(slotIndex.entries(), sizeof(BankIndex::Entry) * slotIndex.size());
+        out.seek(0, SEEK_SET);
+        out.write(&header, sizeof(IndexHeader));
+        indexOnDisk = R_SUCCEEDED(out.result());
+    }
+    out.close();
+}
+
 void Bank::convert()
 {
     bool deleteOld = true;
@@ -421,6 +1197,8 @@ void Bank::convert()
     extern nlohmann::json g_banks;
     g_banks["pksm_1"] = ((BankHeader*) data)->boxes;
     std::fill_n(data + sizeof(BankHeader), sizeof(BankEntry) * boxes() * 30, 0xFF);
+    resetTracking();
+    slotIndex.resize(boxes() * 30);
     boxNames = nlohmann::json::array();
 
     for (int box = 0; box < std::min((int) oldSize / (232 * 30), boxes()); box++)
@@ -504,24 +1282,23 @@ bool Bank::setName(const std::string& name)
     std::string oldName = bankName;
     bankName = name;
     std::string oldBankPath = Configuration::getInstance().useExtData() ? "/banks/" + oldName + ".bnk" : "/3ds/PKSM/banks/" + oldName + ".bnk";
-    std::string oldJsonPath = Configuration::getInstance().useExtData() ? "/banks/" + oldName + ".json" : "/3ds/PKSM/banks/" + oldName + ".json";
     std::string newBankPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".bnk" : "/3ds/PKSM/banks/" + bankName + ".bnk";
-    std::string newJsonPath = Configuration::getInstance().useExtData() ? "/banks/" + bankName + ".json" : "/3ds/PKSM/banks/" + bankName + ".json";
     auto archive = Configuration::getInstance().useExtData() ? Archive::data() : Archive::sd();
+    // Box names are stored in the bank file, so there's no JSON to move along with it
     if (R_FAILED(Archive::moveFile(archive, oldBankPath, archive, newBankPath)))
     {
         bankName = oldName;
         return false;
     }
-    if (R_FAILED(Archive::moveFile(archive, oldJsonPath, archive, newJsonPath)))
+    // The journal only holds what's already saved, so folding it in beats losing it if the move fails
+    std::string oldJournalPath = Configuration::getInstance().useExtData() ? "/banks/" + oldName + ".bnkj" : "/3ds/PKSM/banks/" + oldName + ".bnkj";
+    if (journalRecords != 0 && R_FAILED(Archive::moveFile(archive, oldJournalPath, archive, journalPath())))
     {
-        bankName = oldName;
-        if (R_FAILED(Archive::moveFile(archive, newBankPath, archive, oldBankPath)))
-        {
-            Gui::warn("Very bad things have happened.");
-            return false;
-        }
-        return false;
+        writeBank();
     }
+    FSUSER_DeleteFile(archive, fsMakePath(PATH_UTF16, StringUtils::UTF8toUTF16(oldJournalPath).c_str()));
+    // The index can always be rebuilt, so a failed move doesn't matter
+    std::string oldIndexPath = Configuration::getInstance().useExtData() ? "/banks/" + oldName + ".bnki" : "/3ds/PKSM/banks/" + oldName + ".bnki";
+    Archive::moveFile(archive, oldIndexPath, archive, indexPath());
     return true;
 }
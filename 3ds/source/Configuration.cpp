@@ -62,6 +62,8 @@ Configuration::Configuration()
         {
             if (mJson["version"].get<int>() > CURRENT_VERSION)
             {
+                // Left as is, but its language still applies, starting with this warning
+                mLanguage = mJson["language"];
                 Gui::warn(i18n::localize("THE_FUCK"), i18n::localize("DO_NOT_DOWNGRADE"));
                 return;
             }
@@ -103,11 +105,17 @@ Configuration::Configuration()
                 mJson.erase("storageSize");
                 mJson["showBackups"] = false;
             }
+            if (mJson["version"].get<int>() < 7)
+            {
+                mJson["bankJournal"] = true;
+            }
 
             mJson["version"] = CURRENT_VERSION;
             save();
         }
     }
+
+    mLanguage = mJson["language"];
 }
 
 void Configuration::save()
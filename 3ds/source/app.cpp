@@ -173,6 +173,10 @@ Result App::init(std::string execPath)
     
     Configuration::getInstance();
     i18n::init();
+    // Below the main thread's priority, so loading strings.bin fills the gaps where startup waits on I/O
+    // instead of holding it up. The load is a few reads and allocations; the stack only needs some
+    // headroom over the default for the stdio calls
+    Threads::create((ThreadFunc)i18n::prefetch, 16*1024, 1);
     if (R_FAILED(res = Banks::init()))
         return consoleDisplayError("Banks::init failed.", res);
 
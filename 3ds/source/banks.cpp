@@ -108,6 +108,11 @@ bool Banks::loadBank(const std::string& name, std::optional<int> maxBoxes)
             saveJson();
             found = g_banks.find(name);
         }
+        if (bank)
+        {
+            // Leave the outgoing bank self-contained, so only the open bank ever has a journal to replay
+            bank->compact();
+        }
         bank = std::make_shared<Bank>(found.key(), found.value().get<int>());
         return true;
     }
@@ -134,8 +139,14 @@ void Banks::removeBank(const std::string& name)
         }
         remove(("/3ds/PKSM/banks/" + name + ".bnk").c_str());
         remove(("/3ds/PKSM/banks/" + name + ".json").c_str());
+        remove(("/3ds/PKSM/banks/" + name + ".bnkj").c_str());
+        remove(("/3ds/PKSM/banks/" + name + ".bnki").c_str());
+        remove(("/3ds/PKSM/banks/" + name + ".bnkt").c_str());
         FSUSER_DeleteFile(Archive::data(), fsMakePath(PATH_UTF16, (u"/banks/" + StringUtils::UTF8toUTF16(name) + u".bnk").c_str()));
         FSUSER_DeleteFile(Archive::data(), fsMakePath(PATH_UTF16, (u"/banks/" + StringUtils::UTF8toUTF16(name) + u".json").c_str()));
+        FSUSER_DeleteFile(Archive::data(), fsMakePath(PATH_UTF16, (u"/banks/" + StringUtils::UTF8toUTF16(name) + u".bnkj").c_str()));
+        FSUSER_DeleteFile(Archive::data(), fsMakePath(PATH_UTF16, (u"/banks/" + StringUtils::UTF8toUTF16(name) + u".bnki").c_str()));
+        FSUSER_DeleteFile(Archive::data(), fsMakePath(PATH_UTF16, (u"/banks/" + StringUtils::UTF8toUTF16(name) + u".bnkt").c_str()));
         for (auto i = g_banks.begin(); i != g_banks.end(); i++)
         {
             if (i.key() == name)
@@ -173,8 +184,14 @@ void Banks::renameBank(const std::string& oldName, const std::string& newName)
         {
             Archive::moveFile(Archive::data(), "/banks/" + oldName + ".bnk", Archive::data(), "/banks/" + newName + ".bnk");
             Archive::moveFile(Archive::data(), "/banks/" + oldName + ".json", Archive::data(), "/banks/" + newName + ".json");
+            Archive::moveFile(Archive::data(), "/banks/" + oldName + ".bnkj", Archive::data(), "/banks/" + newName + ".bnkj");
+            Archive::moveFile(Archive::data(), "/banks/" + oldName + ".bnki", Archive::data(), "/banks/" + newName + ".bnki");
+            Archive::moveFile(Archive::data(), "/banks/" + oldName + ".bnkt", Archive::data(), "/banks/" + newName + ".bnkt");
             Archive::moveFile(Archive::sd(), "/3ds/PKSM/banks/" + oldName + ".bnk", Archive::sd(), "/3ds/PKSM/banks/" + newName + ".bnk");
             Archive::moveFile(Archive::sd(), "/3ds/PKSM/banks/" + oldName + ".json", Archive::sd(), "/3ds/PKSM/banks/" + newName + ".json");
+            Archive::moveFile(Archive::sd(), "/3ds/PKSM/banks/" + oldName + ".bnkj", Archive::sd(), "/3ds/PKSM/banks/" + newName + ".bnkj");
+            Archive::moveFile(Archive::sd(), "/3ds/PKSM/banks/" + oldName + ".bnki", Archive::sd(), "/3ds/PKSM/banks/" + newName + ".bnki");
+            Archive::moveFile(Archive::sd(), "/3ds/PKSM/banks/" + oldName + ".bnkt", Archive::sd(), "/3ds/PKSM/banks/" + newName + ".bnkt");
         }
         g_banks[newName] = g_banks[oldName];
         g_banks.erase(oldName);
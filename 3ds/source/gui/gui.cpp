@@ -152,7 +152,7 @@ void Gui::clearTextBufs(void)
     C2D_TextBufClear(dynamicBuf);
 }
 
-void Gui::dynamicText(const std::string& str, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY)
+void Gui::dynamicText(std::string_view str, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY)
 {
     const float lineMod = ceilf(scaleY * fontGetInfo()->lineFeed);
 
@@ -160,11 +160,11 @@ void Gui::dynamicText(const std::string& str, int x, int y, float scaleX, float
     static std::vector<int> printX;
     
     size_t index = 0;
-    while (index != std::string::npos)
+    while (index != std::string_view::npos)
     {
-        print.push_back(str.substr(index, str.find('\n', index) - index));
+        print.emplace_back(str.substr(index, str.find('\n', index) - index));
         index = str.find('\n', index);
-        if (index != std::string::npos)
+        if (index != std::string_view::npos)
         {
             index++;
         }
@@ -240,7 +240,7 @@ void Gui::clearStaticText()
     staticMap.clear();
 }
 
-void Gui::staticText(const std::string& strKey, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY)
+void Gui::staticText(std::string_view strKey, int x, int y, float scaleX, float scaleY, u32 color, TextPosX positionX, TextPosY positionY)
 {
     const float lineMod = ceilf(scaleY * fontGetInfo()->lineFeed);
 
@@ -248,11 +248,11 @@ void Gui::staticText(const std::string& strKey, int x, int y, float scaleX, floa
     static std::vector<int> printX;
     
     size_t index = 0;
-    while (index != std::string::npos)
+    while (index != std::string_view::npos)
     {
-        print.push_back(strKey.substr(index, strKey.find('\n', index) - index));
+        print.emplace_back(strKey.substr(index, strKey.find('\n', index) - index));
         index = strKey.find('\n', index);
-        if (index != std::string::npos)
+        if (index != std::string_view::npos)
         {
             index++;
         }
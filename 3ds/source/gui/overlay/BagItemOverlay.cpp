@@ -52,7 +52,7 @@ void BagItemOverlay::draw() const
             break;
         }
         x = i < hid.maxVisibleEntries() / 2 ? 4 : 203;
-        Gui::dynamicText(*items[i + hid.page() * hid.maxVisibleEntries()].first, x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
+        Gui::dynamicText(items[i + hid.page() * hid.maxVisibleEntries()].first, x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
     }
 }
 
@@ -77,15 +77,20 @@ void BagItemOverlay::update(touchPosition* touch)
     {
         items.clear();
         items.push_back(validItems[0]);
-        for (size_t i = 1; i < validItems.size(); i++)
+        // The index covers every item, numbered by id, so matches are put back into name order here
+        std::vector<int> found;
+        for (size_t item : search.find(searchString))
         {
-            std::string itemName = validItems[i].first->substr(0, searchString.size());
-            StringUtils::toLower(itemName);
-            if (itemName == searchString)
+            if (item < positions.size() && positions[item] != 0)
             {
-                items.push_back(validItems[i]);
+                found.push_back(positions[item]);
             }
         }
+        std::sort(found.begin(), found.end());
+        for (int i : found)
+        {
+            items.push_back(validItems[i]);
+        }
         oldSearchString = searchString;
     }
     else if (searchString.empty() && !oldSearchString.empty())
@@ -30,12 +30,13 @@
 
 LocationOverlay::LocationOverlay(Screen& screen, std::shared_ptr<PKX> pkm, bool met)
     : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")),
-    pkm(pkm), hid(40,2), validLocations(i18n::locations(Configuration::getInstance().language(), pkm->generation())), locations(validLocations), met(met)
+    pkm(pkm), hid(40,2), validLocations(i18n::locations(Configuration::getInstance().language(), pkm->generation())),
+    search(i18n::locationIndex(Configuration::getInstance().language(), pkm->generation())), locations(validLocations), met(met)
 {
     instructions.addBox(false, 75, 30, 170, 23, COLOR_GREY, i18n::localize("SEARCH"), COLOR_WHITE);
     searchButton = std::make_unique<ClickButton>(75, 30, 170, 23, [this](){ Gui::setNextKeyboardFunc([this](){ this->searchBar(); }); return false; }, ui_sheet_emulated_box_search_idx, "", 0, 0);
     hid.update(locations.size());
-    hid.select(std::distance(locations.begin(), std::find_if(locations.begin(), locations.end(), [pkm, met](const std::pair<u16, std::string>& pair){ return pair.first == (met ? pkm->metLocation() : pkm->eggLocation()); })));
+    hid.select(std::distance(locations.begin(), std::find_if(locations.begin(), locations.end(), [pkm, met](const std::pair<u16, std::string_view>& pair){ return pair.first == (met ? pkm->metLocation() : pkm->eggLocation()); })));
 }
 
 void LocationOverlay::draw() const
@@ -56,19 +57,13 @@ void LocationOverlay::draw() const
     C2D_DrawRectSolid(x, y, 0.5f, 1, 11, COLOR_YELLOW);
     C2D_DrawRectSolid(x, y + 10, 0.5f, 198, 1, COLOR_YELLOW);
     C2D_DrawRectSolid(x + 197, y, 0.5f, 1, 11, COLOR_YELLOW);
-    // Stupid non random-access iterators
-    std::map<u16, std::string>::const_iterator locIt = locations.begin();
-    for (size_t i = 0; i < hid.page() * hid.maxVisibleEntries(); i++)
-    {
-        locIt++;
-    }
     for (size_t i = 0; i < hid.maxVisibleEntries(); i++)
     {
         x = i < hid.maxVisibleEntries() / 2 ? 4 : 203;
         if (hid.page() * hid.maxVisibleEntries() + i < locations.size())
         {
-            Gui::dynamicText(std::to_string(locIt->first) + " - " + locIt->second, x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
-            locIt++;
+            const auto& location = locations[hid.page() * hid.maxVisibleEntries() + i];
+            Gui::dynamicText(std::to_string(location.first) + " - " + std::string(location.second), x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         }
         else
         {
@@ -97,14 +92,9 @@ void LocationOverlay::update(touchPosition* touch)
     if (!searchString.empty() && searchString != oldSearchString)
     {
         locations.clear();
-        for (auto i = validLocations.begin(); i != validLocations.end(); i++)
+        for (size_t i : search.find(searchString))
         {
-            std::string locName = i->second.substr(0, searchString.size());
-            StringUtils::toLower(locName);
-            if (locName == searchString)
-            {
-                locations.emplace(*i);
-            }
+            locations.push_back(validLocations[i]);
         }
         oldSearchString = searchString;
     }
@@ -122,18 +112,13 @@ void LocationOverlay::update(touchPosition* touch)
     u32 downKeys = hidKeysDown();
     if (downKeys & KEY_A)
     {
-        auto locIt = locations.begin();
-        for (size_t i = 0; i < hid.fullIndex(); i++)
-        {
-            locIt++;
-        }
         if (met)
         {
-            pkm->metLocation(locIt->first);
+            pkm->metLocation(locations[hid.fullIndex()].first);
         }
         else
         {
-            pkm->eggLocation(locIt->first);
+            pkm->eggLocation(locations[hid.fullIndex()].first);
         }
         screen.removeOverlay();
         return;
@@ -32,7 +32,7 @@
 #include "ClickButton.hpp"
 
 namespace {
-    int index(std::vector<std::pair<int, std::string>>& search, const std::string& v)
+    int index(std::vector<std::pair<int, std::string>>& search, std::string_view v)
     {
         if (v == search[0].second || v == "")
         {
@@ -61,19 +61,25 @@ namespace {
 }
 
 MoveOverlay::MoveOverlay(Screen& screen, std::shared_ptr<PKX> pkm, int moveIndex)
-    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), moveIndex(moveIndex), hid(40, 2)
+    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), moveIndex(moveIndex), hid(40, 2),
+      search(i18n::moveIndex(Configuration::getInstance().language()))
 {
     instructions.addBox(false, 75, 30, 170, 23, COLOR_GREY, i18n::localize("SEARCH"), COLOR_WHITE);
-    const std::vector<std::string>& rawMoves = i18n::rawMoves(Configuration::getInstance().language());
+    std::vector<std::string_view> rawMoves = i18n::rawMoves(Configuration::getInstance().language());
     for (int i = 1; i <= TitleLoader::save->maxMove(); i++)
     {
         if (i >= 622 && i <= 658) continue;
-        moves.push_back({i, rawMoves[i]});
+        moves.emplace_back(i, rawMoves[i]);
     }
     static const auto less = [](const std::pair<int, std::string>& pair1, const std::pair<int, std::string>& pair2){ return pair1.second < pair2.second; };
     std::sort(moves.begin(), moves.end(), less);
-    moves.insert(moves.begin(), {0, rawMoves[0]});
+    moves.emplace(moves.begin(), 0, rawMoves[0]);
     validMoves = moves;
+    positions.resize(rawMoves.size());
+    for (size_t i = 1; i < validMoves.size(); i++)
+    {
+        positions[validMoves[i].first] = i;
+    }
 
     hid.update(moves.size());
     if (moveIndex < 4)
@@ -149,15 +155,20 @@ void MoveOverlay::update(touchPosition* touch)
     {
         moves.clear();
         moves.push_back(validMoves[0]);
-        for (size_t i = 1; i < validMoves.size(); i++)
+        // The index covers every move, numbered by id, so matches are put back into name order here
+        std::vector<int> found;
+        for (size_t move : search.find(searchString))
         {
-            std::string itemName = validMoves[i].second.substr(0, searchString.size());
-            StringUtils::toLower(itemName);
-            if (itemName == searchString)
+            if (move < positions.size() && positions[move] != 0)
             {
-                moves.push_back(validMoves[i]);
+                found.push_back(positions[move]);
             }
         }
+        std::sort(found.begin(), found.end());
+        for (int i : found)
+        {
+            moves.push_back(validMoves[i]);
+        }
         oldSearchString = searchString;
     }
     else if (searchString.empty() && !oldSearchString.empty())
@@ -34,7 +34,7 @@
 static constexpr auto stringComp = [](const std::pair<int, std::string>& pair1, const std::pair<int, std::string>& pair2){ return pair1.second < pair2.second; };
 
 namespace {
-    int index(std::vector<std::pair<int, std::string>>& search, const std::string& v)
+    int index(std::vector<std::pair<int, std::string>>& search, std::string_view v)
     {
         if (v == search[0].second || v == "")
         {
@@ -63,20 +63,26 @@ namespace {
 }
 
 PkmItemOverlay::PkmItemOverlay(Screen& screen, std::shared_ptr<PKX> pkm)
-    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), hid(40, 2)
+    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), hid(40, 2),
+      search(i18n::itemIndex(Configuration::getInstance().language()))
 {
     instructions.addBox(false, 75, 30, 170, 23, COLOR_GREY, i18n::localize("SEARCH"), COLOR_WHITE);
-    const std::vector<std::string>& rawItems = i18n::rawItems(Configuration::getInstance().language());
+    std::vector<std::string_view> rawItems = i18n::rawItems(Configuration::getInstance().language());
     for (int i = 1; i <= TitleLoader::save->maxItem(); i++)
     {
         if (rawItems[i].find("\uFF1F\uFF1F\uFF1F") != std::string::npos || rawItems[i].find("???") != std::string::npos) continue;
         else if (i >= 807 && i <= 835) continue; // Bag Z-Crystals
         else if (i >= 927 && i <= 932) continue; // Bag Z-Crystals
-        items.push_back({i, rawItems[i]});
+        items.emplace_back(i, rawItems[i]);
     }
     std::sort(items.begin(), items.end(), stringComp);
-    items.insert(items.begin(), {0, rawItems[0]});
+    items.emplace(items.begin(), 0, rawItems[0]);
     validItems = items;
+    positions.resize(rawItems.size());
+    for (size_t i = 1; i < validItems.size(); i++)
+    {
+        positions[validItems[i].first] = i;
+    }
 
     hid.update(items.size());
     int itemIndex = index(items, i18n::item(Configuration::getInstance().language(), pkm->heldItem()));
@@ -149,15 +155,20 @@ void PkmItemOverlay::update(touchPosition* touch)
     {
         items.clear();
         items.push_back(validItems[0]);
-        for (size_t i = 1; i < validItems.size(); i++)
+        // The index covers every item, numbered by id, so matches are put back into name order here
+        std::vector<int> found;
+        for (size_t item : search.find(searchString))
         {
-            std::string itemName = validItems[i].second.substr(0, searchString.size());
-            StringUtils::toLower(itemName);
-            if (itemName == searchString)
+            if (item < positions.size() && positions[item] != 0)
             {
-                items.push_back(validItems[i]);
+                found.push_back(positions[item]);
             }
         }
+        std::sort(found.begin(), found.end());
+        for (int i : found)
+        {
+            items.push_back(validItems[i]);
+        }
         oldSearchString = searchString;
     }
     else if (searchString.empty() && !oldSearchString.empty())
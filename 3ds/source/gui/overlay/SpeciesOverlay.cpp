@@ -29,9 +29,11 @@
 #include "loader.hpp"
 #include "Configuration.hpp"
 #include "ClickButton.hpp"
+#include <algorithm>
 
 SpeciesOverlay::SpeciesOverlay(Screen& screen, std::shared_ptr<PKX> pkm)
-    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), hid(40, 8)
+    : Overlay(screen, i18n::localize("A_SELECT") + '\n' + i18n::localize("B_BACK")), pkm(pkm), hid(40, 8),
+      search(i18n::speciesIndex(Configuration::getInstance().language()))
 {
     instructions.addBox(false, 75, 30, 170, 23, COLOR_GREY, i18n::localize("SEARCH"), COLOR_WHITE);
     searchButton = new ClickButton(75, 30, 170, 23, [this](){ Gui::setNextKeyboardFunc([this](){ this->searchBar(); }); return false; }, ui_sheet_emulated_box_search_idx, "", 0, 0);
@@ -62,6 +64,7 @@ SpeciesOverlay::SpeciesOverlay(Screen& screen, std::shared_ptr<PKX> pkm)
             hid.select(pkm->species() == 0 ? 0 : pkm->species() - 1);
         }
     }
+    validPkm = dispPkm;
 }
 
 void SpeciesOverlay::draw() const
@@ -123,41 +126,12 @@ void SpeciesOverlay::update(touchPosition* touch)
     if (!searchString.empty() && searchString != oldSearchString)
     {
         dispPkm.clear();
-        if (TitleLoader::save->generation() != Generation::LGPE)
-        {
-            for (int i = 1; i <= TitleLoader::save->maxSpecies(); i++)
-            {
-                std::string speciesName = i18n::species(Configuration::getInstance().language(), i).substr(0, searchString.size());
-                StringUtils::toLower(speciesName);
-                if (speciesName == searchString)
-                {
-                    dispPkm.push_back(i);
-                }
-            }
-        }
-        else
+        // The index covers every species, numbered by species
+        for (size_t species : search.find(searchString))
         {
-            std::string speciesName;
-            for (size_t i = 1; i <= 151; i++)
-            {
-                speciesName = i18n::species(Configuration::getInstance().language(), i).substr(0, searchString.size());
-                StringUtils::toLower(speciesName);
-                if (speciesName == searchString)
-                {
-                    dispPkm.push_back(i);
-                }
-            }
-            speciesName = i18n::species(Configuration::getInstance().language(), 808).substr(0, searchString.size());
-            StringUtils::toLower(speciesName);
-            if (speciesName == searchString)
-            {
-                dispPkm.push_back(808);
-            }
-            speciesName = i18n::species(Configuration::getInstance().language(), 809).substr(0, searchString.size());
-            StringUtils::toLower(speciesName);
-            if (speciesName == searchString)
+            if (std::binary_search(validPkm.begin(), validPkm.end(), (int)species))
             {
-                dispPkm.push_back(809);
+                dispPkm.push_back(species);
             }
         }
         oldSearchString = searchString;
@@ -206,7 +180,7 @@ void SpeciesOverlay::update(touchPosition* touch)
         int species = dispPkm[hid.fullIndex()];
         if (pkm->species() == 0 || !pkm->nicknamed())
         {
-            pkm->nickname(i18n::species(Configuration::getInstance().language(), species));
+            pkm->nickname(std::string(i18n::species(Configuration::getInstance().language(), species)));
         }
         pkm->species((u16) species);
         pkm->alternativeForm(0);
@@ -30,14 +30,14 @@ VersionOverlay::VersionOverlay(Screen& screen, std::shared_ptr<PKX> pkm) : Overl
 {
     for (size_t i = 0; i < i18n::numGameStrings(Configuration::getInstance().language()); i++)
     {
-        const std::string& str = i18n::game(Configuration::getInstance().language(), i);
+        std::string_view str = i18n::game(Configuration::getInstance().language(), i);
         if (str != i18n::localize("INVALID_GAME"))
         {
             games.emplace_back((u8)i, str);
         }
     }
     hid.update(games.size());
-    hid.select(std::distance(games.begin(), std::find_if(games.begin(), games.end(), [pkm](const std::pair<u8, const std::string&>& pair){ return pair.first == pkm->version(); })));
+    hid.select(std::distance(games.begin(), std::find_if(games.begin(), games.end(), [pkm](const std::pair<u8, std::string_view>& pair){ return pair.first == pkm->version(); })));
 }
 
 void VersionOverlay::draw() const
@@ -60,7 +60,7 @@ void VersionOverlay::draw() const
         x = i < hid.maxVisibleEntries() / 2 ? 4 : 203;
         if (hid.page() * hid.maxVisibleEntries() + i < games.size())
         {
-            Gui::dynamicText(std::to_string(games[hid.page() * hid.maxVisibleEntries() + i].first) + " - " + games[hid.page() * hid.maxVisibleEntries() + i].second, x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
+            Gui::dynamicText(std::to_string(games[hid.page() * hid.maxVisibleEntries() + i].first) + " - " + std::string(games[hid.page() * hid.maxVisibleEntries() + i].second), x, (i % (hid.maxVisibleEntries() / 2)) * 12, FONT_SIZE_9, FONT_SIZE_9, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         }
         else
         {
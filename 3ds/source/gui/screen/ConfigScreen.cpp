@@ -154,6 +154,7 @@ ConfigScreen::ConfigScreen()
     tabButtons[2].push_back(new ClickButton(247, 135, 15, 12, [this](){ Configuration::getInstance().useExtData(!Configuration::getInstance().useExtData()); useExtDataChanged = !useExtDataChanged; return true; }, ui_sheet_button_info_detail_editor_light_idx, "", 0.0f, 0));
     tabButtons[2].push_back(new ClickButton(247, 159, 15, 12, [](){ Configuration::getInstance().randomMusic(!Configuration::getInstance().randomMusic()); return true; }, ui_sheet_button_info_detail_editor_light_idx, "", 0.0f, 0));
     tabButtons[2].push_back(new ClickButton(247, 183, 15, 12, [this](){ Configuration::getInstance().showBackups(!Configuration::getInstance().showBackups()); showBackupsChanged = !showBackupsChanged; return true; }, ui_sheet_button_info_detail_editor_light_idx, "", 0.0f, 0));
+    tabButtons[2].push_back(new ClickButton(247, 207, 15, 12, [](){ Configuration::getInstance().bankJournal(!Configuration::getInstance().bankJournal()); return true; }, ui_sheet_button_info_detail_editor_light_idx, "", 0.0f, 0));
 }
 
 void ConfigScreen::draw() const
@@ -313,6 +314,7 @@ void ConfigScreen::draw() const
         Gui::staticText(i18n::localize("CONFIG_USE_EXTDATA"), 19, 132, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         Gui::staticText(i18n::localize("CONFIG_RANDOM_MUSIC"), 19, 156, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         Gui::staticText(i18n::localize("CONFIG_SHOW_BACKUPS"), 19, 180, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
+        Gui::staticText(i18n::localize("CONFIG_BANK_JOURNAL"), 19, 204, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
 
         for (Button* button : tabButtons[currentTab])
         {
@@ -326,6 +328,7 @@ void ConfigScreen::draw() const
         Gui::staticText(Configuration::getInstance().useExtData() ? i18n::localize("YES") : i18n::localize("NO"), 270, 132, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         Gui::staticText(Configuration::getInstance().randomMusic() ? i18n::localize("YES") : i18n::localize("NO"), 270, 156, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
         Gui::staticText(Configuration::getInstance().showBackups() ? i18n::localize("YES") : i18n::localize("NO"), 270, 180, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
+        Gui::staticText(Configuration::getInstance().bankJournal() ? i18n::localize("YES") : i18n::localize("NO"), 270, 204, FONT_SIZE_14, FONT_SIZE_14, COLOR_WHITE, TextPosX::LEFT, TextPosY::TOP);
     }
 }
 
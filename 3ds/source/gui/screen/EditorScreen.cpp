@@ -524,7 +524,7 @@ void EditorScreen::setNick()
     if (ret == SWKBD_BUTTON_CONFIRM)
     {
         pkm->nickname(input);
-        std::string speciesName = i18n::species(pkm->language(), pkm->species());
+        std::string speciesName(i18n::species(pkm->language(), pkm->species()));
         if (pkm->generation() == Generation::FOUR || pkm->version() <= 15 || (pkm->version() >= 35 && pkm->version() <= 41)) // Gen 4, less than or equal to Colosseum/XD, or in VC territory
         {
             StringUtils::toUpper(speciesName);
@@ -583,12 +583,14 @@ void EditorScreen::setFriendship()
 void EditorScreen::partyUpdate()
 {
     // Update party values IF the user hasn't edited them themselves
+    std::array<u16, 6> stats;
+    pkm->stats(stats);
     for (int i = 0; i < 6; i++)
     {
         if (pkm->partyStat(i) == origPartyStats[i])
         {
-            pkm->partyStat(i, pkm->stat(i));
-            origPartyStats[i] = pkm->stat(i);
+            pkm->partyStat(i, stats[i]);
+            origPartyStats[i] = stats[i];
         }
     }
     if (pkm->partyLevel() == origPartyLevel)
@@ -598,8 +600,8 @@ void EditorScreen::partyUpdate()
     }
     if (pkm->partyCurrHP() == origPartyCurrHP)
     {
-        pkm->partyCurrHP(pkm->stat(0));
-        origPartyCurrHP = pkm->stat(0);
+        pkm->partyCurrHP(stats[0]);
+        origPartyCurrHP = stats[0];
     }
     if (pkm->generation() == Generation::LGPE)
     {
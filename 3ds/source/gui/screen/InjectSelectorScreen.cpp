@@ -258,16 +258,7 @@ void InjectSelectorScreen::draw() const
             }
             else
             {
-                MysteryGift::giftData data;
-                const std::string& lang = i18n::langString(Configuration::getInstance().language());
-                if (wondercards[i].find(lang) != wondercards[i].end())
-                {
-                    data = MysteryGift::wondercardInfo(wondercards[i][lang]);
-                }
-                else
-                {
-                    data = MysteryGift::wondercardInfo(*wondercards[i].begin());
-                }
+                MysteryGift::giftData data = MysteryGift::wondercardInfo(wondercards[i].card(Configuration::getInstance().language()));
                 int x = i % 2 == 0 ? 21 : 201;
                 int y = 43 + ((i % 10) / 2) * 37;
                 if (data.species == -1)
@@ -440,7 +431,7 @@ bool InjectSelectorScreen::toggleFilter(const std::string& lang)
         wondercards = MysteryGift::wondercards();
         for (size_t i = wondercards.size(); i > 0; i--)
         {
-            if (!wondercards[i-1].contains(lang))
+            if (!wondercards[i-1].has(i18n::langFromString(lang)))
             {
                 wondercards.erase(wondercards.begin() + i - 1);
             }
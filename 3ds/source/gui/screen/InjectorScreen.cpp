@@ -46,29 +46,19 @@ bool InjectorScreen::setLanguage(Language language)
     if (isLangAvailable(language))
     {
         lang = language;
-        wondercard = MysteryGift::wondercard(ids[i18n::langString(lang)]);
+        wondercard = MysteryGift::wondercard(ids.card(lang));
         
         changeDate();
     }
     return false;
 }
 
-InjectorScreen::InjectorScreen(nlohmann::json ids) : hid(40, 8), ids(ids), emptySlot(TitleLoader::save->emptyGiftLocation()),
+InjectorScreen::InjectorScreen(MysteryGift::giftMatch ids) : hid(40, 8), ids(ids), emptySlot(TitleLoader::save->emptyGiftLocation()),
                                                      gifts(TitleLoader::save->currentGifts())
 {
-    const std::string& langString = i18n::langString(Configuration::getInstance().language());
-    if (ids.find(langString) != ids.end())
-    {
-        wondercard = MysteryGift::wondercard(ids[langString]);
-        game = MysteryGift::wondercardInfo(ids[langString]).game;
-        lang = Configuration::getInstance().language();
-    }
-    else
-    {
-        wondercard = MysteryGift::wondercard(*ids.begin());
-        game = MysteryGift::wondercardInfo(*ids.begin()).game;
-        lang = i18n::langFromString(ids.begin().key());
-    }
+    lang = ids.language(Configuration::getInstance().language());
+    wondercard = MysteryGift::wondercard(ids.card(lang));
+    game = MysteryGift::wondercardInfo(ids.card(lang)).game;
     
     slot = emptySlot + 1;
     int langIndex = 1;
@@ -93,7 +83,7 @@ InjectorScreen::InjectorScreen(nlohmann::json ids) : hid(40, 8), ids(ids), empty
     changeDate();
 }
 
-InjectorScreen::InjectorScreen(std::unique_ptr<WCX> wcx) : wondercard(std::move(wcx)), hid(40, 8), ids({}), emptySlot(TitleLoader::save->emptyGiftLocation()),
+InjectorScreen::InjectorScreen(std::unique_ptr<WCX> wcx) : wondercard(std::move(wcx)), hid(40, 8), ids(), emptySlot(TitleLoader::save->emptyGiftLocation()),
                                                            gifts(TitleLoader::save->currentGifts())
 {
     lang = Language::UNUSED;
@@ -309,7 +299,7 @@ void InjectorScreen::draw() const
         {
             Gui::staticText(i18n::localize("NA"), 87, 35, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
             Gui::staticText(i18n::localize("NA"), 87, 55, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
-            const std::string* itemString = &i18n::item(Configuration::getInstance().language(), wondercard->object());
+            std::string_view itemString = i18n::item(Configuration::getInstance().language(), wondercard->object());
             std::string numString = "";
             if (wondercard->generation() == Generation::SIX)
             {
@@ -317,10 +307,10 @@ void InjectorScreen::draw() const
             }
             else if (wondercard->generation() == Generation::SEVEN)
             {
-                itemString = &i18n::item(Configuration::getInstance().language(), ((WC7*)wondercard.get())->object(item));
+                itemString = i18n::item(Configuration::getInstance().language(), ((WC7*)wondercard.get())->object(item));
                 numString = " x " + std::to_string(((WC7*)wondercard.get())->objectQuantity(item));
             }
-            Gui::dynamicText(numString.empty() ? *itemString : *itemString + numString, 87, 75, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
+            Gui::dynamicText(std::string(itemString) + numString, 87, 75, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
             Gui::staticText(i18n::localize("NA"), 87, 95, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
             Gui::staticText(i18n::localize("NA"), 87, 115, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
             Gui::dynamicText(game, 87, 135, FONT_SIZE_14, FONT_SIZE_14, COLOR_BLACK, TextPosX::LEFT, TextPosY::TOP);
@@ -470,7 +460,7 @@ void InjectorScreen::update(touchPosition* touch)
 
 bool InjectorScreen::isLangAvailable(Language l) const
 {
-    return ids.find(i18n::langString(l)) != ids.end();
+    return ids.has(l);
 }
 
 void InjectorScreen::changeDate()
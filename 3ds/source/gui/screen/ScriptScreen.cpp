@@ -342,6 +342,7 @@ void ScriptScreen::applyScript()
         {
             std::copy(scriptData.data() + index + 8, scriptData.data() + index + 8 + length, TitleLoader::save->rawData() + offset + i * length);
         }
+        TitleLoader::save->markDirty(offset, length * repeat);
 
         index += 12 + length;
     }
@@ -369,6 +370,8 @@ void ScriptScreen::parsePicoCScript(std::string& file)
         char version = TitleLoader::save->version();
         args[2] = &version;
         PicocCallMain(picoc, 3, args);
+        // Scripts get a raw pointer to the save, so there's no telling which blocks they touched
+        TitleLoader::save->markAllDirty();
         // Restore stdout state
         dup2(stdout_save, STDOUT_FILENO);
     }
@@ -29,6 +29,8 @@
 #include "gui.hpp"
 #include "loader.hpp"
 #include "banks.hpp"
+#include "query.hpp"
+#include "PKXView.hpp"
 
 SortScreen::SortScreen(bool storage) : storage(storage)
 {
@@ -105,6 +107,185 @@ void SortScreen::pickSort(size_t number)
     currentOverlay = std::make_shared<SortOverlay>(*this, sortTypes[number]);
 }
 
+namespace
+{
+    struct SortItem
+    {
+        std::shared_ptr<PKX> pkm;
+        int slot; // Where it was before sorting
+        std::array<u16, 6> stats = {};
+    };
+
+    // Orders the distinct strings of a column once, so that strings sort by rank like numbers
+    std::vector<u16> collate(const std::vector<std::string>& strings)
+    {
+        std::vector<u16> order(strings.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&strings](u16 a, u16 b) { return strings[a] < strings[b]; });
+        std::vector<u16> ranks(strings.size());
+        u16 rank = 0;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            if (i > 0 && strings[order[i - 1]] < strings[order[i]])
+            {
+                rank++;
+            }
+            ranks[order[i]] = rank;
+        }
+        return ranks;
+    }
+
+    // One u16 key per item for a sort type, extracted once per slot
+    std::vector<u16> sortKeys(SortType type, const std::vector<SortItem>& items)
+    {
+        std::vector<u16> keys(items.size());
+        if (type == NICKNAME || type == OTNAME)
+        {
+            std::vector<std::string> strings(items.size());
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                strings[i] = type == NICKNAME ? items[i].pkm->nickname() : items[i].pkm->otName();
+            }
+            return collate(strings);
+        }
+        if (type == SPECIESNAME)
+        {
+            // Names are looked up once per species rather than once per slot
+            std::vector<u16> species;
+            for (auto& item : items)
+            {
+                species.push_back(item.pkm->species());
+            }
+            std::vector<u16> distinct = species;
+            std::sort(distinct.begin(), distinct.end());
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            std::vector<std::string> names;
+            for (u16 value : distinct)
+            {
+                names.emplace_back(i18n::species(Configuration::getInstance().language(), value));
+            }
+            std::vector<u16> nameRanks = collate(names);
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                keys[i] = nameRanks[std::lower_bound(distinct.begin(), distinct.end(), species[i]) - distinct.begin()];
+            }
+            return keys;
+        }
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            const std::shared_ptr<PKX>& pkm = items[i].pkm;
+            switch (type)
+            {
+                case DEX:
+                    keys[i] = pkm->species();
+                    break;
+                case FORM:
+                    keys[i] = pkm->alternativeForm();
+                    break;
+                case TYPE1:
+                    keys[i] = pkm->type1();
+                    break;
+                case TYPE2:
+                    keys[i] = pkm->type2();
+                    break;
+                case HP:
+                    keys[i] = items[i].stats[0];
+                    break;
+                case ATK:
+                    keys[i] = items[i].stats[1];
+                    break;
+                case DEF:
+                    keys[i] = items[i].stats[2];
+                    break;
+                case SATK:
+                    keys[i] = items[i].stats[4];
+                    break;
+                case SDEF:
+                    keys[i] = items[i].stats[5];
+                    break;
+                case SPE:
+                    keys[i] = items[i].stats[3];
+                    break;
+                case NATURE:
+                    keys[i] = pkm->nature();
+                    break;
+                case LEVEL:
+                    keys[i] = pkm->level();
+                    break;
+                case TID:
+                    keys[i] = pkm->TID();
+                    break;
+                case HPIV:
+                    keys[i] = pkm->iv(0);
+                    break;
+                case ATKIV:
+                    keys[i] = pkm->iv(1);
+                    break;
+                case DEFIV:
+                    keys[i] = pkm->iv(2);
+                    break;
+                case SATKIV:
+                    keys[i] = pkm->iv(4);
+                    break;
+                case SDEFIV:
+                    keys[i] = pkm->iv(5);
+                    break;
+                case SPEIV:
+                    keys[i] = pkm->iv(3);
+                    break;
+                case HIDDENPOWER:
+                    keys[i] = pkm->hpType();
+                    break;
+                case FRIENDSHIP:
+                    keys[i] = pkm->currentFriendship();
+                    break;
+                case SHINY:
+                    // Shiny ones come first
+                    keys[i] = pkm->shiny() ? 0 : 1;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return keys;
+    }
+
+    // Stable LSD radix sort of the item order by the key columns, most significant column first
+    std::vector<u16> radixOrder(const std::vector<std::vector<u16>>& columns, size_t count)
+    {
+        std::vector<u16> order(count), scratch(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            order[i] = i;
+        }
+        for (auto column = columns.rbegin(); column != columns.rend(); column++)
+        {
+            u16 max = count ? *std::max_element(column->begin(), column->end()) : 0;
+            for (int shift = 0; shift < 16 && (shift == 0 || (max >> shift) != 0); shift += 8)
+            {
+                size_t buckets[257] = {0};
+                for (u16 item : order)
+                {
+                    buckets[(((*column)[item] >> shift) & 0xFF) + 1]++;
+                }
+                for (int i = 1; i < 257; i++)
+                {
+                    buckets[i] += buckets[i - 1];
+                }
+                for (u16 item : order)
+                {
+                    scratch[buckets[((*column)[item] >> shift) & 0xFF]++] = item;
+                }
+                order.swap(scratch);
+            }
+        }
+        return order;
+    }
+}
+
 void SortScreen::sort()
 {
     while (!sortTypes.empty() && sortTypes.back() == NONE)
@@ -117,161 +298,74 @@ void SortScreen::sort()
         {
             sortTypes.push_back(DEX);
         }
-        std::vector<std::shared_ptr<PKX>> sortMe;
+        std::vector<SortItem> items;
+        int slots;
         if (storage)
         {
-            for (int i = 0; i < Banks::bank->boxes() * 30; i++)
+            slots = Banks::bank->boxes() * 30;
+            PKXView view;
+            // The index already knows which slots are empty
+            for (int i : Banks::bank->find({}))
             {
-                std::shared_ptr<PKX> pkm = Banks::bank->pkm(i / 30, i % 30);
-                if (pkm->encryptionConstant() != 0 && pkm->species() != 0)
+                PKX& pkm = Banks::bank->pkmView(view, i / 30, i % 30);
+                if (pkm.encryptionConstant() != 0 && pkm.species() != 0)
                 {
-                    sortMe.push_back(pkm);
+                    // The slots get overwritten with the sorted result, so keep copies
+                    items.push_back({pkm.materialize(), i});
                 }
             }
         }
         else
         {
-            for (int i = 0; i < TitleLoader::save->maxSlot(); i++)
-            {
-                std::shared_ptr<PKX> pkm = TitleLoader::save->pkm(i / 30, i % 30);
-                if (pkm->encryptionConstant() != 0 && pkm->species() != 0)
+            slots = TitleLoader::save->maxSlot();
+            PKXView view;
+            // Empty slots are skipped without being decoded
+            Query::run(PKFilter(), Query::Source::Save, [&items, &view](const Query::Match& match) {
+                PKX& pkm = TitleLoader::save->pkmView(view, match.box, match.slot);
+                if (pkm.encryptionConstant() != 0)
                 {
-                    sortMe.push_back(pkm);
+                    // The slots get overwritten with the sorted result, so keep copies
+                    items.push_back({pkm.materialize(), match.box * 30 + match.slot});
                 }
-            }
+                return true;
+            });
         }
-        std::stable_sort(sortMe.begin(), sortMe.end(), [this](const std::shared_ptr<PKX>& pkm1, const std::shared_ptr<PKX>& pkm2){
-            for (auto type : sortTypes)
-            {
-                switch (type)
-                {
-                    case DEX:
-                        if (pkm1->species() < pkm2->species()) return true;
-                        if (pkm2->species() < pkm1->species()) return false;
-                        break;
-                    case FORM:
-                        if (pkm1->alternativeForm() < pkm2->alternativeForm()) return true;
-                        if (pkm2->alternativeForm() < pkm1->alternativeForm()) return false;
-                        break;
-                    case TYPE1:
-                        if (pkm1->type1() < pkm2->type1()) return true;
-                        if (pkm2->type1() < pkm1->type1()) return false;
-                        break;
-                    case TYPE2:
-                        if (pkm1->type2() < pkm2->type2()) return true;
-                        if (pkm2->type2() < pkm1->type2()) return false;
-                        break;
-                    case HP:
-                        if (pkm1->stat(0) < pkm2->stat(0)) return true;
-                        if (pkm2->stat(0) < pkm1->stat(0)) return false;
-                        break;
-                    case ATK:
-                        if (pkm1->stat(1) < pkm2->stat(1)) return true;
-                        if (pkm2->stat(1) < pkm1->stat(1)) return false;
-                        break;
-                    case DEF:
-                        if (pkm1->stat(2) < pkm2->stat(2)) return true;
-                        if (pkm2->stat(2) < pkm1->stat(2)) return false;
-                        break;
-                    case SATK:
-                        if (pkm1->stat(4) < pkm2->stat(4)) return true;
-                        if (pkm2->stat(4) < pkm1->stat(4)) return false;
-                        break;
-                    case SDEF:
-                        if (pkm1->stat(5) < pkm2->stat(5)) return true;
-                        if (pkm2->stat(5) < pkm1->stat(5)) return false;
-                        break;
-                    case SPE:
-                        if (pkm1->stat(3) < pkm2->stat(3)) return true;
-                        if (pkm2->stat(3) < pkm1->stat(3)) return false;
-                        break;
-                    case NATURE:
-                        if (pkm1->nature() < pkm2->nature()) return true;
-                        if (pkm2->nature() < pkm1->nature()) return false;
-                        break;
-                    case LEVEL:
-                        if (pkm1->level() < pkm2->level()) return true;
-                        if (pkm2->level() < pkm1->level()) return false;
-                        break;
-                    case TID:
-                        if (pkm1->TID() < pkm2->TID()) return true;
-                        if (pkm2->TID() < pkm1->TID()) return false;
-                        break;
-                    case HPIV:
-                        if (pkm1->iv(0) < pkm2->iv(0)) return true;
-                        if (pkm2->iv(0) < pkm1->iv(0)) return false;
-                        break;
-                    case ATKIV:
-                        if (pkm1->iv(1) < pkm2->iv(1)) return true;
-                        if (pkm2->iv(1) < pkm1->iv(1)) return false;
-                        break;
-                    case DEFIV:
-                        if (pkm1->iv(2) < pkm2->iv(2)) return true;
-                        if (pkm2->iv(2) < pkm1->iv(2)) return false;
-                        break;
-                    case SATKIV:
-                        if (pkm1->iv(4) < pkm2->iv(4)) return true;
-                        if (pkm2->iv(4) < pkm1->iv(4)) return false;
-                        break;
-                    case SDEFIV:
-                        if (pkm1->iv(5) < pkm2->iv(5)) return true;
-                        if (pkm2->iv(5) < pkm1->iv(5)) return false;
-                        break;
-                    case SPEIV:
-                        if (pkm1->iv(3) < pkm2->iv(3)) return true;
-                        if (pkm2->iv(3) < pkm1->iv(3)) return false;
-                        break;
-                    case HIDDENPOWER:
-                        if (pkm1->hpType() < pkm2->hpType()) return true;
-                        if (pkm2->hpType() < pkm1->hpType()) return false;
-                        break;
-                    case FRIENDSHIP:
-                        if (pkm1->currentFriendship() < pkm2->currentFriendship()) return true;
-                        if (pkm2->currentFriendship() < pkm1->currentFriendship()) return false;
-                        break;
-                    case NICKNAME:
-                        if (pkm1->nickname() < pkm2->nickname()) return true;
-                        if (pkm2->nickname() < pkm1->nickname()) return false;
-                        break;
-                    case SPECIESNAME:
-                        if (i18n::species(Configuration::getInstance().language(), pkm1->species()) < i18n::species(Configuration::getInstance().language(), pkm2->species())) return true;
-                        if (i18n::species(Configuration::getInstance().language(), pkm2->species()) < i18n::species(Configuration::getInstance().language(), pkm1->species())) return false;
-                        break;
-                    case OTNAME:
-                        if (pkm1->otName() < pkm2->otName()) return true;
-                        if (pkm2->otName() < pkm1->otName()) return false;
-                        break;
-                    case SHINY:
-                        if (pkm1->shiny() && !pkm2->shiny()) return true;
-                        if (pkm2->shiny() && !pkm1->shiny()) return false;
-                        break;
-                    default:
-                        break;
-                }
-            }
-            return false;
-        });
 
-        if (storage)
+        if (std::any_of(sortTypes.begin(), sortTypes.end(), [](SortType type) { return type >= HP && type <= SPE; }))
         {
-            for (size_t i = 0; i < sortMe.size(); i++)
-            {
-                Banks::bank->pkm(sortMe[i], i / 30, i % 30);
-            }
-            for (int i = sortMe.size(); i < Banks::bank->boxes() * 30; i++)
+            for (auto& item : items)
             {
-                Banks::bank->pkm(TitleLoader::save->emptyPkm(), i / 30, i % 30);
+                item.pkm->stats(item.stats);
             }
         }
-        else
+
+        std::vector<std::vector<u16>> columns;
+        for (auto type : sortTypes)
+        {
+            columns.push_back(sortKeys(type, items));
+        }
+        std::vector<u16> order = radixOrder(columns, items.size());
+
+        // Slots that keep their contents aren't rewritten
+        std::vector<bool> occupied(slots, false);
+        for (auto& item : items)
         {
-            for (size_t i = 0; i < sortMe.size(); i++)
+            occupied[item.slot] = true;
+        }
+        for (int i = 0; i < slots; i++)
+        {
+            if ((size_t)i < order.size() ? items[order[i]].slot == i : !occupied[i])
+            {
+                continue;
+            }
+            std::shared_ptr<PKX> pkm = (size_t)i < order.size() ? items[order[i]].pkm : TitleLoader::save->emptyPkm();
+            if (storage)
             {
-                TitleLoader::save->pkm(sortMe[i], i / 30, i % 30, false);
+                Banks::bank->pkm(pkm, i / 30, i % 30);
             }
-            for (int i = sortMe.size(); i < TitleLoader::save->maxSlot(); i++)
+            else
             {
-                TitleLoader::save->pkm(TitleLoader::save->emptyPkm(), i / 30, i % 30, false);
+                TitleLoader::save->pkm(pkm, i / 30, i % 30, false);
             }
         }
     }
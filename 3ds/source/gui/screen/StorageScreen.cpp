@@ -28,6 +28,7 @@
 #include "gui.hpp"
 #include "MainMenu.hpp"
 #include "PK4.hpp"
+#include "PKXView.hpp"
 #include "Configuration.hpp"
 #include "TitleLoadScreen.hpp"
 #include "FSStream.hpp"
@@ -249,6 +250,8 @@ void StorageScreen::draw() const
         }
     }
 
+    // Reused for every slot drawn, so drawing a box doesn't allocate
+    PKXView view;
     u16 y = 45;
     for (u8 row = 0; row < 5; row++)
     {
@@ -267,10 +270,10 @@ void StorageScreen::draw() const
             }
             else
             {
-                std::shared_ptr<PKX> pokemon = TitleLoader::save->pkm(boxBox, row * 6 + column);
-                if (pokemon->species() > 0)
+                PKX& pokemon = TitleLoader::save->pkmView(view, boxBox, row * 6 + column);
+                if (pokemon.species() > 0)
                 {
-                    Gui::pkm(*pokemon, x, y);
+                    Gui::pkm(pokemon, x, y);
                 }
                 if (TitleLoader::save->generation() == Generation::LGPE)
                 {
@@ -386,10 +389,10 @@ void StorageScreen::draw() const
             {
                 C2D_DrawRectSolid(x, y, 0.5f, 34, 30, C2D_Color32(0x50, 0xC0, 0x40, 0xC0));
             }
-            auto pkm = Banks::bank->pkm(storageBox, row * 6 + column);
-            if (pkm->species() > 0)
+            PKX& pkm = Banks::bank->pkmView(view, storageBox, row * 6 + column);
+            if (pkm.species() > 0)
             {
-                Gui::pkm(*pkm, x, y);
+                Gui::pkm(pkm, x, y);
             }
             x += 34;
         }
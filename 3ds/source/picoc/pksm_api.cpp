@@ -36,6 +36,7 @@
 #include "PK6.hpp"
 #include "PK7.hpp"
 #include "banks.hpp"
+#include "query.hpp"
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <errno.h>
@@ -593,7 +594,7 @@ extern "C" {
 
     void i18n_species(struct ParseState *Parser, struct Value *ReturnValue, struct Value **Param, int NumArgs)
     {
-        ReturnValue->Val->Pointer = (void*) i18n::species(Configuration::getInstance().language(), Param[0]->Val->Integer).c_str();
+        ReturnValue->Val->Pointer = (void*) i18n::species(Configuration::getInstance().language(), Param[0]->Val->Integer).data();
     }
 
     void pkx_decrypt(struct ParseState *Parser, struct Value *ReturnValue, struct Value **Param, int NumArgs)
@@ -662,6 +663,72 @@ extern "C" {
         std::copy(pkm->rawData(), pkm->rawData() + pkm->getLength(), data);
     }
 
+    void pkx_generate_pids(struct ParseState *Parser, struct Value *ReturnValue, struct Value **Param, int NumArgs)
+    {
+        unsigned int* out = (unsigned int*) Param[0]->Val->Pointer;
+        int count = Param[1]->Val->Integer;
+        PKX::PIDSpec spec;
+        spec.species = Param[2]->Val->Integer;
+        spec.gender = Param[3]->Val->Integer;
+        spec.originGame = Param[4]->Val->Integer;
+        spec.nature = Param[5]->Val->Integer;
+        spec.form = Param[6]->Val->Integer;
+        spec.abilityNum = Param[7]->Val->Integer;
+        spec.shiny = PKX::Shininess(Param[8]->Val->Integer);
+        spec.TID = Param[9]->Val->Integer;
+        spec.SID = Param[10]->Val->Integer;
+        spec.gen = Generation(Param[11]->Val->Integer);
+
+        checkGen(Parser, spec.gen);
+        if (Param[8]->Val->Integer < 0 || Param[8]->Val->Integer > 2)
+        {
+            ProgramFail(Parser, "Shininess is not possible!");
+        }
+
+        if (count <= 0)
+        {
+            return;
+        }
+        std::vector<u32> pids = PKX::generatePIDs(spec, count);
+        if (pids.empty())
+        {
+            ProgramFail(Parser, "No PID satisfies these constraints!");
+        }
+        std::copy(pids.begin(), pids.end(), out);
+    }
+
+    void query_pkx(struct ParseState *Parser, struct Value *ReturnValue, struct Value **Param, int NumArgs)
+    {
+        char* text = (char*) Param[0]->Val->Pointer;
+        int source = Param[1]->Val->Integer;
+        int* results = (int*) Param[2]->Val->Pointer;
+        int maxResults = Param[3]->Val->Integer;
+
+        if (source < int(Query::Source::Save) || source > int(Query::Source::AllBanks))
+        {
+            ProgramFail(Parser, "Source is not possible!");
+        }
+        std::optional<PKFilter> filter = PKFilter::parse(text);
+        if (!filter)
+        {
+            ProgramFail(Parser, "Filter could not be parsed!");
+        }
+
+        // Results are (source, box, slot) triples
+        int found = 0;
+        Query::run(*filter, Query::Source(source), [&](const Query::Match& match) {
+            if (found >= maxResults)
+            {
+                return false;
+            }
+            results[found * 3] = match.source;
+            results[found * 3 + 1] = match.box;
+            results[found * 3 + 2] = match.slot;
+            return ++found < maxResults;
+        });
+        ReturnValue->Val->Integer = found;
+    }
+
     void pksm_utf8_to_utf16(struct ParseState *Parser, struct Value *ReturnValue, struct Value **Param, int NumArgs)
     {
         u8* data = (u8*) Param[0]->Val->Pointer;
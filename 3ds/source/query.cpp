@@ -0,0 +1,137 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "query.hpp"
+#include "banks.hpp"
+#include "loader.hpp"
+#include "thread.hpp"
+#include <atomic>
+
+namespace
+{
+    struct BoxScan
+    {
+        const std::function<u32(int)>* scanBox;
+        std::vector<u32> masks;
+        int first;
+        int last;
+        std::atomic<bool> stop{false};
+    };
+
+    void scanWorker(void* arg)
+    {
+        BoxScan* scan = (BoxScan*)arg;
+        for (int box = scan->first; box < scan->last && !scan->stop; box++)
+        {
+            scan->masks[box - scan->first] = (*scan->scanBox)(box);
+        }
+    }
+
+    bool emit(int source, int box, u32 mask, const std::function<bool(const Query::Match&)>& out)
+    {
+        for (int slot = 0; mask != 0; slot++, mask >>= 1)
+        {
+            if ((mask & 1) && !out({source, box, slot}))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Boxes below scan.first are scanned here and streamed right away; the rest are left to a worker
+    // when one can be started, and streamed once it's done
+    bool scanBoxes(int source, int boxes, const std::function<u32(int)>& scanBox, const std::function<bool(const Query::Match&)>& out)
+    {
+        BoxScan scan;
+        scan.scanBox = &scanBox;
+        scan.first = boxes / 2;
+        scan.last = boxes;
+        scan.masks.resize(scan.last - scan.first);
+        Thread worker = boxes > 1 ? Threads::spare(scanWorker, &scan) : nullptr;
+        if (!worker)
+        {
+            scan.first = boxes;
+        }
+
+        bool keepGoing = true;
+        for (int box = 0; box < scan.first && keepGoing; box++)
+        {
+            keepGoing = emit(source, box, scanBox(box), out);
+        }
+        if (worker)
+        {
+            scan.stop = !keepGoing;
+            threadJoin(worker, U64_MAX);
+            threadFree(worker);
+            for (int box = scan.first; box < scan.last && keepGoing; box++)
+            {
+                keepGoing = emit(source, box, scan.masks[box - scan.first], out);
+            }
+        }
+        return keepGoing;
+    }
+
+    bool scanBank(int source, const Bank& bank, const PKFilter& filter, const std::function<bool(const Query::Match&)>& out)
+    {
+        return scanBoxes(source, bank.boxes(), [&bank, &filter](int box) { return bank.find(filter, box); }, out);
+    }
+}
+
+void Query::run(const PKFilter& filter, Source source, const std::function<bool(const Match&)>& out)
+{
+    if (source == Source::Save)
+    {
+        if (TitleLoader::save)
+        {
+            Sav* save = TitleLoader::save.get();
+            scanBoxes(-1, save->maxBoxes(), [save, &filter](int box) { return save->find(filter, box); }, out);
+        }
+        return;
+    }
+
+    auto names = Banks::bankNames();
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (Banks::bank && names[i].first == Banks::bank->name())
+        {
+            if (!scanBank(i, *Banks::bank, filter, out))
+            {
+                return;
+            }
+        }
+        else if (source == Source::AllBanks)
+        {
+            // Only one other bank is kept in memory at a time, and it's never written back
+            Bank bank(names[i].first, Bank::ReadOnly{});
+            if (!scanBank(i, bank, filter, out))
+            {
+                return;
+            }
+        }
+    }
+}
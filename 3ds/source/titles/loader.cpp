@@ -300,9 +300,9 @@ void TitleLoader::backupSave(const std::string& id)
     out.close();
 }
 
-bool TitleLoader::load(u8* data, size_t size)
+bool TitleLoader::load(std::unique_ptr<u8[]> data, size_t size)
 {
-    save = Sav::getSave(data, size);
+    save = Sav::getSave(std::move(data), size);
     return save != nullptr;
 }
 
@@ -317,11 +317,10 @@ bool TitleLoader::load(std::shared_ptr<Title> title)
         FSStream in(archive, u"/main", FS_OPEN_READ);
         if (in.good())
         {
-            u8* data = new u8[in.size()];
-            in.read(data, in.size());
-            save = Sav::getSave(data, in.size());
+            std::unique_ptr<u8[]> data(new u8[in.size()]);
+            in.read(data.get(), in.size());
+            save = Sav::getSave(std::move(data), in.size());
             in.close();
-            delete[] data;
             FSUSER_CloseArchive(archive);
             if (Configuration::getInstance().autoBackup())
             {
@@ -347,20 +346,27 @@ bool TitleLoader::load(std::shared_ptr<Title> title)
             return false;
         }
 
-        u8* data = new u8[cap];
+        std::unique_ptr<u8[]> data(new u8[cap]);
         u32 sectorSize = (cap < 0x10000) ? cap : 0x10000;
 
         for (u32 i = 0; i < cap / sectorSize; ++i) {
-            SPIReadSaveData(title->SPICardType(), sectorSize * i, data + sectorSize * i, sectorSize);
+            SPIReadSaveData(title->SPICardType(), sectorSize * i, data.get() + sectorSize * i, sectorSize);
         }
 
-        save = Sav::getSave(data, cap);
-        delete[] data;
+        // Detected again on what was just read rather than trusting the card scan, as the save may have
+        // been written since
+        save = Sav::getSave(std::move(data), cap);
+        if (!save)
+        {
+            Gui::warn(title->name(), i18n::localize("SAVE_INVALID"));
+            loadedTitle = nullptr;
+            return false;
+        }
         if (Configuration::getInstance().autoBackup())
         {
             backupSave(title->checkpointPrefix());
         }
-        return save != nullptr;
+        return true;
     }
     Gui::warn("This should never happen!");
     return false;
@@ -373,12 +379,12 @@ bool TitleLoader::load(std::shared_ptr<Title> title, const std::string& savePath
     loadedTitle = title;
     FSStream in(Archive::sd(), StringUtils::UTF8toUTF16(savePath), FS_OPEN_READ);
     u32 size;
-    u8* saveData = nullptr;
+    std::unique_ptr<u8[]> saveData;
     if (in.good())
     {
         size = in.size();
-        saveData = new u8[size];
-        in.read(saveData, size);
+        saveData = std::unique_ptr<u8[]>(new u8[size]);
+        in.read(saveData.get(), size);
     }
     else
     {
@@ -389,8 +395,7 @@ bool TitleLoader::load(std::shared_ptr<Title> title, const std::string& savePath
         return false;
     }
     in.close();
-    save = Sav::getSave(saveData, size);
-    delete[] saveData;
+    save = Sav::getSave(std::move(saveData), size);
     if (!save)
     {
         Gui::warn(saveFileName, i18n::localize("SAVE_INVALID"));
@@ -592,9 +597,12 @@ bool TitleLoader::scanCard()
                     }
                 }
 
-                if (R_SUCCEEDED(res) && Sav::isValidDSSave(saveFile))
+                if (R_SUCCEEDED(res))
                 {
-                    cardTitle = title;
+                    if (Sav::detectDSSave(saveFile).valid)
+                    {
+                        cardTitle = title;
+                    }
                 }
 
                 delete[] saveFile;
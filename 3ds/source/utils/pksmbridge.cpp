@@ -59,14 +59,14 @@ bool receiveSaveFromBridge(void)
     lastIPAddr = servaddr.sin_addr;
 
     size_t size = 0x100000;
-    char* data = new char[size];
+    std::unique_ptr<u8[]> data(new u8[size]);
 
     size_t total = 0;
     size_t chunk = 1024;
     int n;
     while (total < size) {
         size_t torecv = size - total > chunk ? chunk : size - total;
-        n = recv(fdconn, data + total, torecv, 0);
+        n = recv(fdconn, data.get() + total, torecv, 0);
         total += n;
         if (n <= 0) { break; }
         fprintf(stderr, "Recv %u bytes, %u still missing\n", total, size - total);
@@ -77,7 +77,7 @@ bool receiveSaveFromBridge(void)
 
     if (n == 0 || total == size)
     {
-        if (TitleLoader::load((u8*)data, total))
+        if (TitleLoader::load(std::move(data), total))
         {
             saveFromBridge = true;
             Gui::setScreen(std::make_unique<MainMenu>());
@@ -88,7 +88,6 @@ bool receiveSaveFromBridge(void)
         Gui::error("Failed to receive data.", errno);
     }
 
-    delete[] data;
     return true;
 }
 
@@ -28,11 +28,11 @@
 
 static std::vector<Thread> threads;
 
-void Threads::create(ThreadFunc entrypoint)
+void Threads::create(ThreadFunc entrypoint, size_t stackSize, s32 priorityOffset)
 {
     s32 prio = 0;
     svcGetThreadPriority(&prio, CUR_THREAD_HANDLE);
-    Thread thread = threadCreate((ThreadFunc)entrypoint, NULL, 4*1024, prio-1, -2, false);
+    Thread thread = threadCreate((ThreadFunc)entrypoint, NULL, stackSize, prio + priorityOffset, -2, false);
     threads.push_back(thread);
 }
 
@@ -45,3 +45,16 @@ void Threads::destroy(void)
     }
     threads.clear();
 }
+
+Thread Threads::spare(ThreadFunc entrypoint, void* arg)
+{
+    bool isNew3DS = false;
+    APT_CheckNew3DS(&isNew3DS);
+    if (!isNew3DS)
+    {
+        return nullptr;
+    }
+    s32 prio = 0;
+    svcGetThreadPriority(&prio, CUR_THREAD_HANDLE);
+    return threadCreate(entrypoint, arg, 16*1024, prio, 2, false);
+}
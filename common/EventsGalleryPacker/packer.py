@@ -1,7 +1,6 @@
 #!/usr/bin/python3
 import git
 import os
-import json
 import struct
 import bz2
 import gen4string
@@ -9,6 +8,10 @@ import gen4string
 validLangs = ["CHS", "CHT", "ENG", "FRE", "GER", "ITA", "JPN", "KOR", "SPA"]
 validTypes = ["wc7", "wc6", "wc7full", "wc6full", "pgf", "wc4", "pgt"]
 
+# Size the cards are grouped into before compression; one of these is all PKSM decompresses to show a card
+CHUNK_SIZE = 0x8000
+GIFTS_VERSION = 1
+
 def getWC4(data):
 	return bytearray(data[0x8:0x8 + 136])
 
@@ -208,6 +211,47 @@ def scanDir(root, sheet, origOffset):
 				pass
 	return retdata
 
+# Binary index plus independently compressed chunks of cards, read by common/source/mysterygift.cpp.
+# Cards are 24 bytes, matches are the card index per language in validLangs order (0xFFFF if absent),
+# chunks are (file offset, compressed size, size), strings are NUL-terminated UTF-8
+def packGifts(sheet, data):
+	strings = b''
+	stringOffsets = {}
+	def addString(string):
+		nonlocal strings
+		if string not in stringOffsets:
+			stringOffsets[string] = len(strings)
+			strings += string.encode('utf-8') + b'\0'
+		return stringOffsets[string]
+
+	cards = b''
+	chunks = []
+	chunk = b''
+	for entry in sheet['wondercards']:
+		card = data[entry['offset']:entry['offset'] + entry['size']]
+		if len(chunk) > 0 and len(chunk) + len(card) > CHUNK_SIZE:
+			chunks.append(chunk)
+			chunk = b''
+		cards += struct.pack('<IIIHHhbbB3x', addString(entry.get('name', '')), addString(entry.get('game', '')), len(chunk), len(chunks),
+			len(card), entry.get('species', -1), entry.get('form', -1), entry.get('gender', -1), validTypes.index(entry['type']))
+		chunk += card
+	if len(chunk) > 0:
+		chunks.append(chunk)
+
+	matches = b''
+	for match in sheet['matches']:
+		matches += struct.pack('<9H', *[match['indices'].get(lang, 0xFFFF) for lang in validLangs])
+
+	compressed = [bz2.compress(chunk) for chunk in chunks]
+	chunkTable = b''
+	offset = 24 + len(cards) + len(matches) + 12 * len(chunks) + len(strings)
+	for i in range(len(chunks)):
+		chunkTable += struct.pack('<III', offset, len(compressed[i]), len(chunks[i]))
+		offset += len(compressed[i])
+
+	header = struct.pack('<4sIIIII', b'PKSG', GIFTS_VERSION, len(sheet['wondercards']), len(sheet['matches']), len(chunks), len(strings))
+	return header + cards + matches + chunkTable + strings + b''.join(compressed)
+
 # create out directory
 try:
     os.stat("./out")
@@ -243,19 +287,7 @@ for gen in range (4, 7+1):
 	if (gen == 7):
 		data += scanDir("./EventsGallery/Unreleased/Gen 7/Movie 21", sheet, len(data))
 	
-	# sort, then get rid of data not needed in final product
+	# sort, then export the index and card data
 	sheet['matches'] = sorted(sheet['matches'], key=sortById)
-	for i in range(len(sheet['matches'])):
-		temp = sheet['matches'][i]['indices']
-		sheet['matches'][i] = temp
-		sheet['matches'][i]
-		
-	# export sheet
-	compressed = bz2.compress(str.encode(json.dumps(sheet)))
-	with open("./out/sheet{}.json.bz2".format(gen), 'wb') as f:
-		f.write(compressed)
-
-	# export data
-	compressed = bz2.compress(data)
-	with open("./out/data{}.bin.bz2".format(gen), 'wb') as f:
-		f.write(compressed)
+	with open("./out/gifts{}.bin".format(gen), 'wb') as f:
+		f.write(packGifts(sheet, data))
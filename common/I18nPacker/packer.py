@@ -0,0 +1,190 @@
+#!/usr/bin/python3
+import json
+import os
+import struct
+
+# Packs every language's strings into one strings.bin, read by LanguageStrings in a single pass.
+#
+# Layout (little endian):
+#   char magic[4] = "PKSI"; u32 version; u32 tableCount
+#   tableCount * { u32 count; u32 offsets; u32 ids; u32 buckets; }
+#     offsets: file offset of count + 1 u32 string offsets; string i spans [offsets[i], offsets[i + 1] - 1)
+#     ids:     file offset of count ids, or 0 for plain lists. Sorted u16s for locations. For gui, u32 key hashes
+#              followed by count + 1 u32 offsets of the keys themselves, laid out like the strings
+#     buckets: file offset of a hash table for keyed tables, or 0: u32 size (a power of two), then size u16s
+#              holding 1 + the index of the entry whose hash starts probing there, or 0 if empty
+#   string pool: NUL terminated UTF-8
+
+MAGIC = b'PKSI'
+VERSION = 3
+
+# Must match the order of LanguageStrings::Table; gui comes last
+lists = ["abilities", "balls", "forms", "hp", "items", "moves", "natures", "species", "games"]
+maps = ["locations4", "locations5", "locations6", "locations7", "locationsLGPE"]
+
+# The text sources stay out of romfs; only the packed tables ship
+root = os.path.join("..", "..", "assets", "i18n")
+out = os.path.join("..", "..", "assets", "romfs", "i18n")
+
+# Must match LanguageStrings::guiKey
+def guiKey(key):
+	ret = 0x811C9DC5
+	for byte in key.encode('utf-8'):
+		ret = ((ret ^ byte) * 0x01000193) & 0xFFFFFFFF
+	return ret
+
+def readLines(lang, name):
+	path = os.path.join(root, lang, name + ".txt")
+	if not os.path.exists(path):
+		path = os.path.join(root, "en", name + ".txt")
+	with open(path, 'rb') as f:
+		lines = f.read().split(b'\n')
+	if lines[-1] == b'':
+		lines = lines[:-1]
+	return [line.split(b'\r')[0] for line in lines]
+
+def readList(lang, name):
+	return None, readLines(lang, name), None
+
+def readMap(lang, name):
+	entries = {}
+	for line in readLines(lang, name):
+		try:
+			entries[int(line[:4], 16)] = line[5:]
+		except ValueError:
+			continue
+	ids = sorted(entries)
+	return ids, [entries[i] for i in ids], None
+
+# Keys missing from a translation are filled in from English here, so the lookup never has to fall back at runtime
+def readGui(lang):
+	with open(os.path.join(root, "en", "gui.json"), 'rb') as f:
+		entries = json.load(f)
+	path = os.path.join(root, lang, "gui.json")
+	if os.path.exists(path):
+		with open(path, 'rb') as f:
+			entries.update(json.load(f))
+	hashes = {}
+	for key in entries:
+		hash = guiKey(key)
+		if hash in hashes:
+			raise Exception("GUI keys {} and {} have the same hash".format(key, hashes[hash]))
+		hashes[hash] = key
+	ids = sorted(hashes)
+	return ids, [entries[hashes[i]].encode('utf-8') for i in ids], [hashes[i].encode('utf-8') for i in ids]
+
+def buckets(ids):
+	size = 1
+	while size < 2 * len(ids):
+		size *= 2
+	table = [0] * size
+	for index, hash in enumerate(ids):
+		slot = hash & (size - 1)
+		while table[slot] != 0:
+			slot = (slot + 1) & (size - 1)
+		table[slot] = index + 1
+	return struct.pack('<I', size) + b''.join(struct.pack('<H', i) for i in table)
+
+def pad(data):
+	return data + b'\0' * (-len(data) % 4)
+
+def pack(lang):
+	tables = [readList(lang, name) for name in lists] + [readMap(lang, name) for name in maps] + [readGui(lang)]
+	keyed = len(tables) - 1
+
+	headerSize = 12 + 16 * len(tables)
+	headers = b''
+	indices = b''
+	pool = b''
+	# Offsets into the pool are fixed up once the size of the index section is known
+	fixups = []
+	def addStrings(strings):
+		nonlocal pool, indices
+		offsets = []
+		for string in strings:
+			offsets.append(len(pool))
+			pool += string + b'\0'
+		offsets.append(len(pool))
+		offsetPos = len(indices)
+		indices += b''.join(struct.pack('<I', 0) for _ in offsets)
+		fixups.append((offsetPos, offsets))
+		return offsetPos
+
+	for table, (ids, strings, keys) in enumerate(tables):
+		offsetPos = addStrings(strings)
+		idPos = 0
+		bucketPos = 0
+		if table == keyed:
+			idPos = headerSize + len(indices)
+			indices += b''.join(struct.pack('<I', i) for i in ids)
+			addStrings(keys)
+			bucketPos = headerSize + len(indices)
+			indices = pad(indices + buckets(ids))
+		elif ids is not None:
+			idPos = headerSize + len(indices)
+			indices = pad(indices + b''.join(struct.pack('<H', i) for i in ids))
+		headers += struct.pack('<IIII', len(strings), headerSize + offsetPos, idPos, bucketPos)
+
+	poolStart = headerSize + len(indices)
+	indices = bytearray(indices)
+	for offsetPos, offsets in fixups:
+		for i, offset in enumerate(offsets):
+			struct.pack_into('<I', indices, offsetPos + 4 * i, poolStart + offset)
+
+	os.makedirs(os.path.join(out, lang), exist_ok=True)
+	with open(os.path.join(out, lang, "strings.bin"), 'wb') as f:
+		f.write(MAGIC + struct.pack('<II', VERSION, len(tables)))
+		f.write(headers)
+		f.write(indices)
+		f.write(pool)
+
+# forms.bin maps (species, generation) to the form name indices of that species' forms, shared by every language.
+#
+# Layout (little endian):
+#   char magic[4] = "PKSF"; u32 version; u32 speciesCount; u32 generationCount
+#   speciesCount * generationCount * { u16 start; u16 count; }: a span of the index pool, in Generation order
+#   u16 index pool: indices into each language's forms table
+FORMS_MAGIC = b'PKSF'
+FORMS_VERSION = 1
+
+# Generation order, as named in forms.json
+generations = ["4", "5", "6", "7", "LGPE"]
+
+def packForms():
+	with open(os.path.join(root, "forms.json"), 'rb') as f:
+		forms = json.load(f)
+	megas = forms.pop("megas")
+
+	speciesCount = max(max(int(species) for species in forms), max(megas)) + 1
+	spans = b''
+	pool = []
+	starts = {}
+	for species in range(speciesCount):
+		for generation in generations:
+			if str(species) in forms:
+				entry = forms[str(species)]
+				indices = entry if isinstance(entry, list) else entry.get(generation, [])
+			elif species in megas:
+				indices = [0, 146]
+			else:
+				indices = []
+			key = tuple(indices)
+			if key not in starts:
+				starts[key] = len(pool)
+				pool += indices
+			spans += struct.pack('<HH', starts[key], len(indices))
+
+	os.makedirs(out, exist_ok=True)
+	with open(os.path.join(out, "forms.bin"), 'wb') as f:
+		f.write(FORMS_MAGIC + struct.pack('<III', FORMS_VERSION, speciesCount, len(generations)))
+		f.write(spans)
+		f.write(b''.join(struct.pack('<H', i) for i in pool))
+
+def main():
+	for lang in sorted(os.listdir(root)):
+		if os.path.isdir(os.path.join(root, lang)):
+			pack(lang)
+	packForms()
+
+if __name__ == '__main__':
+	main()
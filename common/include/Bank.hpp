@@ -27,34 +27,54 @@
 #ifndef BANK_HPP
 #define BANK_HPP
 
+#include "BankIndex.hpp"
+#include "json.hpp"
 #include "Sav.hpp"
+#include <vector>
 
-extern "C" {
-#include "sha256.h"
-}
+class FSStream;
 
 class Bank
 {
 public:
     Bank(const std::string& name, int maxBoxes);
+    // Loads the bank as it is on the card, journal included, only to be read: nothing is shown,
+    // converted, resized, saved or backed up
+    struct ReadOnly {};
+    Bank(const std::string& name, ReadOnly);
     ~Bank()
     {
         delete[] data;
     }
     std::shared_ptr<PKX> pkm(int box, int slot) const;
     void pkm(std::shared_ptr<PKX> pkm, int box, int slot);
+    // Non-owning PKX over the bank entry, built in view; call commitView after writing through it
+    PKX& pkmView(PKXView& view, int box, int slot);
+    void commitView(int box, int slot) { markSlot(box * 30 + slot); }
     void resize(size_t boxes);
     void load(int maxBoxes);
+    // Commits changes, to the journal if it's enabled and to the bank file otherwise
     bool save() const;
+    // Folds the journal into the bank file; only possible without unsaved changes
+    bool compact() const;
     void backup() const;
     std::string boxName(int box) const;
     void boxName(std::string name, int box);
     bool hasChanged() const;
+    // Slots (box * 30 + slot) whose contents differ from the last load or save
+    std::vector<int> changedSlots() const;
+    // Bumped on every write to the bank, whether or not it changed anything
+    u32 revision() const { return writeCount; }
+    // Slots matching the query, answered from the index. Only slots whose OT name hash matches are decoded
+    std::vector<int> find(const BankIndex::Query& query) const;
+    // Bitmask of the slots in a box whose stored contents match the filter. Only reads, so boxes can
+    // be scanned concurrently
+    u32 find(const PKFilter& filter, int box) const;
     int boxes() const;
     const std::string& name() const;
     bool setName(const std::string& name);
 private:
-    static constexpr int BANK_VERSION = 2;
+    static constexpr int BANK_VERSION = 3;
     static constexpr std::string_view BANK_MAGIC = "PKSMBANK";
     void createJSON();
     void createBank(int maxBoxes);
@@ -68,11 +88,117 @@ private:
         Generation gen;
         u8 data[260];
     };
+    // Version 3 files are the header, two copies of the box table and then the entries. Saves write
+    // the older table copy with the next sequence number, so a torn write leaves the other one intact
+    struct TableHeader {
+        u32 sequence;
+        u16 checksum;
+        u16 reserved;
+    };
+    struct BoxInfo {
+        char name[78];
+        u16 checksum; // CRC-16/CCITT of the box's 30 entries
+    };
+    static u32 tableSize(int boxes);
+    static u32 fileSize(int boxes);
+    static u16 tableChecksum(const u8* table, u32 len);
+    u16 boxChecksum(int box) const;
+    std::vector<u8> buildTable(u32 sequence, const std::vector<u16>& checksums) const;
+    bool readTables(FSStream& in, std::vector<bool>& mismatched);
+    // Writes the whole file as it is in memory; checksums receives the box checksums written
+    Result writeFile(FSStream& out, u32 sequence, std::vector<u16>& checksums) const;
+    // Deletes and recreates path in the bank's archive with the whole file
+    Result writeWhole(const std::string& path, u32 sequence, std::vector<u16>& checksums) const;
+    Result writeChanges(FSStream& out) const;
+    void markStale() const;
+    Result writeBank() const;
+    // Full rewrites go to this file first and are then copied over the bank file, so a crash while the
+    // bank file is being replaced leaves a complete copy behind; load() finishes the copy
+    std::string rewritePath() const;
+    static bool completeFile(const std::vector<u8>& file);
+    void recoverRewrite(const std::string& bankPath);
+
+    // The journal (.bnkj) holds saved changes that aren't in the bank file yet. It starts with the table
+    // sequence of the bank file it applies to; records are only replayed up to the last commit. ExtData
+    // files can't grow, so it's created with room for JOURNAL_LIMIT records and the header counts them
+    static constexpr std::string_view JOURNAL_MAGIC = "PKSMJRNL";
+    // Records the journal holds; a save that doesn't fit goes to the bank file instead
+    static constexpr u32 JOURNAL_LIMIT = 256;
+    struct JournalHeader {
+        char MAGIC[8];
+        u32 sequence;
+        u32 records; // Written after the records themselves, so it only ever covers complete ones
+    };
+    enum class JournalOp : u16
+    {
+        Slot,
+        Name,
+        Commit
+    };
+    struct JournalRecord {
+        JournalOp op;
+        u16 index;
+        u16 checksum;
+        u16 reserved;
+        union {
+            BankEntry entry;
+            char name[sizeof(BoxInfo::name)];
+        };
+    };
+    std::string journalPath() const;
+    static u32 journalSize();
+    // Records the next appendJournal would write, commit included
+    u32 pendingRecords() const;
+    static u16 recordChecksum(const JournalRecord& record);
+    void resetJournal() const;
+    Result appendJournal() const;
+    bool replayJournal();
+
+    // The index (.bnki) is saved alongside the bank file and carries its table sequence; a missing or
+    // stale one is rebuilt on load
+    static constexpr std::string_view INDEX_MAGIC = "PKSMBIDX";
+    struct IndexHeader {
+        char MAGIC[8];
+        u32 sequence;
+        u32 boxes;
+    };
+    std::string indexPath() const;
+    void indexSlot(int slot);
+    void rebuildIndex();
+    bool readIndex();
+    void writeIndex(bool whole) const;
+    static bool isParty(const BankEntry& entry);
+    static u64 digest(const BankEntry& entry);
+    // Records the saved digest of a slot before its first write since the last load or save
+    void prime(int index);
+    // Re-evaluates a written slot against its saved digest
+    void markSlot(int index);
+    void resetTracking() const;
+    // Fits the per-slot and per-box state to a new box count, keeping what is tracked for the kept slots
+    void resizeTracking() const;
     u8* data = nullptr;
     nlohmann::json boxNames;
     size_t size;
-    mutable std::array<u8, SHA256_BLOCK_SIZE> prevHash;
-    mutable bool needsCheck = false;
+    // Per-slot change tracking: a slot is primed with the digest of its saved contents when it is
+    // first written, and is dirty while its current digest differs from that
+    mutable std::vector<u64> savedDigests;
+    mutable std::vector<bool> primed;
+    mutable std::vector<bool> dirty;
+    mutable int dirtyCount = 0;
+    u32 writeCount = 0;
+    // On-disk state for in-place saves
+    mutable std::vector<u16> boxChecksums;
+    mutable u32 tableSequence = 0;
+    mutable bool rewrite = true;
+    mutable bool namesChanged = false;
+    mutable std::vector<bool> renamed;
+    // Boxes and names that are newer in memory and the journal than in the bank file
+    mutable std::vector<bool> staleBoxes;
+    mutable bool staleNames = false;
+    mutable u32 journalRecords = 0;
+    BankIndex slotIndex;
+    // Whether the index file matches slotIndex outside of the stale boxes
+    mutable bool indexOnDisk = false;
     std::string bankName;
 };
 
@@ -0,0 +1,101 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef BANKINDEX_HPP
+#define BANKINDEX_HPP
+
+#include "generation.hpp"
+#include "types.h"
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compact per-slot summaries of a bank's contents, so lookups don't have to decode every slot
+class BankIndex
+{
+public:
+    struct Entry
+    {
+        u16 species; // 0 for empty slots
+        u16 heldItem;
+        u16 TID;
+        u16 SID;
+        u32 otHash; // See hashName
+        u8 form;
+        u8 nature;
+        u8 ball;
+        u8 ivTotal;
+        u8 generation; // Generation value
+        u8 shiny;
+        u16 reserved;
+    };
+
+    // Every set field has to match; an empty query matches all occupied slots
+    struct Query
+    {
+        std::optional<u16> species;
+        std::optional<u8> form;
+        std::optional<bool> shiny;
+        std::optional<Generation> generation;
+        std::optional<std::string> otName;
+        std::optional<u16> TID;
+        std::optional<u8> nature;
+        std::optional<u8> ball;
+        std::optional<u16> heldItem;
+        u8 minIVTotal = 0;
+        u8 maxIVTotal = 31 * 6;
+    };
+
+    void resize(size_t slots);
+    // Re-describes a slot from its stored, decrypted bytes
+    void update(int index, Generation gen, u8* data, bool party);
+    // Takes over entries read back from disk and rebuilds the lookup tables
+    void assign(const Entry* begin, size_t count);
+    // Slot indices (box * 30 + slot) matching the query, in ascending order. OT names are only compared by
+    // hash, so hits on otName have to be confirmed against the slot with otName()
+    std::vector<int> find(const Query& query) const;
+
+    const Entry* entries(void) const { return table.data(); }
+    size_t size(void) const { return table.size(); }
+
+    // 32-bit FNV-1a of a name's UTF-8 bytes
+    static u32 hashName(const std::string& name);
+    // OT name of a slot's stored, decrypted bytes, as update() would hash it
+    static std::string otName(Generation gen, u8* data, bool party);
+
+private:
+    bool matches(const Entry& entry, const Query& query, u32 otHash) const;
+    void unlink(int index);
+    void link(int index);
+
+    std::vector<Entry> table;
+    // Occupied slots of each species, kept sorted
+    std::unordered_map<u16, std::vector<int>> bySpecies;
+};
+
+#endif
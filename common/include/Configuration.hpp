@@ -35,7 +35,7 @@
 class Configuration
 {
 public:
-    static constexpr int CURRENT_VERSION = 6;
+    static constexpr int CURRENT_VERSION = 7;
 
     static Configuration& getInstance(void)
     {
@@ -43,9 +43,10 @@ public:
         return config;
     }
 
+    // Cached, since every localized string asks for it
     Language language(void) const
     {
-        return mJson["language"];
+        return mLanguage;
     }
 
     bool autoBackup(void) const
@@ -131,9 +132,14 @@ public:
         return mJson["showBackups"];
     }
 
+    bool bankJournal(void)
+    {
+        return mJson["bankJournal"];
+    }
+
     void language(Language lang)
     {
-        mJson["language"] = lang;
+        mJson["language"] = mLanguage = lang;
     }
 
     void autoBackup(bool backup)
@@ -221,6 +227,11 @@ public:
         mJson["showBackups"] = value;
     }
 
+    void bankJournal(bool value)
+    {
+        mJson["bankJournal"] = value;
+    }
+
     void save(void);
 
 private:
@@ -233,6 +244,7 @@ private:
     void loadFromRomfs(void);
 
     nlohmann::json mJson;
+    Language mLanguage = Language::EN;
 
     size_t oldSize = 0;
 };
@@ -0,0 +1,71 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef DECOMPRESSSTREAM_HPP
+#define DECOMPRESSSTREAM_HPP
+
+#include <bzlib.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "types.h"
+
+// Decompresses a bzip2 file as it's read, holding only a small input buffer, so that nothing has to guess
+// how large the output will be
+class DecompressStream
+{
+public:
+    DecompressStream(const std::string& path);
+    // Reads length compressed bytes from the current position of file, which stays open afterwards
+    DecompressStream(FILE* file, u32 length);
+    ~DecompressStream(void);
+    DecompressStream(const DecompressStream&) = delete;
+    DecompressStream& operator=(const DecompressStream&) = delete;
+
+    bool good(void);
+    bool eof(void);
+    // Total decompressed bytes so far
+    u32  offset(void);
+    // Fills up to size bytes of buf; returns how many were written, which is less than size only at the
+    // end of the stream or on an error
+    u32  read(void* buf, u32 size);
+    // Appends everything that's left to out, growing it in fixed steps rather than by doubling.
+    // Returns whether the whole stream decompressed correctly
+    bool readAll(std::vector<u8>& out);
+
+private:
+    FILE*     mFile;
+    bool      mOwnsFile;
+    u32       mRemaining;
+    bz_stream mStream;
+    bool      mInitialized;
+    bool      mGood;
+    bool      mEof;
+    char      mIn[0x1000];
+};
+
+#endif
@@ -27,7 +27,6 @@
 #ifndef MYSTERYGIFT_HPP
 #define MYSTERYGIFT_HPP
 
-#include <bzlib.h>
 #include "WB7.hpp"
 #include "WC7.hpp"
 #include "WC6.hpp"
@@ -36,6 +35,7 @@
 #include "WC4.hpp"
 #include "json.hpp"
 #include "utils.hpp"
+#include <array>
 
 namespace MysteryGift
 {
@@ -46,8 +46,20 @@ namespace MysteryGift
         int form;
         int gender;
     };
+    // One event, with the index of its card in each language it was released in
+    struct giftMatch {
+        static constexpr u16 NO_CARD = 0xFFFF;
+        // Ordered CHS, CHT, ENG, FRE, GER, ITA, JPN, KOR, SPA
+        std::array<u16, 9> cards;
+
+        giftMatch() { cards.fill(NO_CARD); }
+        bool has(Language lang) const;
+        // Falls back to the first language the event was released in
+        size_t card(Language lang) const;
+        Language language(Language preferred) const;
+    };
     void init(Generation gen);
-    std::vector<nlohmann::json> wondercards();
+    const std::vector<giftMatch>& wondercards();
     MysteryGift::giftData wondercardInfo(size_t index);
     std::unique_ptr<WCX> wondercard(size_t index);
     void exit();
@@ -0,0 +1,57 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include "PKFilter.hpp"
+#include "types.h"
+#include <functional>
+
+// Runs compiled filters over the raw slots of the save and the banks
+namespace Query
+{
+    enum class Source : u8
+    {
+        Save,
+        Bank,    // The loaded bank
+        AllBanks // Reads each of the other banks in turn, without saving or backing them up
+    };
+
+    struct Match
+    {
+        int source; // -1 for the save, otherwise the bank's position in Banks::bankNames()
+        int box;
+        int slot;
+    };
+
+    // Calls out for every match, in box order, as soon as its box is scanned; out returns false to stop.
+    // On the New 3DS, half of the boxes of each save or bank are scanned on the extra core
+    void run(const PKFilter& filter, Source source, const std::function<bool(const Match&)>& out);
+}
+
+#endif
@@ -30,3 +30,16 @@
 #ifdef __SWITCH__
  #include <switch/types.h>
 #endif
+#if !defined(_3DS) && !defined(__SWITCH__)
+ // Host builds of common/, such as common/tests
+ #include <stdint.h>
+ typedef uint8_t u8;
+ typedef uint16_t u16;
+ typedef uint32_t u32;
+ typedef uint64_t u64;
+ typedef int8_t s8;
+ typedef int16_t s16;
+ typedef int32_t s32;
+ typedef int64_t s64;
+ typedef s32 Result;
+#endif
@@ -0,0 +1,53 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef G4TEXT_HPP
+#define G4TEXT_HPP
+
+#include <string>
+#include <string_view>
+#include "types.h"
+
+// Gen 4 games use their own 16-bit character encoding instead of UTF-16. Both directions are plain
+// table lookups built at compile time from the game's character map.
+namespace G4Text
+{
+    // Terminates a Gen 4 string; also what unmapped Gen 4 characters decode to
+    constexpr char16_t TERMINATOR = 0xFFFF;
+
+    char16_t toUnicode(u16 g4);
+    // 0 if the character has no Gen 4 equivalent
+    u16 fromUnicode(char16_t codepoint);
+
+    // Appends the UTF-8 form of up to len Gen 4 characters to out, stopping at the first terminator
+    void decode(const u16* src, size_t len, std::string& out);
+    // Writes at most len - 1 Gen 4 characters followed by a terminator, zeroing the rest of dst.
+    // Returns the number of characters written, not counting the terminator
+    size_t encode(std::string_view src, u16* dst, size_t len);
+}
+
+#endif
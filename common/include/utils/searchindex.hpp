@@ -0,0 +1,85 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef SEARCHINDEX_HPP
+#define SEARCHINDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "types.h"
+
+// Case-folded name lookup for the pickers' search bars. Names are folded and sorted once when the index
+// is built, so prefix searches are a binary search over the sorted keys; substring searches go through a
+// trigram index built on first use. An index is meant to be built once per list and shared, with each
+// search bar keeping its own Search.
+class SearchIndex
+{
+public:
+    // Names are numbered in the order they're given
+    SearchIndex(const std::vector<std::string_view>& names, bool ignoreAccents = true);
+    size_t size(void) const { return keys.size(); }
+
+    // The state of one search bar. A search that extends the previous one only looks through the previous results
+    class Search
+    {
+    public:
+        Search(const SearchIndex& index) : index(&index) {}
+        // Numbers of the names that start with, or with substring set contain, search; in ascending order
+        const std::vector<size_t>& find(std::string_view search, bool substring = false);
+
+    private:
+        void findPrefix(const std::string& search);
+        void findSubstring(const std::string& search);
+
+        const SearchIndex* index;
+        std::vector<size_t> results;
+        std::string lastSearch;
+        bool lastSubstring = false;
+        bool hasLast       = false;
+        // Range of sorted that matched the last prefix search
+        size_t lo = 0;
+        size_t hi = 0;
+    };
+
+    // ASCII and Latin-1 lowercasing, optionally dropping accents so that "flabebe" finds "Flabébé"
+    static std::string fold(std::string_view str, bool ignoreAccents);
+
+private:
+    const std::unordered_map<u32, std::vector<u32>>& trigrams(void) const;
+
+    bool ignoreAccents;
+    std::vector<std::string> keys;
+    // Name numbers ordered by key
+    std::vector<u32> sorted;
+    // Not thread safe; an index is only searched from the thread that draws its picker
+    mutable std::unordered_map<u32, std::vector<u32>> trigramPostings;
+    mutable bool trigramsBuilt = false;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef SLAB_HPP
+#define SLAB_HPP
+
+#include <cstddef>
+#include "types.h"
+
+// Size-classed pool for small, short-lived objects like PKX and their shared_ptr control blocks.
+// Every thread carves blocks out of its own chunks, so allocating takes no lock; a block freed on
+// another thread is handed back to the chunk's owner. Chunks are kept for reuse, never released.
+namespace Slab
+{
+    struct Stats
+    {
+        size_t live;        // bytes currently handed out
+        size_t peak;        // highest value live has reached
+        size_t allocations; // blocks handed out since startup; sample twice for a rate
+        size_t reserved;    // bytes held in chunks
+    };
+
+    // Requests larger than this go straight to operator new
+    constexpr size_t MAX_SIZE = 512;
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr, size_t size);
+    Stats stats(void);
+
+    // For std::allocate_shared, which puts the control block and the object in one block
+    template <typename T>
+    struct Allocator
+    {
+        using value_type = T;
+
+        Allocator() = default;
+        template <typename U>
+        Allocator(const Allocator<U>&) {}
+
+        T* allocate(size_t n) { return (T*)Slab::allocate(n * sizeof(T)); }
+        void deallocate(T* ptr, size_t n) { Slab::deallocate(ptr, n * sizeof(T)); }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const Allocator<T>&, const Allocator<U>&) { return true; }
+    template <typename T, typename U>
+    bool operator!=(const Allocator<T>&, const Allocator<U>&) { return false; }
+}
+
+#endif
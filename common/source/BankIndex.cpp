@@ -0,0 +1,189 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "BankIndex.hpp"
+#include <algorithm>
+#include "PB7.hpp"
+#include "PK4.hpp"
+#include "PK5.hpp"
+#include "PK6.hpp"
+#include "PK7.hpp"
+
+namespace
+{
+    BankIndex::Entry describe(const PKX& pkm)
+    {
+        BankIndex::Entry entry{};
+        if (pkm.species() == 0 || pkm.encryptionConstant() == 0)
+        {
+            return entry;
+        }
+        entry.species    = pkm.species();
+        entry.heldItem   = pkm.heldItem();
+        entry.TID        = pkm.TID();
+        entry.SID        = pkm.SID();
+        entry.otHash     = BankIndex::hashName(pkm.otName());
+        entry.form       = pkm.alternativeForm();
+        entry.nature     = pkm.nature();
+        entry.ball       = pkm.ball();
+        entry.generation = u8(pkm.generation());
+        entry.shiny      = pkm.shiny();
+        for (int i = 0; i < 6; i++)
+        {
+            entry.ivTotal += pkm.iv(i);
+        }
+        return entry;
+    }
+
+    // Calls f on a view over the slot, so nothing is copied or allocated, or returns empty for unused slots
+    template <typename F, typename R>
+    R withView(Generation gen, u8* data, bool party, F f, R empty)
+    {
+        switch (gen)
+        {
+            case Generation::FOUR:
+                return f(PK4(data, false, party, true));
+            case Generation::FIVE:
+                return f(PK5(data, false, party, true));
+            case Generation::SIX:
+                return f(PK6(data, false, party, true));
+            case Generation::SEVEN:
+                return f(PK7(data, false, party, true));
+            case Generation::LGPE:
+                return f(PB7(data, false, true));
+            case Generation::UNUSED:
+            default:
+                return empty;
+        }
+    }
+}
+
+u32 BankIndex::hashName(const std::string& name)
+{
+    u32 hash = 0x811C9DC5;
+    for (char c : name)
+    {
+        hash = (hash ^ u8(c)) * 0x01000193;
+    }
+    return hash;
+}
+
+void BankIndex::resize(size_t slots)
+{
+    for (size_t i = slots; i < table.size(); i++)
+    {
+        unlink(i);
+    }
+    table.resize(slots, Entry{});
+}
+
+void BankIndex::update(int index, Generation gen, u8* data, bool party)
+{
+    unlink(index);
+    table[index] = withView(gen, data, party, [](const PKX& pkm) { return describe(pkm); }, Entry{});
+    link(index);
+}
+
+std::string BankIndex::otName(Generation gen, u8* data, bool party)
+{
+    return withView(gen, data, party, [](const PKX& pkm) { return pkm.otName(); }, std::string{});
+}
+
+void BankIndex::assign(const Entry* begin, size_t count)
+{
+    table.assign(begin, begin + count);
+    bySpecies.clear();
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        link(i);
+    }
+}
+
+std::vector<int> BankIndex::find(const Query& query) const
+{
+    std::vector<int> ret;
+    u32 otHash = query.otName ? hashName(*query.otName) : 0;
+    if (query.species)
+    {
+        auto found = bySpecies.find(*query.species);
+        if (found != bySpecies.end())
+        {
+            for (int index : found->second)
+            {
+                if (matches(table[index], query, otHash))
+                {
+                    ret.push_back(index);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < table.size(); i++)
+        {
+            if (table[i].species != 0 && matches(table[i], query, otHash))
+            {
+                ret.push_back(i);
+            }
+        }
+    }
+    return ret;
+}
+
+bool BankIndex::matches(const Entry& entry, const Query& query, u32 otHash) const
+{
+    return (!query.form || entry.form == *query.form) && (!query.shiny || bool(entry.shiny) == *query.shiny) &&
+           (!query.generation || entry.generation == u8(*query.generation)) && (!query.otName || entry.otHash == otHash) &&
+           (!query.TID || entry.TID == *query.TID) && (!query.nature || entry.nature == *query.nature) &&
+           (!query.ball || entry.ball == *query.ball) && (!query.heldItem || entry.heldItem == *query.heldItem) &&
+           entry.ivTotal >= query.minIVTotal && entry.ivTotal <= query.maxIVTotal;
+}
+
+void BankIndex::unlink(int index)
+{
+    if (table[index].species != 0)
+    {
+        auto found = bySpecies.find(table[index].species);
+        if (found != bySpecies.end())
+        {
+            auto i = std::lower_bound(found->second.begin(), found->second.end(), index);
+            if (i != found->second.end() && *i == index)
+            {
+                found->second.erase(i);
+            }
+        }
+    }
+}
+
+void BankIndex::link(int index)
+{
+    if (table[index].species != 0)
+    {
+        std::vector<int>& slots = bySpecies[table[index].species];
+        slots.insert(std::lower_bound(slots.begin(), slots.end(), index), index);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "DecompressStream.hpp"
+#include <algorithm>
+#include <string.h>
+
+// Growth step for readAll; the most it can over-allocate by
+static constexpr size_t READALL_STEP = 0x10000;
+
+DecompressStream::DecompressStream(const std::string& path) : DecompressStream(fopen(path.c_str(), "rb"), UINT32_MAX)
+{
+    mOwnsFile = true;
+}
+
+DecompressStream::DecompressStream(FILE* file, u32 length) : mFile(file), mOwnsFile(false), mRemaining(length), mEof(false)
+{
+    memset(&mStream, 0, sizeof(mStream));
+    mInitialized = mFile != NULL && BZ2_bzDecompressInit(&mStream, 0, 0) == BZ_OK;
+    mGood = mInitialized;
+}
+
+DecompressStream::~DecompressStream(void)
+{
+    if (mInitialized)
+    {
+        BZ2_bzDecompressEnd(&mStream);
+    }
+    if (mOwnsFile && mFile != NULL)
+    {
+        fclose(mFile);
+    }
+}
+
+bool DecompressStream::good(void)
+{
+    return mGood;
+}
+
+bool DecompressStream::eof(void)
+{
+    return mEof;
+}
+
+u32 DecompressStream::offset(void)
+{
+    return mStream.total_out_lo32;
+}
+
+u32 DecompressStream::read(void* buf, u32 size)
+{
+    if (!mGood || mEof)
+    {
+        return 0;
+    }
+
+    mStream.next_out = (char*)buf;
+    mStream.avail_out = size;
+    while (mStream.avail_out > 0)
+    {
+        if (mStream.avail_in == 0 && mRemaining > 0)
+        {
+            u32 wanted = std::min((u32)sizeof(mIn), mRemaining);
+            u32 got = fread(mIn, 1, wanted, mFile);
+            // Unbounded streams just run until the end of the file
+            mRemaining = got < wanted ? 0 : mRemaining - got;
+            mStream.next_in = mIn;
+            mStream.avail_in = got;
+        }
+
+        u32 before = mStream.avail_out;
+        int r = BZ2_bzDecompress(&mStream);
+        if (r == BZ_STREAM_END)
+        {
+            mEof = true;
+            break;
+        }
+        // A stream that runs out of input without ending is truncated
+        if (r != BZ_OK || (mStream.avail_in == 0 && mRemaining == 0 && mStream.avail_out == before))
+        {
+            mGood = false;
+            break;
+        }
+    }
+    return size - mStream.avail_out;
+}
+
+bool DecompressStream::readAll(std::vector<u8>& out)
+{
+    while (mGood && !mEof)
+    {
+        if (out.size() == out.capacity())
+        {
+            out.reserve(out.size() + READALL_STEP);
+        }
+        size_t start = out.size();
+        out.resize(out.capacity());
+        out.resize(start + read(out.data() + start, out.size() - start));
+    }
+    return mGood;
+}
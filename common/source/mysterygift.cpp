@@ -24,129 +24,372 @@
 *         reasonable ways as different from the original version.
 */
 
-#include "mysterygift.hpp"
 
-static nlohmann::json mysteryGiftSheet;
-static u8* mysteryGiftData;
+#include "mysterygift.hpp"
+#include "DecompressStream.hpp"
 
-void MysteryGift::init(Generation g)
+namespace
 {
-    std::string path = StringUtils::format("romfs:/mg/sheet%s.json.bz2", genToCstring(g));
-    FILE* f = fopen(path.c_str(), "rb");
-    if (f != NULL)
+    // Same order as validTypes in EventsGalleryPacker
+    enum CardType : u8
     {
-        fseek(f, 0, SEEK_END);
-        size_t size = ftell(f);
-        unsigned int destLen = 700 * 1024; // big enough
-        char* s = new char[size];
-        char* d = new char[destLen]();
-        rewind(f);
-        fread(s, 1, size, f);
-        
-        int r = BZ2_bzBuffToBuffDecompress(d, &destLen, s, size, 0, 0);
-        if (r == BZ_OK)
+        TYPE_WC7,
+        TYPE_WC6,
+        TYPE_WC7FULL,
+        TYPE_WC6FULL,
+        TYPE_PGF,
+        TYPE_WC4,
+        TYPE_PGT
+    };
+    constexpr std::string_view cardTypes[] = {"wc7", "wc6", "wc7full", "wc6full", "pgf", "wc4", "pgt"};
+
+    // Same order as giftMatch::cards
+    constexpr Language matchLanguages[] = {Language::ZH, Language::TW, Language::EN, Language::FR, Language::DE, Language::IT, Language::JP, Language::KO, Language::ES};
+    constexpr std::string_view matchLanguageNames[] = {"CHS", "CHT", "ENG", "FRE", "GER", "ITA", "JPN", "KOR", "SPA"};
+
+    // Layout of romfs:/mg/gifts<gen>.bin, as written by EventsGalleryPacker: a header of six u32s (magic,
+    // version, card count, match count, chunk count, string pool size), then the cards, matches, chunks and
+    // string pool, then the bzip2-compressed chunks. Each card is entirely within one chunk, so showing one
+    // only ever decompresses a few kilobytes
+    constexpr u32 GIFTS_VERSION = 1;
+
+    struct Card
+    {
+        u32 name; // Offset into strings
+        u32 game; // Offset into strings
+        u32 offset; // Within its chunk
+        u16 chunk;
+        u16 size;
+        s16 species;
+        s8 form;
+        s8 gender;
+        u8 type;
+    };
+    static_assert(sizeof(Card) == 24, "Card must match the packed gift index");
+    static_assert(sizeof(MysteryGift::giftMatch) == 18, "giftMatch must match the packed gift index");
+
+    struct Chunk
+    {
+        u32 offset; // Within the file
+        u32 compressedSize;
+        u32 size;
+    };
+
+    Generation giftGen;
+    std::vector<Card> cards;
+    std::vector<MysteryGift::giftMatch> matches;
+    std::string strings;
+    std::vector<Chunk> chunks;
+    FILE* giftFile = nullptr;
+    // Decompressed contents of the last chunk used
+    std::vector<u8> chunkData;
+    int loadedChunk = -1;
+
+    int languageSlot(Language lang)
+    {
+        for (size_t i = 0; i < sizeof(matchLanguages) / sizeof(Language); i++)
         {
-            mysteryGiftSheet = nlohmann::json::parse(d);
+            if (matchLanguages[i] == lang)
+            {
+                return i;
+            }
         }
+        return -1;
+    }
 
-        delete[] s;
-        delete[] d;
+    template <typename T>
+    bool readAll(FILE* f, std::vector<T>& out, u32 count)
+    {
+        out.resize(count);
+        return fread(out.data(), sizeof(T), count, f) == count;
     }
 
-    if (mysteryGiftSheet.is_discarded())
+    // Everything the index refers to has to be in range, so that a truncated or stale file is caught here
+    // rather than read out of bounds later
+    bool validIndex(size_t fileSize)
     {
-        mysteryGiftSheet = nlohmann::json::object();
-        mysteryGiftSheet["gen"] = "BAD";
-        mysteryGiftSheet["matches"] = nlohmann::json::array();
+        for (const Chunk& chunk : chunks)
+        {
+            if (chunk.offset > fileSize || chunk.compressedSize > fileSize - chunk.offset)
+            {
+                return false;
+            }
+        }
+        for (const Card& card : cards)
+        {
+            if (card.name >= strings.size() || card.game >= strings.size() || card.chunk >= chunks.size() ||
+                card.offset > chunks[card.chunk].size || card.size > chunks[card.chunk].size - card.offset)
+            {
+                return false;
+            }
+        }
+        for (const MysteryGift::giftMatch& match : matches)
+        {
+            for (u16 card : match.cards)
+            {
+                if (card != MysteryGift::giftMatch::NO_CARD && card >= cards.size())
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
     }
 
-    path = StringUtils::format("romfs:/mg/data%s.bin.bz2", genToCstring(g));
-    f = fopen(path.c_str(), "rb");
-    if (f != NULL)
+    bool loadIndex(Generation g)
     {
+        std::string path = StringUtils::format("romfs:/mg/gifts%s.bin", genToCstring(g));
+        FILE* f = fopen(path.c_str(), "rb");
+        if (f == NULL)
+        {
+            return false;
+        }
+
         fseek(f, 0, SEEK_END);
-        u32 size = ftell(f);
-        unsigned int destLen = 800 * 1024;
-        char* s = new char[size];
-        mysteryGiftData = new u8[destLen]();
-        rewind(f);
-        fread(s, 1, size, f);
-        
-        int r = BZ2_bzBuffToBuffDecompress((char*)mysteryGiftData, &destLen, s, size, 0, 0);
-        if (r != BZ_OK)
+        size_t fileSize = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        // The counts are checked against the file's size before anything is allocated for them
+        u32 header[6];
+        if (fread(header, sizeof(u32), 6, f) != 6 || memcmp(header, "PKSG", 4) || header[1] != GIFTS_VERSION ||
+            (u64)header[2] * sizeof(Card) + (u64)header[3] * sizeof(MysteryGift::giftMatch) + (u64)header[4] * sizeof(Chunk) + header[5] >
+                fileSize - sizeof(header))
         {
-            // TODO
+            fclose(f);
+            return false;
+        }
+        strings.resize(header[5]);
+        if (!readAll(f, cards, header[2]) || !readAll(f, matches, header[3]) || !readAll(f, chunks, header[4]) ||
+            fread(strings.data(), 1, strings.size(), f) != strings.size() || strings.empty() || strings.back() != '\0' ||
+            !validIndex(fileSize))
+        {
+            fclose(f);
+            cards.clear();
+            matches.clear();
+            chunks.clear();
+            strings.clear();
+            return false;
         }
 
-        delete[] s;
+        giftFile = f;
+        return true;
     }
-}
 
-std::unique_ptr<WCX> MysteryGift::wondercard(size_t index)
-{
-    std::string gen = mysteryGiftSheet["gen"];
+    // Builds the same index from the sheet and data of the older, whole-file format
+    void loadSheet(Generation g)
+    {
+        nlohmann::json sheet;
+        {
+            std::vector<u8> text;
+            DecompressStream stream(StringUtils::format("romfs:/mg/sheet%s.json.bz2", genToCstring(g)));
+            if (stream.readAll(text))
+            {
+                sheet = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+            }
+        }
 
-    auto entry = mysteryGiftSheet["wondercards"][index];
+        if (!sheet.is_object() || !sheet["wondercards"].is_array() || !sheet["matches"].is_array())
+        {
+            return;
+        }
 
-    u32 offset = entry["offset"];
+        for (auto& entry : sheet["wondercards"])
+        {
+            Card card;
+            card.name = strings.size();
+            strings += entry.value("name", "");
+            strings += '\0';
+            card.game = strings.size();
+            strings += entry.value("game", "");
+            strings += '\0';
+            card.offset = entry.value("offset", 0);
+            card.chunk = 0;
+            card.size = entry.value("size", 0);
+            card.species = entry.value("species", -1);
+            card.form = entry.value("form", -1);
+            card.gender = entry.value("gender", -1);
+            std::string type = entry.value("type", "");
+            card.type = type.find("full") != std::string::npos ? TYPE_WC7FULL : TYPE_WC7;
+            for (size_t i = 0; i < sizeof(cardTypes) / sizeof(cardTypes[0]); i++)
+            {
+                if (cardTypes[i] == type)
+                {
+                    card.type = i;
+                }
+            }
+            cards.push_back(card);
+        }
 
-    if (gen == "4")
-    {
-        std::unique_ptr<WCX> wc = nullptr;
-        if (entry["type"] == "wc4")
+        for (auto& entry : sheet["matches"])
+        {
+            MysteryGift::giftMatch match;
+            for (size_t i = 0; i < match.cards.size(); i++)
+            {
+                auto found = entry.find(std::string(matchLanguageNames[i]));
+                if (found != entry.end() && found->is_number_unsigned())
+                {
+                    match.cards[i] = found->get<u16>();
+                }
+            }
+            matches.push_back(match);
+        }
+
+        DecompressStream stream(StringUtils::format("romfs:/mg/data%s.bin.bz2", genToCstring(g)));
+        if (stream.readAll(chunkData))
         {
-            wc = std::make_unique<WC4>(mysteryGiftData + offset);
+            chunks.push_back({0, 0, (u32)chunkData.size()});
+            // All of the data is one chunk, already in memory
+            loadedChunk = 0;
         }
         else
         {
-            wc = std::make_unique<PGT>(mysteryGiftData + offset);
+            chunkData = std::vector<u8>();
         }
-        return wc;
     }
-    else if (gen == "5")
+
+    u8* cardData(const Card& card)
     {
-        PGF *pgf = new PGF(mysteryGiftData + offset);
-        return std::unique_ptr<WCX>(pgf);
+        if (loadedChunk != card.chunk)
+        {
+            if (giftFile == NULL || card.chunk >= chunks.size())
+            {
+                return nullptr;
+            }
+            const Chunk& chunk = chunks[card.chunk];
+            chunkData.resize(chunk.size);
+            loadedChunk = -1;
+            if (fseek(giftFile, chunk.offset, SEEK_SET) != 0)
+            {
+                return nullptr;
+            }
+            DecompressStream stream(giftFile, chunk.compressedSize);
+            if (stream.read(chunkData.data(), chunk.size) != chunk.size)
+            {
+                return nullptr;
+            }
+            loadedChunk = card.chunk;
+        }
+        if (card.offset + card.size > chunkData.size())
+        {
+            return nullptr;
+        }
+        return chunkData.data() + card.offset;
     }
-    else if (gen == "6")
+}
+
+bool MysteryGift::giftMatch::has(Language lang) const
+{
+    int slot = languageSlot(lang);
+    return slot != -1 && cards[slot] != NO_CARD;
+}
+
+Language MysteryGift::giftMatch::language(Language preferred) const
+{
+    // Languages gifts never come in (NL, PT, RU) get the English card, like i18n::langString maps them
+    if (languageSlot(preferred) == -1)
     {
-        WC6 *wc6 = new WC6(mysteryGiftData + offset, entry["type"].get<std::string>().find("full") != std::string::npos);
-        return std::unique_ptr<WCX>(wc6);
+        preferred = Language::EN;
     }
-    else if (gen == "7")
+    if (has(preferred))
     {
-        WC7 *wc7 = new WC7(mysteryGiftData + offset, entry["type"].get<std::string>().find("full") != std::string::npos);
-        return std::unique_ptr<WCX>(wc7);
+        return preferred;
     }
-    else if (gen == "LGPE")
+    for (size_t i = 0; i < cards.size(); i++)
     {
-        WB7 *wb7 = new WB7(mysteryGiftData + offset, entry["type"].get<std::string>().find("full") != std::string::npos);
-        return std::unique_ptr<WCX>(wb7);
+        if (cards[i] != NO_CARD)
+        {
+            return matchLanguages[i];
+        }
     }
-    else
+    return preferred;
+}
+
+size_t MysteryGift::giftMatch::card(Language lang) const
+{
+    int slot = languageSlot(language(lang));
+    return slot == -1 ? NO_CARD : cards[slot];
+}
+
+void MysteryGift::init(Generation g)
+{
+    giftGen = g;
+    if (!loadIndex(g))
+    {
+        loadSheet(g);
+    }
+}
+
+std::unique_ptr<WCX> MysteryGift::wondercard(size_t index)
+{
+    if (index >= cards.size())
     {
         return nullptr;
     }
+
+    const Card& card = cards[index];
+    u8* data = cardData(card);
+    if (data == nullptr)
+    {
+        return nullptr;
+    }
+
+    bool full = card.type == TYPE_WC7FULL || card.type == TYPE_WC6FULL;
+    switch (giftGen)
+    {
+        case Generation::FOUR:
+            if (card.type == TYPE_WC4)
+            {
+                return std::make_unique<WC4>(data);
+            }
+            return std::make_unique<PGT>(data);
+        case Generation::FIVE:
+            return std::make_unique<PGF>(data);
+        case Generation::SIX:
+            return std::make_unique<WC6>(data, full);
+        case Generation::SEVEN:
+            return std::make_unique<WC7>(data, full);
+        case Generation::LGPE:
+            return std::make_unique<WB7>(data, full);
+        default:
+            return nullptr;
+    }
 }
 
 void MysteryGift::exit(void)
 {
-    delete[] mysteryGiftData;
-    mysteryGiftSheet.clear();
+    if (giftFile != NULL)
+    {
+        fclose(giftFile);
+        giftFile = nullptr;
+    }
+    cards.clear();
+    matches.clear();
+    strings.clear();
+    chunks.clear();
+    chunkData = std::vector<u8>();
+    loadedChunk = -1;
 }
 
-std::vector<nlohmann::json> MysteryGift::wondercards()
+const std::vector<MysteryGift::giftMatch>& MysteryGift::wondercards()
 {
-    return mysteryGiftSheet["matches"];
+    return matches;
 }
 
 MysteryGift::giftData MysteryGift::wondercardInfo(size_t index)
 {
     giftData ret;
-    nlohmann::json entry = mysteryGiftSheet["wondercards"][index];
-    ret.name = entry["name"].get<std::string>();
-    ret.game = entry["game"].get<std::string>();
-    ret.form = entry["form"];
-    ret.species = entry["species"];
+    if (index >= cards.size())
+    {
+        ret.species = -1;
+        ret.form = -1;
+        ret.gender = -1;
+        return ret;
+    }
+    const Card& card = cards[index];
+    ret.name = strings.c_str() + card.name;
+    ret.game = strings.c_str() + card.game;
+    ret.species = card.species;
+    ret.form = card.form;
+    ret.gender = card.gender;
     return ret;
 }
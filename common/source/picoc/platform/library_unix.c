@@ -24,9 +24,11 @@ struct LibraryFunction UnixFunctions[] =
     { party_get_pkx,    "void party_get_pkx(char* data, int slot);" },
     { party_inject_pkx, "void party_inject_pkx(char* data, enum Generation type, int slot);" },
     { bank_inject_pkx,  "void bank_inject_pkx(char* data, enum Generation type, int box, int slot);" },
+    { query_pkx,        "int query_pkx(char* filter, enum Source source, int* results, int maxResults);" },
     // pkm
     { pkx_encrypt,      "void pkx_decrypt(char* data, enum Generation type);" },
     { pkx_decrypt,      "void pkx_encrypt(char* data, enum Generation type);" },
+    { pkx_generate_pids,"void pkx_generate_pids(unsigned int* out, int count, int species, int gender, int originGame, int nature, int form, int abilityNum, enum Shininess shiny, int tid, int sid, enum Generation type);" },
     // io
     { current_directory,"char* current_directory();" },
     { read_directory,   "struct directory* read_directory(char* dir);" },
@@ -53,5 +55,5 @@ struct LibraryFunction UnixFunctions[] =
 
 void PlatformLibraryInit(Picoc *pc)
 {
-    IncludeRegister(pc, "pksm.h", &UnixSetupFunc, &UnixFunctions[0], "struct pkx { int species; int form; }; enum Generation { GEN_FOUR, GEN_FIVE, GEN_SIX, GEN_SEVEN, GEN_LGPE }; struct directory { int count; char** files; };");
+    IncludeRegister(pc, "pksm.h", &UnixSetupFunc, &UnixFunctions[0], "struct pkx { int species; int form; }; enum Generation { GEN_FOUR, GEN_FIVE, GEN_SIX, GEN_SEVEN, GEN_LGPE }; enum Source { SOURCE_SAVE, SOURCE_BANK, SOURCE_ALL_BANKS }; enum Shininess { SHINY_ANY, SHINY_ALWAYS, SHINY_NEVER }; struct directory { int count; char** files; };");
 }
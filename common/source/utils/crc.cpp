@@ -0,0 +1,125 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "crc.hpp"
+
+namespace
+{
+    // Below this size the 4 KB of slice tables costs more in cache misses than it saves
+    constexpr u32 SLICE_THRESHOLD = 64;
+
+    struct CCITTTables
+    {
+        u16 t[8][256];
+
+        constexpr CCITTTables() : t()
+        {
+            for (u32 i = 0; i < 256; i++)
+            {
+                u16 crc = i << 8;
+                for (u32 j = 0; j < 8; j++)
+                {
+                    crc = (crc & 0x8000) ? (u16)((crc << 1) ^ 0x1021) : (u16)(crc << 1);
+                }
+                t[0][i] = crc;
+            }
+            // t[k][i] is the contribution of byte i followed by k zero bytes
+            for (u32 k = 1; k < 8; k++)
+            {
+                for (u32 i = 0; i < 256; i++)
+                {
+                    t[k][i] = (u16)(t[k - 1][i] << 8) ^ t[0][t[k - 1][i] >> 8];
+                }
+            }
+        }
+    };
+
+    constexpr CCITTTables tables;
+
+    u16 ccittBitwise(const u8* buf, u32 len, u16 crc)
+    {
+        for (u32 i = 0; i < len; i++)
+        {
+            crc ^= (u16)(buf[i] << 8);
+            for (u32 j = 0; j < 0x8; j++)
+            {
+                if ((crc & 0x8000) > 0)
+                    crc = (u16)((crc << 1) ^ 0x1021);
+                else
+                    crc <<= 1;
+            }
+        }
+        return crc;
+    }
+
+    u16 ccittTable(const u8* buf, u32 len, u16 crc)
+    {
+        for (u32 i = 0; i < len; i++)
+        {
+            crc = (u16)(crc << 8) ^ tables.t[0][(crc >> 8) ^ buf[i]];
+        }
+        return crc;
+    }
+
+    u16 ccittSliceBy8(const u8* buf, u32 len, u16 crc)
+    {
+        while (len >= 8)
+        {
+            crc = tables.t[7][buf[0] ^ (crc >> 8)] ^ tables.t[6][buf[1] ^ (crc & 0xFF)] ^
+                  tables.t[5][buf[2]] ^ tables.t[4][buf[3]] ^
+                  tables.t[3][buf[4]] ^ tables.t[2][buf[5]] ^
+                  tables.t[1][buf[6]] ^ tables.t[0][buf[7]];
+            buf += 8;
+            len -= 8;
+        }
+        return ccittTable(buf, len, crc);
+    }
+}
+
+CRC::Kernel CRC::kernelFor(u32 len)
+{
+    return len >= SLICE_THRESHOLD ? Kernel::SliceBy8 : Kernel::Table;
+}
+
+u16 CRC::ccitt16(const u8* buf, u32 len, u16 crc)
+{
+    return ccitt16(kernelFor(len), buf, len, crc);
+}
+
+u16 CRC::ccitt16(Kernel kernel, const u8* buf, u32 len, u16 crc)
+{
+    switch (kernel)
+    {
+        case Kernel::Bitwise:
+            return ccittBitwise(buf, len, crc);
+        case Kernel::Table:
+            return ccittTable(buf, len, crc);
+        case Kernel::SliceBy8:
+        default:
+            return ccittSliceBy8(buf, len, crc);
+    }
+}
@@ -0,0 +1,199 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "searchindex.hpp"
+#include <algorithm>
+
+namespace
+{
+    // U+00E0 to U+00FF without their accents; 0 where there's no plain ASCII letter to fall back to
+    constexpr char unaccented[] = "aaaaaa\0ceeeeiiii\0nooooo\0ouuuuy\0y";
+    static_assert(sizeof(unaccented) == 0x20 + 1, "one entry per codepoint from U+00E0 to U+00FF");
+
+    u32 trigram(const std::string& str, size_t i)
+    {
+        return (u8)str[i] | (u8)str[i + 1] << 8 | (u8)str[i + 2] << 16;
+    }
+}
+
+std::string SearchIndex::fold(std::string_view str, bool ignoreAccents)
+{
+    std::string ret;
+    ret.reserve(str.size());
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        u8 c = str[i];
+        if (c >= 'A' && c <= 'Z')
+        {
+            ret += c + ('a' - 'A');
+        }
+        // Latin-1 Supplement letters, U+00C0 to U+00FF
+        else if (c == 0xC3 && i + 1 < str.size())
+        {
+            u8 codepoint = 0xC0 | (str[++i] & 0x3F);
+            if (codepoint <= 0xDE && codepoint != 0xD7)
+            {
+                codepoint += 0x20;
+            }
+            if (ignoreAccents && codepoint >= 0xE0 && unaccented[codepoint - 0xE0])
+            {
+                ret += unaccented[codepoint - 0xE0];
+            }
+            else
+            {
+                ret += (char)0xC3;
+                ret += 0x80 | (codepoint & 0x3F);
+            }
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+    return ret;
+}
+
+SearchIndex::SearchIndex(const std::vector<std::string_view>& names, bool ignoreAccents) : ignoreAccents(ignoreAccents)
+{
+    keys.reserve(names.size());
+    for (std::string_view name : names)
+    {
+        keys.push_back(fold(name, ignoreAccents));
+    }
+    sorted.resize(keys.size());
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        sorted[i] = i;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [this](u32 a, u32 b) { return keys[a] < keys[b]; });
+}
+
+const std::unordered_map<u32, std::vector<u32>>& SearchIndex::trigrams() const
+{
+    if (!trigramsBuilt)
+    {
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            for (size_t j = 0; j + 2 < keys[i].size(); j++)
+            {
+                std::vector<u32>& postings = trigramPostings[trigram(keys[i], j)];
+                if (postings.empty() || postings.back() != i)
+                {
+                    postings.push_back(i);
+                }
+            }
+        }
+        trigramsBuilt = true;
+    }
+    return trigramPostings;
+}
+
+const std::vector<size_t>& SearchIndex::Search::find(std::string_view search, bool substring)
+{
+    std::string folded = SearchIndex::fold(search, index->ignoreAccents);
+    if (substring)
+    {
+        findSubstring(folded);
+    }
+    else
+    {
+        findPrefix(folded);
+    }
+    lastSearch    = std::move(folded);
+    lastSubstring = substring;
+    hasLast       = true;
+    return results;
+}
+
+void SearchIndex::Search::findPrefix(const std::string& search)
+{
+    const std::vector<std::string>& keys = index->keys;
+    const std::vector<u32>& sorted       = index->sorted;
+
+    // Names starting with search are a subrange of those starting with any prefix of it
+    if (!hasLast || lastSubstring || search.compare(0, lastSearch.size(), lastSearch) != 0)
+    {
+        lo = 0;
+        hi = sorted.size();
+    }
+    auto begin = std::lower_bound(sorted.begin() + lo, sorted.begin() + hi, search,
+        [&keys](u32 i, const std::string& value) { return keys[i] < value; });
+    auto end = std::partition_point(begin, sorted.begin() + hi,
+        [&keys, &search](u32 i) { return keys[i].compare(0, search.size(), search) == 0; });
+    lo = begin - sorted.begin();
+    hi = end - sorted.begin();
+
+    results.assign(begin, end);
+    std::sort(results.begin(), results.end());
+}
+
+void SearchIndex::Search::findSubstring(const std::string& search)
+{
+    const std::vector<std::string>& keys = index->keys;
+    std::vector<size_t> candidates;
+    if (hasLast && lastSubstring && search.find(lastSearch) != std::string::npos)
+    {
+        candidates = std::move(results);
+    }
+    else if (search.size() >= 3)
+    {
+        const std::unordered_map<u32, std::vector<u32>>& trigrams = index->trigrams();
+        // Any trigram of search narrows things down; the rarest narrows them the most
+        const std::vector<u32>* rarest = nullptr;
+        for (size_t j = 0; j + 2 < search.size(); j++)
+        {
+            auto found = trigrams.find(trigram(search, j));
+            if (found == trigrams.end())
+            {
+                results.clear();
+                return;
+            }
+            if (!rarest || found->second.size() < rarest->size())
+            {
+                rarest = &found->second;
+            }
+        }
+        candidates.assign(rarest->begin(), rarest->end());
+    }
+    else
+    {
+        candidates.resize(keys.size());
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            candidates[i] = i;
+        }
+    }
+
+    results.clear();
+    for (size_t i : candidates)
+    {
+        if (keys[i].find(search) != std::string::npos)
+        {
+            results.push_back(i);
+        }
+    }
+}
@@ -0,0 +1,203 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#include "slab.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    constexpr size_t GRANULARITY = 32;
+    constexpr size_t CLASSES = Slab::MAX_SIZE / GRANULARITY;
+    constexpr size_t CHUNK_SIZE = 8 * 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Cache
+    {
+        FreeBlock* free[CLASSES] = {};
+        // Blocks of this cache's chunks that other threads freed, of any size class
+        std::atomic<FreeBlock*> remote{nullptr};
+        Cache* nextOrphan = nullptr;
+    };
+
+    // Chunks are CHUNK_SIZE aligned and start with this, so any block leads back to its owner
+    struct Chunk
+    {
+        Cache* owner;
+        size_t cls;
+    };
+    static_assert(sizeof(Chunk) <= GRANULARITY, "Chunk header must fit in the first block");
+
+    // Caches outlive their threads: an exiting thread leaves its cache here, free lists and all, and the
+    // next thread to allocate adopts it along with whatever other threads handed back in the meantime
+    Cache* orphans = nullptr;
+    // Only taken when a thread starts or stops allocating. A mutex rather than a spinlock, as a spinning
+    // thread would never let a lower priority holder on the same core run
+    std::mutex orphanLock;
+
+    struct ThreadCache
+    {
+        Cache* cache = nullptr;
+
+        ~ThreadCache()
+        {
+            if (cache)
+            {
+                std::lock_guard<std::mutex> lock(orphanLock);
+                cache->nextOrphan = orphans;
+                orphans = cache;
+            }
+        }
+
+        Cache* get(void)
+        {
+            if (!cache)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(orphanLock);
+                    if (orphans)
+                    {
+                        cache = orphans;
+                        orphans = cache->nextOrphan;
+                    }
+                }
+                if (!cache)
+                {
+                    cache = new Cache;
+                }
+            }
+            return cache;
+        }
+    };
+
+    thread_local ThreadCache threadCache;
+
+    std::atomic<size_t> live{0};
+    std::atomic<size_t> peak{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> reserved{0};
+
+    size_t sizeClass(size_t size) { return (size + GRANULARITY - 1) / GRANULARITY - 1; }
+
+    Chunk* chunkOf(void* block) { return (Chunk*)((uintptr_t)block & ~(uintptr_t)(CHUNK_SIZE - 1)); }
+
+    void refill(Cache* cache, size_t cls)
+    {
+        // Take back what other threads freed before carving out a new chunk
+        FreeBlock* block = cache->remote.exchange(nullptr, std::memory_order_acquire);
+        while (block)
+        {
+            FreeBlock* next = block->next;
+            size_t blockCls = chunkOf(block)->cls;
+            block->next = cache->free[blockCls];
+            cache->free[blockCls] = block;
+            block = next;
+        }
+        if (cache->free[cls])
+        {
+            return;
+        }
+
+        size_t blockSize = (cls + 1) * GRANULARITY;
+        u8* chunk = (u8*)::operator new(CHUNK_SIZE, std::align_val_t(CHUNK_SIZE));
+        reserved += CHUNK_SIZE;
+        *(Chunk*)chunk = {cache, cls};
+        for (size_t i = GRANULARITY; i + blockSize <= CHUNK_SIZE; i += blockSize)
+        {
+            block = (FreeBlock*)(chunk + i);
+            block->next = cache->free[cls];
+            cache->free[cls] = block;
+        }
+    }
+
+    void count(size_t size)
+    {
+        allocations++;
+        size_t now = live += size;
+        size_t prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now));
+    }
+}
+
+void* Slab::allocate(size_t size)
+{
+    count(size);
+    if (size == 0 || size > MAX_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    Cache* cache = threadCache.get();
+    size_t cls = sizeClass(size);
+    if (!cache->free[cls])
+    {
+        refill(cache, cls);
+    }
+    FreeBlock* block = cache->free[cls];
+    cache->free[cls] = block->next;
+    return block;
+}
+
+void Slab::deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    live -= size;
+    if (size == 0 || size > MAX_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = (FreeBlock*)ptr;
+    Chunk* chunk = chunkOf(block);
+    if (chunk->owner == threadCache.cache)
+    {
+        block->next = chunk->owner->free[chunk->cls];
+        chunk->owner->free[chunk->cls] = block;
+    }
+    else
+    {
+        FreeBlock* head = chunk->owner->remote.load(std::memory_order_relaxed);
+        do
+        {
+            block->next = head;
+        } while (!chunk->owner->remote.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+}
+
+Slab::Stats Slab::stats(void)
+{
+    return { live.load(), peak.load(), allocations.load(), reserved.load() };
+}
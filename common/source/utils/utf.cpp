@@ -0,0 +1,201 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "utils.hpp"
+#include <algorithm>
+#include <string.h>
+
+// Save data is little-endian UTF-16 and read in place, so this only works on little-endian hosts
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "UTF-16 strings are read straight out of little-endian saves");
+
+namespace
+{
+    constexpr u64 LANES16 = 0x0001000100010001ull;
+
+    // Whether any 16-bit lane of w is zero
+    constexpr bool hasZero16(u64 w)
+    {
+        return (w - LANES16) & ~w & (LANES16 << 15);
+    }
+
+    // Appends the UTF-8 form of up to len units of src, stopping at term. Runs of ASCII are
+    // converted four at a time; the 3DS has no NEON, so this works on plain 64-bit words
+    void utf16ToUTF8(const char16_t* src, size_t len, char16_t term, std::string& out)
+    {
+        size_t start = out.size();
+        out.resize(start + len * 3);
+        char* dst = &out[start];
+        const u64 termLanes = LANES16 * term;
+        size_t i = 0;
+        while (i < len)
+        {
+            if (i + 4 <= len)
+            {
+                u64 w;
+                memcpy(&w, src + i, sizeof(w));
+                // Zeros are dropped instead of copied when they aren't the terminator, so they can't take this path
+                if (!(w & (LANES16 * 0xFF80)) && !hasZero16(w) && !hasZero16(w ^ termLanes))
+                {
+                    u32 packed = (w & 0xFF) | ((w >> 8) & 0xFF00) | ((w >> 16) & 0xFF0000) | ((w >> 24) & 0xFF000000);
+                    memcpy(dst, &packed, sizeof(packed));
+                    dst += 4;
+                    i += 4;
+                    continue;
+                }
+            }
+
+            char16_t codepoint = src[i++];
+            if (codepoint == term)
+            {
+                break;
+            }
+            else if (codepoint == 0)
+            {
+                continue;
+            }
+            else if (codepoint < 0x0080)
+            {
+                *dst++ = codepoint;
+            }
+            else if (codepoint < 0x0800)
+            {
+                *dst++ = 0xC0 | (codepoint >> 6);
+                *dst++ = 0x80 | (codepoint & 0x3F);
+            }
+            else
+            {
+                *dst++ = 0xE0 | (codepoint >> 12);
+                *dst++ = 0x80 | ((codepoint >> 6) & 0x3F);
+                *dst++ = 0x80 | (codepoint & 0x3F);
+            }
+        }
+        out.resize(dst - out.data());
+    }
+
+    // Writes at most max units of the UTF-16 form of src to dst and returns how many were written.
+    // Anything outside the BMP or malformed becomes U+FFFD. Runs of ASCII are widened eight at a time
+    size_t utf8ToUTF16(std::string_view src, char16_t* dst, size_t max)
+    {
+        const char* in = src.data();
+        const char* end = in + src.size();
+        size_t written = 0;
+        while (in < end && written < max)
+        {
+            if (end - in >= 8 && max - written >= 8)
+            {
+                u64 w;
+                memcpy(&w, in, sizeof(w));
+                if (!(w & 0x8080808080808080ull))
+                {
+                    for (u64 half : {w & 0xFFFFFFFF, w >> 32})
+                    {
+                        half = (half | half << 16) & 0x0000FFFF0000FFFFull;
+                        half = (half | half << 8) & 0x00FF00FF00FF00FFull;
+                        memcpy(dst + written, &half, sizeof(half));
+                        written += 4;
+                    }
+                    in += 8;
+                    continue;
+                }
+            }
+
+            u8 lead = *in;
+            char16_t codepoint = 0xFFFD;
+            if (lead < 0x80)
+            {
+                codepoint = lead;
+                in += 1;
+            }
+            else if ((lead & 0xE0) == 0xC0 && end - in >= 2)
+            {
+                codepoint = (lead & 0x1F) << 6 | (in[1] & 0x3F);
+                in += 2;
+            }
+            else if ((lead & 0xF0) == 0xE0 && end - in >= 3)
+            {
+                codepoint = (lead & 0x0F) << 12 | (in[1] & 0x3F) << 6 | (in[2] & 0x3F);
+                in += 3;
+            }
+            else if ((lead & 0xF8) == 0xF0 && end - in >= 4)
+            {
+                in += 4;
+            }
+            else
+            {
+                in += 1;
+            }
+            dst[written++] = codepoint;
+        }
+        return written;
+    }
+}
+
+std::u16string StringUtils::UTF8toUTF16(std::string_view src)
+{
+    // Never more units than bytes
+    std::u16string ret(src.size(), u'\0');
+    ret.resize(utf8ToUTF16(src, ret.data(), ret.size()));
+    return ret;
+}
+
+std::string StringUtils::UTF16toUTF8(std::u16string_view src)
+{
+    std::string ret;
+    // Stops at the first NUL unit, as the conversion always has
+    utf16ToUTF8(src.data(), src.size(), 0, ret);
+    return ret;
+}
+
+std::string StringUtils::getString(const u8* data, int ofs, int len, char16_t term)
+{
+    std::string ret;
+    utf16ToUTF8((const char16_t*)(data + ofs), len, term, ret);
+    return ret;
+}
+
+std::u16string_view StringUtils::getStringView(const u8* data, int ofs, int len, char16_t term)
+{
+    const char16_t* str = (const char16_t*)(data + ofs);
+    return std::u16string_view(str, std::find(str, str + len, term) - str);
+}
+
+void StringUtils::setString(u8* data, std::u16string_view v, int ofs, int len, char16_t terminator, char16_t padding)
+{
+    char16_t* dst = (char16_t*)(data + ofs);
+    size_t i = std::min((size_t)len - 1, v.size()); // len includes terminator
+    memcpy(dst, v.data(), i * sizeof(char16_t));
+    dst[i++] = terminator;
+    std::fill(dst + i, dst + len, padding);
+}
+
+void StringUtils::setString(u8* data, std::string_view v, int ofs, int len, char16_t terminator, char16_t padding)
+{
+    char16_t* dst = (char16_t*)(data + ofs);
+    size_t i = utf8ToUTF16(v, dst, len - 1); // len includes terminator
+    dst[i++] = terminator;
+    std::fill(dst + i, dst + len, padding);
+}
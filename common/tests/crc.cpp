@@ -0,0 +1,149 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check that every CRC kernel agrees with the bitwise loop Sav::ccitt16 used before, on the block
+// sizes the saves actually checksum, and how fast each one gets through them
+#include "crc.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Block
+    {
+        const char* name;
+        u32 length;
+    };
+
+    // A spread of real checksummed regions, from the Gen 6 block lengths up to the Gen 4 partitions
+    constexpr Block blocks[] = {
+        {"XY 0x04", 0x00004},
+        {"XY 0x2C", 0x0002C},
+        {"Gen 5 0x8C", 0x0008C},
+        {"XY 0x2C8", 0x002C8},
+        {"BW box", 0x00FF0},
+        {"XY 0x4E28", 0x04E28},
+        {"DP general", 0x0C0EC},
+        {"HGSS storage", 0x12300},
+        {"XY boxes", 0x34AD0},
+    };
+
+    constexpr CRC::Kernel kernels[]   = {CRC::Kernel::Bitwise, CRC::Kernel::Table, CRC::Kernel::SliceBy8};
+    constexpr const char* kernelNames[] = {"bitwise", "table", "slice-by-8"};
+}
+
+int main()
+{
+    int failures = 0;
+
+    // CRC-16/CCITT-FALSE check value
+    const u8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    for (size_t k = 0; k < 3; k++)
+    {
+        if (CRC::ccitt16(kernels[k], check, sizeof(check)) != 0x29B1)
+        {
+            std::printf("%s gets the check value wrong\n", kernelNames[k]);
+            failures++;
+        }
+    }
+
+    std::mt19937 rng(0x504B534D);
+    std::vector<u8> data(0x34AD0 + 8);
+    for (auto& b : data)
+    {
+        b = rng();
+    }
+
+    // Every real size, from every alignment, whole and continued across a split
+    for (const auto& block : blocks)
+    {
+        for (u32 start = 0; start < 8; start++)
+        {
+            const u8* buf = data.data() + start;
+            u16 expected  = CRC::ccitt16(CRC::Kernel::Bitwise, buf, block.length);
+            u32 split     = rng() % (block.length + 1);
+            for (size_t k = 0; k < 3; k++)
+            {
+                if (CRC::ccitt16(kernels[k], buf, block.length) != expected)
+                {
+                    std::printf("%s differs on %s at offset %u\n", kernelNames[k], block.name, start);
+                    failures++;
+                }
+                u16 head = CRC::ccitt16(kernels[k], buf, split);
+                if (CRC::ccitt16(kernels[k], buf + split, block.length - split, head) != expected)
+                {
+                    std::printf("%s differs on %s split at 0x%X\n", kernelNames[k], block.name, split);
+                    failures++;
+                }
+            }
+            if (CRC::ccitt16(buf, block.length) != expected)
+            {
+                std::printf("the default kernel differs on %s\n", block.name);
+                failures++;
+            }
+        }
+    }
+
+    // Every length up to a few slices past the threshold, where the kernels hand over to each other
+    for (u32 len = 0; len < 256; len++)
+    {
+        u16 expected = CRC::ccitt16(CRC::Kernel::Bitwise, data.data(), len);
+        for (size_t k = 1; k < 3; k++)
+        {
+            if (CRC::ccitt16(kernels[k], data.data(), len) != expected)
+            {
+                std::printf("%s differs on %u bytes\n", kernelNames[k], len);
+                failures++;
+            }
+        }
+    }
+
+    // Throughput of each kernel over each block size, about 8 MB apiece
+    u32 sink = 0;
+    for (const auto& block : blocks)
+    {
+        u32 rounds = (8u << 20) / block.length;
+        std::printf("crc: %-12s", block.name);
+        for (size_t k = 0; k < 3; k++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < rounds; i++)
+            {
+                sink += CRC::ccitt16(kernels[k], data.data(), block.length);
+            }
+            auto end = std::chrono::steady_clock::now();
+            std::printf(" %s %7.1f MB/s", kernelNames[k],
+                (double)rounds * block.length / (1 << 20) / std::chrono::duration<double>(end - start).count());
+        }
+        std::printf("\n");
+    }
+    std::printf("crc: (%u)\n", sink);
+
+    std::printf("crc: %d failures\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,247 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for Crypt::cryptBoxes against the per-slot PKX round trip Sav*::cryptBoxData used before,
+// which is kept here as the reference, and a count of the heap allocations each of them makes
+#include "Crypt.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+    size_t allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+    allocations++;
+    if (void* ret = std::malloc(size))
+    {
+        return ret;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    struct Format
+    {
+        const char* name;
+        Generation gen;
+        u32 boxLength;
+        u32 stride;
+    };
+
+    constexpr Format formats[] = {
+        {"Gen 4", Generation::FOUR, 136, 136},
+        {"Gen 5 party", Generation::FIVE, 136, 220},
+        {"Gen 6", Generation::SIX, 232, 232},
+        {"Gen 7 party", Generation::SEVEN, 232, 260},
+        {"LGPE", Generation::LGPE, 232, 260},
+    };
+
+    // PK7 before cryptBoxes: an object and a copy of the entry on the heap, a crypt() that steps the LCG
+    // once per half-word, and a shuffleArray() that copies the whole entry first
+    class ReferencePKX
+    {
+    public:
+        ReferencePKX(const u8* dt, const Format& format, bool ekx) : format(format), data(new u8[format.stride])
+        {
+            std::copy(dt, dt + format.stride, data);
+            if (ekx)
+            {
+                u8 sv = (*(u32*)data >> 13) & 31;
+                crypt();
+                shuffleArray(sv);
+            }
+        }
+        ~ReferencePKX() { delete[] data; }
+
+        void encrypt()
+        {
+            u8 sv = (*(u32*)data >> 13) & 31;
+            u16 chk = 0;
+            for (u32 i = 8; i < format.boxLength; i += 2)
+            {
+                chk += *(u16*)(data + i);
+            }
+            *(u16*)(data + 6) = chk;
+            shuffleArray(Crypt::blockPositionInvert(sv));
+            crypt();
+        }
+
+        const Format& format;
+        u8* data;
+
+    private:
+        void crypt()
+        {
+            bool checksumSeed = format.gen == Generation::FOUR || format.gen == Generation::FIVE;
+            u32 seed = checksumSeed ? *(u16*)(data + 6) : *(u32*)data;
+            for (u32 i = 8; i < format.boxLength; i += 2)
+            {
+                seed = Crypt::seedStep(seed);
+                *(u16*)(data + i) ^= seed >> 16;
+            }
+            seed = *(u32*)data;
+            for (u32 i = format.boxLength; i < format.stride; i += 2)
+            {
+                seed = Crypt::seedStep(seed);
+                *(u16*)(data + i) ^= seed >> 16;
+            }
+        }
+
+        void shuffleArray(u8 sv)
+        {
+            u32 blockLength = (format.boxLength - 8) / 4;
+            u8 cdata[260];
+            std::copy(data, data + format.stride, cdata);
+            for (u8 block = 0; block < 4; block++)
+            {
+                u8 ofs = Crypt::blockPosition(sv * 4 + block);
+                std::copy(cdata + 8 + blockLength * ofs, cdata + 8 + blockLength * (ofs + 1), data + 8 + blockLength * block);
+            }
+        }
+    };
+
+    // Sav7::cryptBoxData before cryptBoxes: pkm(box, slot, crypted) built a shared PKX from a stack copy
+    // of the slot, and pkm(pk, box, slot) copied it back
+    void referenceCryptBoxes(const Format& format, u8* base, size_t count, bool decrypt)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            u8 buf[260];
+            std::copy(base + i * format.stride, base + (i + 1) * format.stride, buf);
+            std::shared_ptr<ReferencePKX> pkm = std::make_unique<ReferencePKX>(buf, format, decrypt);
+            if (!decrypt)
+            {
+                pkm->encrypt();
+            }
+            std::copy(pkm->data, pkm->data + format.stride, base + i * format.stride);
+        }
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    std::mt19937 rng(0x504B534D);
+
+    // Random decrypted entries of every format, encrypted and decrypted both ways
+    for (const auto& format : formats)
+    {
+        constexpr size_t COUNT = 300;
+        std::vector<u8> plain(COUNT * format.stride);
+        for (auto& b : plain)
+        {
+            b = rng();
+        }
+
+        std::vector<u8> expected = plain, actual = plain;
+        referenceCryptBoxes(format, expected.data(), COUNT, false);
+        Crypt::cryptBoxes(format.gen, actual.data(), COUNT, format.stride, false);
+        if (actual != expected)
+        {
+            std::printf("encrypting %s differs\n", format.name);
+            failures++;
+        }
+
+        referenceCryptBoxes(format, expected.data(), COUNT, true);
+        Crypt::cryptBoxes(format.gen, actual.data(), COUNT, format.stride, true);
+        if (actual != expected)
+        {
+            std::printf("decrypting %s differs\n", format.name);
+            failures++;
+        }
+        // Everything but the checksum, which encrypting refreshed, comes back unchanged
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            std::copy(plain.begin() + i * format.stride + 6, plain.begin() + i * format.stride + 8,
+                actual.begin() + i * format.stride + 6);
+        }
+        if (actual != plain)
+        {
+            std::printf("%s doesn't round trip\n", format.name);
+            failures++;
+        }
+    }
+
+    // A USUM save's 32 boxes, as on load and on save
+    constexpr size_t SLOTS = 32 * 30;
+    constexpr int ROUNDS   = 20;
+    const Format& usum     = formats[2];
+    std::vector<u8> boxes(SLOTS * 232);
+    for (auto& b : boxes)
+    {
+        b = rng();
+    }
+    Crypt::cryptBoxes(Generation::SEVEN, boxes.data(), SLOTS, 232, false);
+
+    size_t before    = allocations;
+    auto start       = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        referenceCryptBoxes(usum, boxes.data(), SLOTS, true);
+        referenceCryptBoxes(usum, boxes.data(), SLOTS, false);
+    }
+    auto middle      = std::chrono::steady_clock::now();
+    size_t reference = allocations - before;
+    before           = allocations;
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        Crypt::cryptBoxes(Generation::SEVEN, boxes.data(), SLOTS, 232, true);
+        Crypt::cryptBoxes(Generation::SEVEN, boxes.data(), SLOTS, 232, false);
+    }
+    auto end       = std::chrono::steady_clock::now();
+    size_t current = allocations - before;
+    if (current != 0)
+    {
+        std::printf("cryptBoxes allocated %zu times\n", current);
+        failures++;
+    }
+    std::printf("crypt: decrypting and encrypting %zu slots took %.0f us and %zu allocations, %.0f us and %zu before\n",
+        SLOTS, std::chrono::duration<double, std::micro>(end - middle).count() / ROUNDS, current / ROUNDS,
+        std::chrono::duration<double, std::micro>(middle - start).count() / ROUNDS, reference / ROUNDS);
+
+    std::printf("crypt: %d failures\n", failures);
+    return failures != 0;
+}
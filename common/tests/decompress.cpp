@@ -0,0 +1,182 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for DecompressStream over whole files, regions of an open file, and inputs that are cut
+// short or aren't there at all
+#include "DecompressStream.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (!ok)
+        {
+            std::printf("%s\n", what);
+            failures++;
+        }
+    }
+
+    // Compressible but not trivially so, like the gift sheets
+    std::vector<u8> makeData(size_t size)
+    {
+        std::mt19937 rng(0x504B534D);
+        std::vector<u8> ret(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            ret[i] = (i / 13) ^ (rng() % 4);
+        }
+        return ret;
+    }
+
+    std::vector<u8> compress(const std::vector<u8>& data)
+    {
+        unsigned int size = data.size() + data.size() / 100 + 600;
+        std::vector<u8> ret(size);
+        BZ2_bzBuffToBuffCompress((char*)ret.data(), &size, (char*)data.data(), data.size(), 9, 0, 0);
+        ret.resize(size);
+        return ret;
+    }
+
+    void writeFile(const std::string& path, const std::vector<u8>& data)
+    {
+        FILE* file = fopen(path.c_str(), "wb");
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+    }
+}
+
+int main()
+{
+    const std::vector<u8> data       = makeData(300000);
+    const std::vector<u8> compressed = compress(data);
+    const std::string path           = "build/decompress.bz2";
+
+    // Whole file by path, all at once
+    writeFile(path, compressed);
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out;
+        check(stream.readAll(out), "a whole file doesn't decompress");
+        check(out == data, "a whole file decompresses wrong");
+        check(stream.good() && stream.eof(), "a whole file doesn't end cleanly");
+        check(stream.offset() == data.size(), "offset doesn't count the whole file");
+        check(stream.read(out.data(), 1) == 0, "reading past the end returns data");
+    }
+
+    // Whole file in small uneven reads
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out;
+        u8 buf[777];
+        u32 got;
+        while ((got = stream.read(buf, sizeof(buf))) > 0)
+        {
+            out.insert(out.end(), buf, buf + got);
+            check(stream.offset() == out.size(), "offset doesn't follow small reads");
+        }
+        check(stream.good() && stream.eof(), "small reads don't end cleanly");
+        check(out == data, "small reads decompress wrong");
+    }
+
+    // readAll appends, and grows by fixed steps rather than doubling
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out(5, 0xAA);
+        check(stream.readAll(out), "readAll fails after existing contents");
+        check(out.size() == data.size() + 5 && std::equal(data.begin(), data.end(), out.begin() + 5),
+            "readAll doesn't append after existing contents");
+        check(out.capacity() - out.size() < 0x10000, "readAll over-allocates by more than a step");
+    }
+
+    // A region of an open file, between other data, leaving the file open
+    std::vector<u8> padded(1000 + compressed.size() + 1000, 0x55);
+    std::copy(compressed.begin(), compressed.end(), padded.begin() + 1000);
+    writeFile(path, padded);
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        fseek(file, 1000, SEEK_SET);
+        {
+            DecompressStream stream(file, compressed.size());
+            std::vector<u8> out;
+            check(stream.readAll(out) && out == data, "a region decompresses wrong");
+        }
+        check(ftell(file) <= long(1000 + compressed.size()), "a region reads past its end");
+        check(fgetc(file) != EOF, "a region closes the file");
+        fclose(file);
+    }
+
+    // A region shorter than its stream is truncated, even with the rest of the stream right after it
+    {
+        FILE* file = fopen(path.c_str(), "rb");
+        fseek(file, 1000, SEEK_SET);
+        {
+            DecompressStream stream(file, compressed.size() / 2);
+            std::vector<u8> out;
+            check(!stream.readAll(out), "a short region decompresses");
+            check(!stream.good() && !stream.eof(), "a short region looks complete");
+            check(out.size() < data.size(), "a short region produces all the data");
+        }
+        fclose(file);
+    }
+
+    // A file cut off part way
+    writeFile(path, std::vector<u8>(compressed.begin(), compressed.begin() + compressed.size() / 2));
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out;
+        check(!stream.readAll(out), "a truncated file decompresses");
+        check(!stream.good() && !stream.eof(), "a truncated file looks complete");
+        check(std::equal(out.begin(), out.end(), data.begin()), "a truncated file's start decompresses wrong");
+    }
+
+    // Not bzip2 at all
+    writeFile(path, std::vector<u8>(data.begin(), data.begin() + 1000));
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out;
+        check(!stream.readAll(out) && out.empty(), "garbage decompresses");
+    }
+
+    // Nothing there
+    remove(path.c_str());
+    {
+        DecompressStream stream(path);
+        std::vector<u8> out;
+        u8 buf[16];
+        check(!stream.good(), "a missing file is good");
+        check(stream.read(buf, sizeof(buf)) == 0, "a missing file reads");
+        check(!stream.readAll(out) && out.empty(), "a missing file decompresses");
+    }
+
+    std::printf("decompress: %d failures\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,222 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for G4Text against the linear searches it replaced, which are kept here as the reference.
+// The codec's translation unit is included directly to reach its character map
+#include "../source/utils/g4text.cpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    void appendUTF8(std::string& out, char16_t codepoint)
+    {
+        if (codepoint < 0x0080)
+        {
+            out += codepoint;
+        }
+        else if (codepoint < 0x0800)
+        {
+            out += 0xC0 | ((codepoint >> 6) & 0x1F);
+            out += 0x80 | (codepoint & 0x3F);
+        }
+        else
+        {
+            out += 0xE0 | ((codepoint >> 12) & 0x0F);
+            out += 0x80 | ((codepoint >> 6) & 0x3F);
+            out += 0x80 | (codepoint & 0x3F);
+        }
+    }
+
+    // StringUtils::getString4 before G4Text, minus its per-character allocations. Only defined for
+    // mapped values; the original read past the end of the map for anything else
+    std::string referenceDecode(const u16* src, size_t len)
+    {
+        std::string output;
+        for (size_t i = 0; i < len; i++)
+        {
+            if (src[i] == 0xFFFF)
+            {
+                break;
+            }
+            size_t index       = std::distance(G4Values, std::find(G4Values, G4Values + G4TEXT_LENGTH, src[i]));
+            char16_t codepoint = G4Chars[index];
+            if (codepoint == 0xFFFF)
+            {
+                break;
+            }
+            switch (codepoint)
+            {
+                case 0x246E:
+                    codepoint = 0x2640;
+                    break;
+                case 0x246D:
+                    codepoint = 0x2642;
+                    break;
+            }
+            appendUTF8(output, codepoint);
+        }
+        return output;
+    }
+
+    // StringUtils::setString4 before G4Text. Only defined for complete 1 to 3 byte UTF-8 sequences
+    std::vector<u16> referenceEncode(const std::string& v, size_t len)
+    {
+        std::vector<u16> output(len);
+        size_t outIndex = 0, charIndex = 0;
+        for (; outIndex < len && charIndex < v.length(); charIndex++, outIndex++)
+        {
+            u16 codepoint = (u8)v[charIndex];
+            if (v[charIndex] & 0x80)
+            {
+                if ((v[charIndex] & 0xE0) == 0xE0)
+                {
+                    codepoint = v[charIndex] & 0x0F;
+                    codepoint = codepoint << 6 | (v[charIndex + 1] & 0x3F);
+                    codepoint = codepoint << 6 | (v[charIndex + 2] & 0x3F);
+                    charIndex += 2;
+                }
+                else
+                {
+                    codepoint = v[charIndex] & 0x1F;
+                    codepoint = codepoint << 6 | (v[charIndex + 1] & 0x3F);
+                    charIndex += 1;
+                }
+                switch (codepoint)
+                {
+                    case 0x2640:
+                        codepoint = 0x246E;
+                        break;
+                    case 0x2642:
+                        codepoint = 0x246D;
+                        break;
+                }
+            }
+            size_t index     = std::distance(G4Chars, std::find(G4Chars, G4Chars + G4TEXT_LENGTH, codepoint));
+            output[outIndex] = index < G4TEXT_LENGTH ? G4Values[index] : 0x0000;
+        }
+        output[outIndex >= len ? len - 1 : outIndex] = 0xFFFF;
+        return output;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    // Every mapped Gen 4 value on its own
+    for (size_t i = 0; i < G4TEXT_LENGTH; i++)
+    {
+        u16 value = G4Values[i];
+        std::string decoded;
+        G4Text::decode(&value, 1, decoded);
+        if (decoded != referenceDecode(&value, 1))
+        {
+            std::printf("decoding 0x%04X differs\n", value);
+            failures++;
+        }
+    }
+
+    // Every BMP codepoint but the terminator, which the reference took as the end of the string
+    for (u32 codepoint = 1; codepoint < 0xFFFF; codepoint++)
+    {
+        std::string utf8;
+        appendUTF8(utf8, codepoint);
+        u16 encoded[2];
+        G4Text::encode(utf8, encoded, 2);
+        if (std::vector<u16>(encoded, encoded + 2) != referenceEncode(utf8, 2))
+        {
+            std::printf("encoding U+%04X differs\n", codepoint);
+            failures++;
+        }
+    }
+
+    // Whole names, including ones too long for their buffer
+    std::mt19937 rng(0x504B534D);
+    std::vector<u16> mapped;
+    for (size_t i = 0; i < G4TEXT_LENGTH; i++)
+    {
+        if (G4Values[i] != 0xFFFF && G4Chars[i] != 0xFFFF)
+        {
+            mapped.push_back(G4Values[i]);
+        }
+    }
+    for (int i = 0; i < 100000; i++)
+    {
+        size_t len = 1 + rng() % 16;
+        std::vector<u16> name(1 + rng() % 20);
+        for (auto& c : name)
+        {
+            c = mapped[rng() % mapped.size()];
+        }
+        std::string decoded;
+        G4Text::decode(name.data(), name.size(), decoded);
+        if (decoded != referenceDecode(name.data(), name.size()))
+        {
+            std::printf("decoding a %zu character name differs\n", name.size());
+            failures++;
+        }
+
+        std::vector<u16> encoded(len);
+        G4Text::encode(decoded, encoded.data(), len);
+        if (encoded != referenceEncode(decoded, len))
+        {
+            std::printf("encoding \"%s\" into %zu characters differs\n", decoded.c_str(), len);
+            failures++;
+        }
+    }
+
+    // An 11 character name, as in a Gen 4 save
+    std::vector<u16> name(11);
+    for (auto& c : name)
+    {
+        c = mapped[rng() % mapped.size()];
+    }
+    constexpr int ROUNDS = 20000;
+    size_t sink          = 0;
+    auto start           = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        sink += referenceDecode(name.data(), name.size()).size();
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        std::string decoded;
+        G4Text::decode(name.data(), name.size(), decoded);
+        sink += decoded.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::printf("g4text: decoding 11 characters took %.0f ns, %.0f ns before (%zu)\n",
+        std::chrono::duration<double, std::nano>(end - middle).count() / ROUNDS,
+        std::chrono::duration<double, std::nano>(middle - start).count() / ROUNDS, sink);
+
+    std::printf("g4text: %d failures\n", failures);
+    return failures != 0;
+}
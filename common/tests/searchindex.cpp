@@ -0,0 +1,104 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for SearchIndex: every search is compared against a plain scan of the folded names,
+// including searches that extend or replace the previous one
+#include "searchindex.hpp"
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    std::vector<size_t> scan(const std::vector<std::string>& names, std::string_view search, bool substring)
+    {
+        std::string folded = SearchIndex::fold(search, true);
+        std::vector<size_t> ret;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            std::string name = SearchIndex::fold(names[i], true);
+            size_t found     = name.find(folded);
+            if (substring ? found != std::string::npos : found == 0)
+            {
+                ret.push_back(i);
+            }
+        }
+        return ret;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    if (SearchIndex::fold("Flabébé", true) != "flabebe" || SearchIndex::fold("ÉCLAIR", false) != "éclair" ||
+        SearchIndex::fold("Ærø", true) != "\xC3\xA6ro")
+    {
+        std::printf("fold: unexpected result\n");
+        failures++;
+    }
+
+    std::mt19937 rng(0x504B534D);
+    const char* pieces[] = {"a", "b", "c", "ab", "é", "É", "Ch", "o", "ö", " ", "-"};
+    std::vector<std::string> names(2000);
+    for (auto& name : names)
+    {
+        for (int i = rng() % 8; i >= 0; i--)
+        {
+            name += pieces[rng() % std::size(pieces)];
+        }
+    }
+    std::vector<std::string_view> views(names.begin(), names.end());
+    SearchIndex index(views);
+    SearchIndex::Search search(index);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        bool substring = rng() % 2;
+        std::string query;
+        for (int j = rng() % 5; j >= 0; j--)
+        {
+            query += pieces[rng() % std::size(pieces)];
+        }
+        // Type it a piece at a time, like the keyboard would
+        std::string typed;
+        for (char c : query)
+        {
+            typed += c;
+            if ((c & 0xC0) == 0xC0)
+            {
+                continue;
+            }
+            if (search.find(typed, substring) != scan(names, typed, substring))
+            {
+                std::printf("%s search for \"%s\" differs from a scan\n", substring ? "substring" : "prefix", typed.c_str());
+                failures++;
+            }
+        }
+    }
+
+    std::printf("searchindex: %d failures\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,161 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for Slab: blocks freed on other threads go back to their owner, caches of finished threads
+// are adopted, concurrent use hands out no block twice, and stats() adds up throughout
+#include "slab.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::atomic<int> failures{0};
+
+    void check(bool ok, const char* what)
+    {
+        if (!ok)
+        {
+            std::printf("%s\n", what);
+            failures++;
+        }
+    }
+
+    std::vector<u8*> allocateAll(size_t count, size_t size, u8 fill)
+    {
+        std::vector<u8*> ret;
+        for (size_t i = 0; i < count; i++)
+        {
+            ret.push_back((u8*)Slab::allocate(size));
+            std::memset(ret.back(), fill, size);
+        }
+        return ret;
+    }
+
+    bool intact(const std::vector<u8*>& blocks, size_t size, u8 fill)
+    {
+        for (u8* block : blocks)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                if (block[i] != fill)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void freeAll(const std::vector<u8*>& blocks, size_t size)
+    {
+        for (u8* block : blocks)
+        {
+            Slab::deallocate(block, size);
+        }
+    }
+}
+
+int main()
+{
+    constexpr size_t SIZE  = 136;
+    constexpr size_t COUNT = 1000;
+
+    Slab::Stats before = Slab::stats();
+    std::vector<u8*> blocks = allocateAll(COUNT, SIZE, 0xA5);
+    Slab::Stats after = Slab::stats();
+    check(after.allocations - before.allocations == COUNT, "allocations doesn't count every block");
+    check(after.live - before.live == COUNT * SIZE, "live doesn't count bytes");
+    check(after.peak >= after.live, "peak is below live");
+    check(after.reserved >= COUNT * SIZE, "reserved doesn't cover the live blocks");
+
+    // Freed on another thread, then reused here without carving out new chunks
+    std::thread([&] { freeAll(blocks, SIZE); }).join();
+    check(Slab::stats().live == before.live, "blocks freed on another thread still count as live");
+    size_t reserved = Slab::stats().reserved;
+    blocks = allocateAll(COUNT, SIZE, 0x5A);
+    check(Slab::stats().reserved == reserved, "blocks freed on another thread weren't handed back");
+    freeAll(blocks, SIZE);
+
+    // A finished thread's cache, and what was freed to it after it finished, goes to the next thread
+    std::vector<u8*> orphaned;
+    std::thread([&] { orphaned = allocateAll(COUNT, SIZE * 2, 0x11); }).join();
+    freeAll(orphaned, SIZE * 2);
+    reserved = Slab::stats().reserved;
+    std::thread([&] {
+        std::vector<u8*> adopted = allocateAll(COUNT, SIZE * 2, 0x22);
+        check(intact(adopted, SIZE * 2, 0x22), "an adopted block was handed out twice");
+        freeAll(adopted, SIZE * 2);
+    }).join();
+    check(Slab::stats().reserved == reserved, "a finished thread's cache wasn't adopted");
+
+    // Threads allocating and freeing each other's blocks at once
+    constexpr int THREADS = 4;
+    std::vector<std::vector<u8*>> handoff(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 50; round++)
+            {
+                std::vector<u8*> mine = allocateAll(200, 32 + 32 * t, 0x30 + t);
+                check(intact(mine, 32 + 32 * t, 0x30 + t), "a block was handed out to two threads");
+                freeAll(mine, 32 + 32 * t);
+            }
+            handoff[t] = allocateAll(500, 64, 0x40 + t);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+    for (int t = 0; t < THREADS; t++)
+    {
+        check(intact(handoff[t], 64, 0x40 + t), "a block was handed out to two threads");
+        threads.emplace_back([&, t] { freeAll(handoff[(t + 1) % THREADS], 64); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Over MAX_SIZE goes to the heap but is still counted
+    before = Slab::stats();
+    void* large = Slab::allocate(Slab::MAX_SIZE + 1);
+    check(Slab::stats().live == before.live + Slab::MAX_SIZE + 1, "large blocks aren't counted");
+    Slab::deallocate(large, Slab::MAX_SIZE + 1);
+
+    Slab::Stats end = Slab::stats();
+    check(end.live == 0, "live isn't back to zero once everything is freed");
+    check(end.peak >= COUNT * SIZE * 2, "peak is below what was live at once");
+    std::printf("slab: %zu allocations, %zu bytes peak, %zu bytes reserved\n", end.allocations, end.peak, end.reserved);
+
+    std::printf("slab: %d failures\n", failures.load());
+    return failures.load() != 0;
+}
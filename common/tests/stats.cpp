@@ -0,0 +1,149 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for Stats against the linear level walk and per-stat formula PKX used before, which are kept
+// here as the reference
+#include "Stats.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    // PK6::level before the binary search: walks the thresholds up from level 2
+    u8 referenceLevel(u8 expType, u32 exp)
+    {
+        u8 i = 1;
+        while (exp >= Stats::expTable(i, expType) && ++i < 100);
+        return i;
+    }
+
+    // PK6::stat before all six were done at once, down to reading the level again for every stat
+    u16 referenceStat(u8 stat, const u8* bases, const u8* ivs, const u8* evs, u8 expType, u32 exp, u8 nature)
+    {
+        u16 calc;
+        u8 mult = 10;
+        if (stat == 0)
+            calc = 10 + (2 * bases[stat] + ivs[stat] + evs[stat] / 4 + 100) * referenceLevel(expType, exp) / 100;
+        else
+            calc = 5 + (2 * bases[stat] + ivs[stat] + evs[stat] / 4) * referenceLevel(expType, exp) / 100;
+        if (nature / 5 + 1 == stat) mult++;
+        if (nature % 5 + 1 == stat) mult--;
+        return calc * mult / 10;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    // Every experience value of every growth rate, up to a little past the level 100 threshold
+    for (u8 type = 0; type < 6; type++)
+    {
+        for (u32 exp = 0; exp <= Stats::expTable(99, type) + 10; exp++)
+        {
+            if (Stats::levelFromExp(type, exp) != referenceLevel(type, exp))
+            {
+                std::printf("growth rate %u at %u experience differs\n", type, exp);
+                failures++;
+                break;
+            }
+        }
+        if (Stats::levelFromExp(type, 0xFFFFFFFF) != 100)
+        {
+            std::printf("growth rate %u doesn't cap at level 100\n", type);
+            failures++;
+        }
+        for (u8 level = 1; level <= 100; level++)
+        {
+            if (Stats::levelFromExp(type, Stats::expTable(level - 1, type)) != level)
+            {
+                std::printf("growth rate %u doesn't reach level %u at its threshold\n", type, level);
+                failures++;
+            }
+        }
+    }
+
+    // Random spreads, including the extremes of every field
+    std::mt19937 rng(0x504B534D);
+    for (int i = 0; i < 1000000; i++)
+    {
+        u8 bases[6], ivs[6], evs[6];
+        for (int j = 0; j < 6; j++)
+        {
+            bases[j] = i % 7 == 0 ? 255 : 1 + rng() % 255;
+            ivs[j]   = i % 5 == 0 ? 31 : rng() % 32;
+            evs[j]   = i % 3 == 0 ? 255 : rng() % 256;
+        }
+        u8 type    = rng() % 6;
+        u32 exp    = rng() % (Stats::expTable(99, type) + 1);
+        u8 nature  = rng() % 25;
+        std::array<u16, 6> stats;
+        Stats::calc(stats, bases, ivs, evs, Stats::levelFromExp(type, exp), nature);
+        for (u8 stat = 0; stat < 6; stat++)
+        {
+            if (stats[stat] != referenceStat(stat, bases, ivs, evs, type, exp, nature))
+            {
+                std::printf("stat %u differs at %u experience, nature %u\n", stat, exp, nature);
+                failures++;
+            }
+        }
+    }
+
+    // A level 50 to 100 party member, as when refreshing party stats
+    constexpr int ROUNDS = 200000;
+    const u8 bases[6] = {80, 82, 83, 80, 100, 100};
+    const u8 ivs[6]   = {31, 31, 31, 31, 31, 31};
+    const u8 evs[6]   = {252, 0, 4, 252, 0, 0};
+    u32 sink          = 0;
+    auto start        = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        u32 exp = 125000 + i % 875000;
+        for (u8 stat = 0; stat < 6; stat++)
+        {
+            sink += referenceStat(stat, bases, ivs, evs, 0, exp, i % 25);
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        u32 exp = 125000 + i % 875000;
+        std::array<u16, 6> stats;
+        Stats::calc(stats, bases, ivs, evs, Stats::levelFromExp(0, exp), i % 25);
+        for (u16 stat : stats)
+        {
+            sink += stat;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::printf("stats: level and six stats took %.0f ns, %.0f ns before (%u)\n",
+        std::chrono::duration<double, std::nano>(end - middle).count() / ROUNDS,
+        std::chrono::duration<double, std::nano>(middle - start).count() / ROUNDS, sink);
+
+    std::printf("stats: %d failures\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,219 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+// Host check for the UTF-8/UTF-16 conversions against the ones they replaced, which are kept here as
+// the reference
+#include "utils.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // StringUtils::UTF8toUTF16 before common/utils/utf.cpp, except that a complete 4-byte sequence
+    // becomes one U+FFFD instead of four
+    std::u16string referenceUTF8toUTF16(const std::string& src)
+    {
+        std::u16string ret;
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            u16 codepoint = 0xFFFD;
+            int iMod      = 0;
+            if (src[i] & 0x80 && src[i] & 0x40 && src[i] & 0x20 && !(src[i] & 0x10) && i + 2 < src.size())
+            {
+                codepoint = src[i] & 0x0F;
+                codepoint = codepoint << 6 | (src[i + 1] & 0x3F);
+                codepoint = codepoint << 6 | (src[i + 2] & 0x3F);
+                iMod      = 2;
+            }
+            else if (src[i] & 0x80 && src[i] & 0x40 && !(src[i] & 0x20) && i + 1 < src.size())
+            {
+                codepoint = src[i] & 0x1F;
+                codepoint = codepoint << 6 | (src[i + 1] & 0x3F);
+                iMod      = 1;
+            }
+            else if (((u8)src[i] & 0xF8) == 0xF0 && i + 3 < src.size())
+            {
+                iMod = 3;
+            }
+            else if (!(src[i] & 0x80))
+            {
+                codepoint = src[i];
+            }
+
+            ret.push_back((char16_t)codepoint);
+            i += iMod;
+        }
+        return ret;
+    }
+
+    // utf16DataToUtf8 before common/utils/utf.cpp
+    std::string referenceUTF16toUTF8(const char16_t* data, size_t size, char16_t delim = 0)
+    {
+        std::string ret;
+        char addChar[4] = {0};
+        for (size_t i = 0; i < size; i++)
+        {
+            if (data[i] == delim)
+            {
+                return ret;
+            }
+            else if (data[i] < 0x0080)
+            {
+                addChar[0] = data[i];
+                addChar[1] = '\0';
+            }
+            else if (data[i] < 0x0800)
+            {
+                addChar[0] = 0xC0 | ((data[i] >> 6) & 0x1F);
+                addChar[1] = 0x80 | (data[i] & 0x3F);
+                addChar[2] = '\0';
+            }
+            else
+            {
+                addChar[0] = 0xE0 | ((data[i] >> 12) & 0x0F);
+                addChar[1] = 0x80 | ((data[i] >> 6) & 0x3F);
+                addChar[2] = 0x80 | (data[i] & 0x3F);
+                addChar[3] = '\0';
+            }
+            ret.append(addChar);
+        }
+        return ret;
+    }
+
+    // StringUtils::setString before common/utils/utf.cpp
+    void referenceSetString(u8* data, const std::u16string& v, int ofs, int len, char16_t terminator, char16_t padding)
+    {
+        int i = 0;
+        for (; i < std::min(len - 1, (int)v.size()); i++)
+        {
+            *(u16*)(data + ofs + i * 2) = v[i];
+        }
+        *(u16*)(data + ofs + i++ * 2) = terminator;
+        for (; i < len; i++)
+        {
+            *(u16*)(data + ofs + i * 2) = padding;
+        }
+    }
+
+    std::mt19937 rng(0x504B534D);
+
+    // Mostly ASCII, so the word-at-a-time paths get runs to work on
+    std::u16string randomUTF16()
+    {
+        static const char16_t units[] = {0, 0xFFFF, 0x7F, 0x80, 0x7FF, 0x800, 0xE9, 0x3042, 0xD800, 0xFFFD};
+        std::u16string ret(rng() % 40, u'\0');
+        for (auto& c : ret)
+        {
+            switch (rng() % 4)
+            {
+                case 0:
+                    c = units[rng() % std::size(units)];
+                    break;
+                default:
+                    c = 0x20 + rng() % 0x5F;
+                    break;
+            }
+        }
+        return ret;
+    }
+
+    // Well formed pieces, 4-byte sequences and stray or truncated bytes
+    std::string randomUTF8()
+    {
+        static const std::string_view pieces[] = {"\xC3\xA9", "\xE3\x81\x82", "\xF0\x9F\x98\x80", "\x80", "\xC3", "\xE3\x81",
+            "\xF0\x9F", "\xFF", "\xF8\x88\x80\x80\x80", std::string_view("\0", 1)};
+        std::string ret;
+        for (int i = rng() % 40; i > 0; i--)
+        {
+            if (rng() % 4 == 0)
+            {
+                ret += pieces[rng() % std::size(pieces)];
+            }
+            else
+            {
+                ret += (char)(0x20 + rng() % 0x5F);
+            }
+        }
+        return ret;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    for (int i = 0; i < 200000; i++)
+    {
+        std::string utf8 = randomUTF8();
+        if (StringUtils::UTF8toUTF16(utf8) != referenceUTF8toUTF16(utf8))
+        {
+            std::printf("UTF8toUTF16 differs for a %zu byte string\n", utf8.size());
+            failures++;
+        }
+
+        std::u16string utf16 = randomUTF16();
+        if (StringUtils::UTF16toUTF8(utf16) != referenceUTF16toUTF8(utf16.data(), utf16.size()))
+        {
+            std::printf("UTF16toUTF8 differs for a %zu unit string\n", utf16.size());
+            failures++;
+        }
+
+        // Strings in a save, with the terminators the save classes use
+        char16_t term = rng() % 2 ? 0 : 0xFFFF;
+        int len       = 1 + rng() % 26;
+        std::vector<u8> save(4 + len * 2, 0xAA), expected(save);
+        std::copy_n((const u8*)utf16.data(), std::min(utf16.size() * 2, (size_t)len * 2), save.begin() + 2);
+        if (StringUtils::getString(save.data(), 2, len, term) != referenceUTF16toUTF8((const char16_t*)(save.data() + 2), len, term))
+        {
+            std::printf("getString differs for a %d unit field\n", len);
+            failures++;
+        }
+
+        std::fill(save.begin(), save.end(), 0xAA);
+        StringUtils::setString(save.data(), utf16, 2, len, term, 0);
+        referenceSetString(expected.data(), utf16, 2, len, term, 0);
+        if (save != expected)
+        {
+            std::printf("setString differs for %zu units into a %d unit field\n", utf16.size(), len);
+            failures++;
+        }
+
+        std::fill(save.begin(), save.end(), 0xAA);
+        std::fill(expected.begin(), expected.end(), 0xAA);
+        StringUtils::setString(save.data(), std::string_view(utf8), 2, len, term, 0);
+        referenceSetString(expected.data(), referenceUTF8toUTF16(utf8), 2, len, term, 0);
+        if (save != expected)
+        {
+            std::printf("setString differs for %zu bytes into a %d unit field\n", utf8.size(), len);
+            failures++;
+        }
+    }
+
+    std::printf("utf: %d failures\n", failures);
+    return failures != 0;
+}
@@ -28,12 +28,15 @@
 #define LANGUAGESTRINGS_HPP
 
 #include <algorithm>
+#include <array>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "io.hpp"
-#include "json.hpp"
 #include "generation.hpp"
+#include "searchindex.hpp"
 #include "types.h"
 
 enum Language
@@ -56,47 +59,96 @@ enum Language
 class LanguageStrings
 {
 protected:
-    std::vector<std::string> abilities;
-    std::vector<std::string> balls;
-    std::vector<std::string> forms;
-    std::vector<std::string> hps;
-    std::vector<std::string> items;
-    std::vector<std::string> moves;
-    std::vector<std::string> natures;
-    std::vector<std::string> speciess;
-    std::vector<std::string> games;
-    std::map<u16, std::string> locations4;
-    std::map<u16, std::string> locations5;
-    std::map<u16, std::string> locations6;
-    std::map<u16, std::string> locations7;
-    std::map<u16, std::string> locationsLGPE;
-    nlohmann::json gui;
+    // Order of the tables in strings.bin; see common/I18nPacker/packer.py
+    enum Table
+    {
+        ABILITIES,
+        BALLS,
+        FORMS,
+        HPS,
+        ITEMS,
+        MOVES,
+        NATURES,
+        SPECIES,
+        GAMES,
+        LOCATIONS4,
+        LOCATIONS5,
+        LOCATIONS6,
+        LOCATIONS7,
+        LOCATIONSLGPE,
+        GUI,
+        TABLE_COUNT
+    };
 
-    void load(Language lang, const std::string name, std::vector<std::string>& array);
-    void loadMap(Language lang, const std::string name, std::map<u16, std::string>& map);
-    void loadGui(Language lang);
+    struct StringTable
+    {
+        u32 count = 0;
+        // count + 1 offsets into blob; the last one marks the end of the final string
+        const u32* offsets = nullptr;
+        // Sorted location ids, or nullptr for plain lists
+        const u16* ids = nullptr;
+    };
+
+    // The whole strings.bin. Every string returned points into it, NUL terminated
+    std::vector<u32> blob;
+    std::array<StringTable, TABLE_COUNT> tables;
+    // GUI strings are built once so localize can hand out std::string references. They are found
+    // through an open addressed table of guiKey hashes built by the packer, and checked against the key itself
+    std::vector<std::string> gui;
+    const u32* guiKeys = nullptr;
+    // count + 1 offsets into blob, like StringTable::offsets, of the keys guiKeys hashes
+    const u32* guiNames = nullptr;
+    const u16* guiBuckets = nullptr;
+    u32 guiBucketMask = 0;
+    // Built on first use by the pickers, which all run on the main thread
+    mutable std::array<std::unique_ptr<SearchIndex>, TABLE_COUNT> searchIndexes;
+
+    void loadStrings(Language lang);
+    std::string_view string(Table table, size_t index) const;
+    // Position of a location id in its table, or the table's count if it has none
+    size_t find(Table table, u16 id) const;
+    Table locationTable(Generation generation) const;
+    const SearchIndex& searchIndex(Table table) const;
 
 public:
     LanguageStrings(Language lang);
     std::string folder(Language lang) const;
 
-    const std::vector<std::string>& rawItems() const;
-    const std::vector<std::string>& rawMoves() const;
-    const std::map<u16, std::string>& locations(Generation g) const;
+    std::vector<std::string_view> rawItems() const;
+    std::vector<std::string_view> rawMoves() const;
+    std::vector<std::pair<u16, std::string_view>> locations(Generation g) const;
     size_t numGameStrings() const;
+    // Search indexes over whole tables. Species, moves and items are numbered by id; locations by their
+    // position in locations(g)
+    const SearchIndex& speciesIndex() const { return searchIndex(SPECIES); }
+    const SearchIndex& moveIndex() const { return searchIndex(MOVES); }
+    const SearchIndex& itemIndex() const { return searchIndex(ITEMS); }
+    const SearchIndex& locationIndex(Generation g) const { return searchIndex(locationTable(g)); }
+
+    std::string_view ability(u8 v) const;
+    std::string_view ball(u8 v) const;
+    std::string_view hp(u8 v) const;
+    std::string_view item(u16 v) const;
+    std::string_view move(u16 v) const;
+    std::string_view nature(u8 v) const;
+    std::string_view species(u16 v) const;
+    std::string_view form(u16 species, u8 form, Generation generation) const;
+    std::string_view location(u16 v, Generation generation) const;
+    std::string_view game(u8 v) const;
 
-    const std::string& ability(u8 v) const;
-    const std::string& ball(u8 v) const;
-    const std::string& hp(u8 v) const;
-    const std::string& item(u16 v) const;
-    const std::string& move(u16 v) const;
-    const std::string& nature(u8 v) const;
-    const std::string& species(u16 v) const;
-    const std::string& form(u16 species, u8 form, Generation generation) const;
-    const std::string& location(u16 v, Generation generation) const;
-    const std::string& game(u8 v) const;
+    // FNV-1a, matching common/I18nPacker/packer.py. constexpr so that literal keys can be hashed at compile time
+    static constexpr u32 guiKey(std::string_view key)
+    {
+        u32 ret = 0x811C9DC5;
+        for (char c : key)
+        {
+            ret = (ret ^ (u8)c) * 0x01000193;
+        }
+        return ret;
+    }
 
-    const std::string& localize(const std::string& v) const;
+    const std::string& localize(u32 key, std::string_view v) const;
+    const std::string& localize(std::string_view v) const { return localize(guiKey(v), v); }
 };
 
 #endif
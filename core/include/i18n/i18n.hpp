@@ -32,29 +32,48 @@
 
 namespace i18n
 {
+    // Languages are loaded on first use; init only prepares for that
     void init(void);
+    // Loads the configured language ahead of its first use. Meant for a background thread
+    void prefetch(void);
     void exit(void);
 
-    const std::vector<std::string>& rawItems(u8 lang);
-    const std::vector<std::string>& rawMoves(u8 lang);
-    const std::map<u16, std::string>& locations(u8 lang, Generation g);
+    std::vector<std::string_view> rawItems(u8 lang);
+    std::vector<std::string_view> rawMoves(u8 lang);
+    // Sorted by location id
+    std::vector<std::pair<u16, std::string_view>> locations(u8 lang, Generation g);
     size_t numGameStrings(u8 lang);
-    
-    const std::string& ability(u8 lang, u8 value);
-    const std::string& ball(u8 lang, u8 value);
-    const std::string& hp(u8 lang, u8 value);
-    const std::string& item(u8 lang, u16 value);
-    const std::string& move(u8 lang, u16 value);
-    const std::string& nature(u8 lang, u8 value);
-    const std::string& species(u8 lang, u16 value);
-    const std::string& form(u8 lang, u16 species, u8 form, Generation generation);
-    const std::string& location(u8 lang, u16 value, Generation generation);
-    const std::string& location(u8 lang, u16 value, u8 originGame);
-    const std::string& game(u8 lang, u8 value);
+    // Shared by every picker for the language; numbered as in LanguageStrings
+    const SearchIndex& speciesIndex(u8 lang);
+    const SearchIndex& moveIndex(u8 lang);
+    const SearchIndex& itemIndex(u8 lang);
+    const SearchIndex& locationIndex(u8 lang, Generation g);
 
-    // Used for general GUI stuff; not for PKM values
-    const std::string& localize(Language lang, const std::string& index);
-    const std::string& localize(const std::string& index);
+    // Game strings point into the language's string table, which stays loaded until exit; they are NUL terminated
+    std::string_view ability(u8 lang, u8 value);
+    std::string_view ball(u8 lang, u8 value);
+    std::string_view hp(u8 lang, u8 value);
+    std::string_view item(u8 lang, u16 value);
+    std::string_view move(u8 lang, u16 value);
+    std::string_view nature(u8 lang, u8 value);
+    std::string_view species(u8 lang, u16 value);
+    std::string_view form(u8 lang, u16 species, u8 form, Generation generation);
+    std::string_view location(u8 lang, u16 value, Generation generation);
+    std::string_view location(u8 lang, u16 value, u8 originGame);
+    std::string_view game(u8 lang, u8 value);
+
+    // Used for general GUI stuff; not for PKM values. key is LanguageStrings::guiKey(index); the inline
+    // overloads compute it where a literal key lets the compiler fold it
+    const std::string& localize(Language lang, u32 key, std::string_view index);
+    const std::string& localize(u32 key, std::string_view index);
+    inline const std::string& localize(Language lang, std::string_view index)
+    {
+        return localize(lang, LanguageStrings::guiKey(index), index);
+    }
+    inline const std::string& localize(std::string_view index)
+    {
+        return localize(LanguageStrings::guiKey(index), index);
+    }
     const std::string& langString(Language l);
     Language langFromString(const std::string& value);
 };
@@ -24,105 +24,188 @@
 *         reasonable ways as different from the original version.
 */
 
+
 #ifndef PERSONAL_HPP
 #define PERSONAL_HPP
 
+#include <array>
 #include "types.h"
+#include "generation.hpp"
 #include "personal_lgpe.h"
 #include "personal_smusum.h"
 #include "personal_xyoras.h"
 #include "personal_bwb2w2.h"
 #include "personal_dppthgss.h"
 
-namespace PersonalLGPE
+// Where each generation's entries live in the raw personal data, and how they're laid out
+template <Generation G>
+struct PersonalSource;
+
+template <>
+struct PersonalSource<Generation::FOUR>
 {
-    u8 baseHP(u16 species);
-    u8 baseAtk(u16 species);
-    u8 baseDef(u16 species);
-    u8 baseSpe(u16 species);
-    u8 baseSpa(u16 species);
-    u8 baseSpd(u16 species);
-    u8 type1(u16 species);
-    u8 type2(u16 species);
-    u8 gender(u16 species);
-    u8 baseFriendship(u16 species);
-    u8 expType(u16 species);
-    u8 ability(u16 species, u8 n);
-    u16 formStatIndex(u16 species);
-    u8 formCount(u16 species); 
-}
+    static constexpr const char* data = personal_dppthgss;
+    static constexpr size_t stride = 16;
+    static constexpr size_t count = sizeof(personal_dppthgss) / stride;
+    static constexpr size_t formStatIndex = 0xD;
+    static constexpr size_t formCount = 0xF;
+};
 
-namespace PersonalSMUSUM
+template <>
+struct PersonalSource<Generation::FIVE>
 {
-    u8 baseHP(u16 species);
-    u8 baseAtk(u16 species);
-    u8 baseDef(u16 species);
-    u8 baseSpe(u16 species);
-    u8 baseSpa(u16 species);
-    u8 baseSpd(u16 species);
-    u8 type1(u16 species);
-    u8 type2(u16 species);
-    u8 gender(u16 species);
-    u8 baseFriendship(u16 species);
-    u8 expType(u16 species);
-    u8 ability(u16 species, u8 n);
-    u16 formStatIndex(u16 species);
-    u8 formCount(u16 species);
-}
+    static constexpr const char* data = personal_bwb2w2;
+    static constexpr size_t stride = 17;
+    static constexpr size_t count = sizeof(personal_bwb2w2) / stride;
+    static constexpr size_t formStatIndex = 0xE;
+    static constexpr size_t formCount = 0x10;
+};
 
-namespace PersonalXYORAS
+template <>
+struct PersonalSource<Generation::SIX>
 {
-    u8 baseHP(u16 species);
-    u8 baseAtk(u16 species);
-    u8 baseDef(u16 species);
-    u8 baseSpe(u16 species);
-    u8 baseSpa(u16 species);
-    u8 baseSpd(u16 species);
-    u8 type1(u16 species);
-    u8 type2(u16 species);
-    u8 gender(u16 species);
-    u8 baseFriendship(u16 species);
-    u8 expType(u16 species);
-    u8 ability(u16 species, u8 n);
-    u16 formStatIndex(u16 species);
-    u8 formCount(u16 species);
-}
+    static constexpr const char* data = personal_xyoras;
+    static constexpr size_t stride = 17;
+    static constexpr size_t count = sizeof(personal_xyoras) / stride;
+    static constexpr size_t formStatIndex = 0xE;
+    static constexpr size_t formCount = 0x10;
+};
+
+template <>
+struct PersonalSource<Generation::SEVEN>
+{
+    static constexpr const char* data = personal_smusum;
+    static constexpr size_t stride = 17;
+    static constexpr size_t count = sizeof(personal_smusum) / stride;
+    static constexpr size_t formStatIndex = 0xE;
+    static constexpr size_t formCount = 0x10;
+};
 
-namespace PersonalBWB2W2
+template <>
+struct PersonalSource<Generation::LGPE>
 {
-    u8 baseHP(u16 species);
-    u8 baseAtk(u16 species);
-    u8 baseDef(u16 species);
-    u8 baseSpe(u16 species);
-    u8 baseSpa(u16 species);
-    u8 baseSpd(u16 species);
-    u8 type1(u16 species);
-    u8 type2(u16 species);
-    u8 gender(u16 species);
-    u8 baseFriendship(u16 species);
-    u8 expType(u16 species);
-    u8 ability(u16 species, u8 n);
-    u16 formStatIndex(u16 species);
-    u8 formCount(u16 species);
+    static constexpr const char* data = personal_lgpe;
+    static constexpr size_t stride = 17;
+    static constexpr size_t count = sizeof(personal_lgpe) / stride;
+    static constexpr size_t formStatIndex = 0xE;
+    static constexpr size_t formCount = 0x10;
+};
+
+// One array per attribute, so loops over many species only touch the attributes they use
+template <size_t N>
+struct PersonalTable
+{
+    std::array<u8, N> baseHP{}, baseAtk{}, baseDef{}, baseSpe{}, baseSpa{}, baseSpd{};
+    std::array<u8, N> type1{}, type2{};
+    std::array<u8, N> gender{};
+    std::array<u8, N> baseFriendship{};
+    std::array<u8, N> expType{};
+    std::array<std::array<u8, N>, 3> abilities{};
+    std::array<u16, N> formStatIndex{};
+    std::array<u8, N> formCount{};
+};
+
+template <Generation G>
+constexpr PersonalTable<PersonalSource<G>::count> makePersonalTable()
+{
+    using Source = PersonalSource<G>;
+    PersonalTable<Source::count> table;
+    for (size_t species = 0; species < Source::count; species++)
+    {
+        const char* entry = Source::data + species * Source::stride;
+        table.baseHP[species] = entry[0x0];
+        table.baseAtk[species] = entry[0x1];
+        table.baseDef[species] = entry[0x2];
+        table.baseSpe[species] = entry[0x3];
+        table.baseSpa[species] = entry[0x4];
+        table.baseSpd[species] = entry[0x5];
+        table.type1[species] = entry[0x6];
+        table.type2[species] = entry[0x7];
+        table.gender[species] = entry[0x8];
+        table.baseFriendship[species] = entry[0x9];
+        table.expType[species] = entry[0xA];
+        for (size_t n = 0; n < 3; n++)
+        {
+            table.abilities[n][species] = entry[0xB + n];
+        }
+        table.formStatIndex[species] = u8(entry[Source::formStatIndex]) | (u8(entry[Source::formStatIndex + 1]) << 8);
+        table.formCount[species] = entry[Source::formCount];
+        if (G == Generation::FOUR)
+        {
+            // Normalized to fit with other formCounts' return values
+            if (species == 201)
+            {
+                table.formCount[species] = 28;
+            }
+            else if (table.formCount[species] == 0)
+            {
+                table.formCount[species] = 1;
+            }
+        }
+    }
+    return table;
 }
 
-namespace PersonalDPPtHGSS
+template <Generation G>
+class Personal
 {
-    u8 baseHP(u16 species);
-    u8 baseAtk(u16 species);
-    u8 baseDef(u16 species);
-    u8 baseSpe(u16 species);
-    u8 baseSpa(u16 species);
-    u8 baseSpd(u16 species);
-    u8 type1(u16 species);
-    u8 type2(u16 species);
-    u8 baseExp(u8 species);
-    u8 gender(u16 species);
-    u8 baseFriendship(u16 species);
-    u8 expType(u16 species);
-    u8 ability(u16 species, u8 n);
-    u16 formStatIndex(u16 species);
-    u8 formCount(u16 species);
+private:
+    static constexpr PersonalTable<PersonalSource<G>::count> table = makePersonalTable<G>();
+
+public:
+    static constexpr u8 baseHP(u16 species) { return table.baseHP[species]; }
+    static constexpr u8 baseAtk(u16 species) { return table.baseAtk[species]; }
+    static constexpr u8 baseDef(u16 species) { return table.baseDef[species]; }
+    static constexpr u8 baseSpe(u16 species) { return table.baseSpe[species]; }
+    static constexpr u8 baseSpa(u16 species) { return table.baseSpa[species]; }
+    static constexpr u8 baseSpd(u16 species) { return table.baseSpd[species]; }
+    static constexpr u8 type1(u16 species) { return table.type1[species]; }
+    static constexpr u8 type2(u16 species) { return table.type2[species]; }
+    static constexpr u8 gender(u16 species) { return table.gender[species]; }
+    static constexpr u8 baseFriendship(u16 species) { return table.baseFriendship[species]; }
+    static constexpr u8 expType(u16 species) { return table.expType[species]; }
+    static constexpr u8 ability(u16 species, u8 n) { return table.abilities[n][species]; }
+    static constexpr u16 formStatIndex(u16 species) { return table.formStatIndex[species]; }
+    static constexpr u8 formCount(u16 species) { return table.formCount[species]; }
+};
+
+// For code that only knows its generation at runtime
+namespace PersonalDispatch
+{
+    template <typename F>
+    constexpr auto dispatch(Generation gen, F f)
+    {
+        switch (gen)
+        {
+            case Generation::FOUR:
+                return f(Personal<Generation::FOUR>{});
+            case Generation::FIVE:
+                return f(Personal<Generation::FIVE>{});
+            case Generation::SIX:
+                return f(Personal<Generation::SIX>{});
+            case Generation::SEVEN:
+                return f(Personal<Generation::SEVEN>{});
+            case Generation::LGPE:
+                return f(Personal<Generation::LGPE>{});
+            default:
+                return decltype(f(Personal<Generation::SEVEN>{})){};
+        }
+    }
+
+    inline u8 baseHP(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseHP(species); }); }
+    inline u8 baseAtk(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseAtk(species); }); }
+    inline u8 baseDef(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseDef(species); }); }
+    inline u8 baseSpe(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseSpe(species); }); }
+    inline u8 baseSpa(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseSpa(species); }); }
+    inline u8 baseSpd(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseSpd(species); }); }
+    inline u8 type1(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.type1(species); }); }
+    inline u8 type2(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.type2(species); }); }
+    inline u8 gender(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.gender(species); }); }
+    inline u8 baseFriendship(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.baseFriendship(species); }); }
+    inline u8 expType(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.expType(species); }); }
+    inline u8 ability(Generation gen, u16 species, u8 n) { return dispatch(gen, [species, n](auto p) { return p.ability(species, n); }); }
+    inline u16 formStatIndex(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.formStatIndex(species); }); }
+    inline u8 formCount(Generation gen, u16 species) { return dispatch(gen, [species](auto p) { return p.formCount(species); }); }
 }
 
 #endif
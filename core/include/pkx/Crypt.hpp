@@ -0,0 +1,50 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef CRYPT_HPP
+#define CRYPT_HPP
+
+#include "generation.hpp"
+#include "types.h"
+#include <stddef.h>
+
+// Stored entry encryption shared by every generation, kept apart from PKX so it builds on its own
+namespace Crypt
+{
+    // Which of the four blocks goes in each position, four entries per shuffle value
+    u8 blockPosition(u8 index);
+    // Shuffle value that undoes the given one
+    u8 blockPositionInvert(u8 index);
+    u32 seedStep(u32 seed);
+    // XORs len bytes (a multiple of 2) with the keystream of the LCG starting at seed
+    void cryptStream(u8* buf, u32 len, u32 seed);
+    // Decrypts or encrypts count stored entries of a generation in place; entries are stride bytes
+    // long and back to back, and stride may include party data after the boxed part (LGPE)
+    void cryptBoxes(Generation gen, u8* base, size_t count, size_t stride, bool decrypt);
+}
+
+#endif
@@ -35,14 +35,12 @@ class PB7 : public PKX
 protected:
     static constexpr u16 hyperTrainLookup[6] = {0, 1, 2, 5, 3, 4};
 
-    void shuffleArray(u8 sv) override;
-    void crypt(void) override;
     void reorderMoves(void) override;
 
 public:
-    PB7() { length = 260; data = new u8[length]; std::fill_n(data, length, 0); }
-    PB7(u8* dt, bool ekx = false);
-    virtual ~PB7() { delete[] data; }
+    PB7() { length = 260; allocate(); std::fill_n(data, length, 0); }
+    PB7(u8* dt, bool ekx = false, bool direct = false);
+    virtual ~PB7() {}
 
     std::shared_ptr<PKX> clone(void) override;
 
@@ -122,6 +120,9 @@ public:
 
     std::string htName(void) const;
     void htName(const std::string& v);
+    // Raw names for comparing against the save's OT name in trade()
+    std::u16string_view htNameView(void) const;
+    std::u16string_view otNameView(void) const;
     u8 htGender(void) const;
     void htGender(u8 v);
     u8 currentHandler(void) const override;
@@ -213,6 +214,7 @@ public:
     void shiny(bool v) override;
     u16 formSpecies(void) const override;
     u16 stat(const u8 stat) const override;
+    void stats(std::array<u16, 6>& out) const override;
     u16 CP(void) const;
 
     int partyCurrHP(void) const override;
@@ -229,19 +231,19 @@ public:
     u8 weight(void) const;
     void weight(u8 v);
 
-    inline u8 baseHP(void) const override { return PersonalLGPE::baseHP(formSpecies()); }
-    inline u8 baseAtk(void) const override { return PersonalLGPE::baseAtk(formSpecies()); }
-    inline u8 baseDef(void) const override { return PersonalLGPE::baseDef(formSpecies()); }
-    inline u8 baseSpe(void) const override { return PersonalLGPE::baseSpe(formSpecies()); }
-    inline u8 baseSpa(void) const override { return PersonalLGPE::baseSpa(formSpecies()); }
-    inline u8 baseSpd(void) const override { return PersonalLGPE::baseSpd(formSpecies()); }
-    inline u8 type1(void) const override { return PersonalLGPE::type1(formSpecies()); }
-    inline u8 type2(void) const override { return PersonalLGPE::type2(formSpecies()); }
-    inline u8 genderType(void) const override { return PersonalLGPE::gender(formSpecies()); }
-    inline u8 baseFriendship(void) const override { return PersonalLGPE::baseFriendship(formSpecies()); }
-    inline u8 expType(void) const override { return PersonalLGPE::expType(formSpecies()); }
-    inline u8 abilities(u8 n) const override { return PersonalLGPE::ability(formSpecies(), n); }
-    inline u16 formStatIndex(void) const override { return PersonalLGPE::formStatIndex(formSpecies()); }
+    inline u8 baseHP(void) const override { return Personal<Generation::LGPE>::baseHP(formSpecies()); }
+    inline u8 baseAtk(void) const override { return Personal<Generation::LGPE>::baseAtk(formSpecies()); }
+    inline u8 baseDef(void) const override { return Personal<Generation::LGPE>::baseDef(formSpecies()); }
+    inline u8 baseSpe(void) const override { return Personal<Generation::LGPE>::baseSpe(formSpecies()); }
+    inline u8 baseSpa(void) const override { return Personal<Generation::LGPE>::baseSpa(formSpecies()); }
+    inline u8 baseSpd(void) const override { return Personal<Generation::LGPE>::baseSpd(formSpecies()); }
+    inline u8 type1(void) const override { return Personal<Generation::LGPE>::type1(formSpecies()); }
+    inline u8 type2(void) const override { return Personal<Generation::LGPE>::type2(formSpecies()); }
+    inline u8 genderType(void) const override { return Personal<Generation::LGPE>::gender(formSpecies()); }
+    inline u8 baseFriendship(void) const override { return Personal<Generation::LGPE>::baseFriendship(formSpecies()); }
+    inline u8 expType(void) const override { return Personal<Generation::LGPE>::expType(formSpecies()); }
+    inline u8 abilities(u8 n) const override { return Personal<Generation::LGPE>::ability(formSpecies(), n); }
+    inline u16 formStatIndex(void) const override { return Personal<Generation::LGPE>::formStatIndex(formSpecies()); }
 };
 
 #endif
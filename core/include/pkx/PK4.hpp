@@ -37,13 +37,10 @@ protected:
     static constexpr u8 beasts[4] = { 251, 243, 244, 245 };
     static constexpr u16 banned[8] = { 15, 19, 57, 70, 250, 249, 127, 431 };
 
-    void shuffleArray(u8 sv) override;
-    void crypt(void) override;
-
 public:
-    PK4() { length = 136; data = new u8[length]; std::fill_n(data, length, 0); }
-    PK4(u8* dt, bool ekx = false, bool party = false);
-    virtual ~PK4() { delete[] data; };
+    PK4() { length = 136; allocate(); std::fill_n(data, length, 0); }
+    PK4(u8* dt, bool ekx = false, bool party = false, bool direct = false);
+    virtual ~PK4() {}
 
     std::shared_ptr<PKX> clone(void) override;
 
@@ -177,19 +174,19 @@ public:
     
     std::shared_ptr<PKX> next(void) const override;
 
-    inline u8 baseHP(void) const override { return PersonalDPPtHGSS::baseHP(formSpecies()); }
-    inline u8 baseAtk(void) const override { return PersonalDPPtHGSS::baseAtk(formSpecies()); }
-    inline u8 baseDef(void) const override { return PersonalDPPtHGSS::baseDef(formSpecies()); }
-    inline u8 baseSpe(void) const override { return PersonalDPPtHGSS::baseSpe(formSpecies()); }
-    inline u8 baseSpa(void) const override { return PersonalDPPtHGSS::baseSpa(formSpecies()); }
-    inline u8 baseSpd(void) const override { return PersonalDPPtHGSS::baseSpd(formSpecies()); }
-    inline u8 type1(void) const override { return PersonalDPPtHGSS::type1(formSpecies()); }
-    inline u8 type2(void) const override { return PersonalDPPtHGSS::type2(formSpecies()); }
-    inline u8 genderType(void) const override { return PersonalDPPtHGSS::gender(formSpecies()); }
-    inline u8 baseFriendship(void) const override { return PersonalDPPtHGSS::baseFriendship(formSpecies()); }
-    inline u8 expType(void) const override { return PersonalDPPtHGSS::expType(formSpecies()); }
-    inline u8 abilities(u8 n) const override { return PersonalDPPtHGSS::ability(formSpecies(), n); }
-    inline u16 formStatIndex(void) const override { return PersonalDPPtHGSS::formStatIndex(formSpecies()); }
+    inline u8 baseHP(void) const override { return Personal<Generation::FOUR>::baseHP(formSpecies()); }
+    inline u8 baseAtk(void) const override { return Personal<Generation::FOUR>::baseAtk(formSpecies()); }
+    inline u8 baseDef(void) const override { return Personal<Generation::FOUR>::baseDef(formSpecies()); }
+    inline u8 baseSpe(void) const override { return Personal<Generation::FOUR>::baseSpe(formSpecies()); }
+    inline u8 baseSpa(void) const override { return Personal<Generation::FOUR>::baseSpa(formSpecies()); }
+    inline u8 baseSpd(void) const override { return Personal<Generation::FOUR>::baseSpd(formSpecies()); }
+    inline u8 type1(void) const override { return Personal<Generation::FOUR>::type1(formSpecies()); }
+    inline u8 type2(void) const override { return Personal<Generation::FOUR>::type2(formSpecies()); }
+    inline u8 genderType(void) const override { return Personal<Generation::FOUR>::gender(formSpecies()); }
+    inline u8 baseFriendship(void) const override { return Personal<Generation::FOUR>::baseFriendship(formSpecies()); }
+    inline u8 expType(void) const override { return Personal<Generation::FOUR>::expType(formSpecies()); }
+    inline u8 abilities(u8 n) const override { return Personal<Generation::FOUR>::ability(formSpecies(), n); }
+    inline u16 formStatIndex(void) const override { return Personal<Generation::FOUR>::formStatIndex(formSpecies()); }
 };
 
 #endif
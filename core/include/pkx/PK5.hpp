@@ -34,14 +34,10 @@
 
 class PK5 : public PKX
 {
-protected:
-    void shuffleArray(u8 sv) override;
-    void crypt(void) override;
-
 public:
-    PK5() { length = 136; data = new u8[length]; std::fill_n(data, length, 0); }
-    PK5(u8* dt, bool ekx = false, bool party = false);
-    virtual ~PK5() { delete[] data; };
+    PK5() { length = 136; allocate(); std::fill_n(data, length, 0); }
+    PK5(u8* dt, bool ekx = false, bool party = false, bool direct = false);
+    virtual ~PK5() {}
 
     std::shared_ptr<PKX> clone(void) override;
 
@@ -173,19 +169,19 @@ public:
     std::shared_ptr<PKX> next(void) const override;
     std::shared_ptr<PKX> previous(void) const override;
 
-    inline u8 baseHP(void) const override { return PersonalBWB2W2::baseHP(formSpecies()); }
-    inline u8 baseAtk(void) const override { return PersonalBWB2W2::baseAtk(formSpecies()); }
-    inline u8 baseDef(void) const override { return PersonalBWB2W2::baseDef(formSpecies()); }
-    inline u8 baseSpe(void) const override { return PersonalBWB2W2::baseSpe(formSpecies()); }
-    inline u8 baseSpa(void) const override { return PersonalBWB2W2::baseSpa(formSpecies()); }
-    inline u8 baseSpd(void) const override { return PersonalBWB2W2::baseSpd(formSpecies()); }
-    inline u8 type1(void) const override { return PersonalBWB2W2::type1(formSpecies()); }
-    inline u8 type2(void) const override { return PersonalBWB2W2::type2(formSpecies()); }
-    inline u8 genderType(void) const override { return PersonalBWB2W2::gender(formSpecies()); }
-    inline u8 baseFriendship(void) const override { return PersonalBWB2W2::baseFriendship(formSpecies()); }
-    inline u8 expType(void) const override { return PersonalBWB2W2::expType(formSpecies()); }
-    inline u8 abilities(u8 n) const override { return PersonalBWB2W2::ability(formSpecies(), n); }
-    inline u16 formStatIndex(void) const override { return PersonalBWB2W2::formStatIndex(formSpecies()); }
+    inline u8 baseHP(void) const override { return Personal<Generation::FIVE>::baseHP(formSpecies()); }
+    inline u8 baseAtk(void) const override { return Personal<Generation::FIVE>::baseAtk(formSpecies()); }
+    inline u8 baseDef(void) const override { return Personal<Generation::FIVE>::baseDef(formSpecies()); }
+    inline u8 baseSpe(void) const override { return Personal<Generation::FIVE>::baseSpe(formSpecies()); }
+    inline u8 baseSpa(void) const override { return Personal<Generation::FIVE>::baseSpa(formSpecies()); }
+    inline u8 baseSpd(void) const override { return Personal<Generation::FIVE>::baseSpd(formSpecies()); }
+    inline u8 type1(void) const override { return Personal<Generation::FIVE>::type1(formSpecies()); }
+    inline u8 type2(void) const override { return Personal<Generation::FIVE>::type2(formSpecies()); }
+    inline u8 genderType(void) const override { return Personal<Generation::FIVE>::gender(formSpecies()); }
+    inline u8 baseFriendship(void) const override { return Personal<Generation::FIVE>::baseFriendship(formSpecies()); }
+    inline u8 expType(void) const override { return Personal<Generation::FIVE>::expType(formSpecies()); }
+    inline u8 abilities(u8 n) const override { return Personal<Generation::FIVE>::ability(formSpecies(), n); }
+    inline u16 formStatIndex(void) const override { return Personal<Generation::FIVE>::formStatIndex(formSpecies()); }
 };
 
 #endif
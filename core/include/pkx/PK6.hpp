@@ -34,14 +34,12 @@
 class PK6 : public PKX
 {
 protected:
-    void shuffleArray(u8 sv) override;
-    void crypt(void) override;
     void reorderMoves(void) override;
 
 public:
-    PK6() { length = 232; data = new u8[length]; std::fill_n(data, length, 0); }
-    PK6(u8* dt, bool ekx = false, bool party = false);
-    virtual ~PK6() { delete[] data; };
+    PK6() { length = 232; allocate(); std::fill_n(data, length, 0); }
+    PK6(u8* dt, bool ekx = false, bool party = false, bool direct = false);
+    virtual ~PK6() {}
 
     std::shared_ptr<PKX> clone(void) override;
 
@@ -129,6 +127,9 @@ public:
 
     std::string htName(void) const;
     void htName(const std::string& v);
+    // Raw names for comparing against the save's OT name in trade()
+    std::u16string_view htNameView(void) const;
+    std::u16string_view otNameView(void) const;
     u8 htGender(void) const;
     void htGender(u8 v);
     u8 currentHandler(void) const override;
@@ -230,19 +231,19 @@ public:
     std::shared_ptr<PKX> next(void) const override;
     std::shared_ptr<PKX> previous(void) const override;
 
-    inline u8 baseHP(void) const override { return PersonalXYORAS::baseHP(formSpecies()); }
-    inline u8 baseAtk(void) const override { return PersonalXYORAS::baseAtk(formSpecies()); }
-    inline u8 baseDef(void) const override { return PersonalXYORAS::baseDef(formSpecies()); }
-    inline u8 baseSpe(void) const override { return PersonalXYORAS::baseSpe(formSpecies()); }
-    inline u8 baseSpa(void) const override { return PersonalXYORAS::baseSpa(formSpecies()); }
-    inline u8 baseSpd(void) const override { return PersonalXYORAS::baseSpd(formSpecies()); }
-    inline u8 type1(void) const override { return PersonalXYORAS::type1(formSpecies()); }
-    inline u8 type2(void) const override { return PersonalXYORAS::type2(formSpecies()); }
-    inline u8 genderType(void) const override { return PersonalXYORAS::gender(formSpecies()); }
-    inline u8 baseFriendship(void) const override { return PersonalXYORAS::baseFriendship(formSpecies()); }
-    inline u8 expType(void) const override { return PersonalXYORAS::expType(formSpecies()); }
-    inline u8 abilities(u8 n) const override { return PersonalXYORAS::ability(formSpecies(), n); }
-    inline u16 formStatIndex(void) const override { return PersonalXYORAS::formStatIndex(formSpecies()); }
+    inline u8 baseHP(void) const override { return Personal<Generation::SIX>::baseHP(formSpecies()); }
+    inline u8 baseAtk(void) const override { return Personal<Generation::SIX>::baseAtk(formSpecies()); }
+    inline u8 baseDef(void) const override { return Personal<Generation::SIX>::baseDef(formSpecies()); }
+    inline u8 baseSpe(void) const override { return Personal<Generation::SIX>::baseSpe(formSpecies()); }
+    inline u8 baseSpa(void) const override { return Personal<Generation::SIX>::baseSpa(formSpecies()); }
+    inline u8 baseSpd(void) const override { return Personal<Generation::SIX>::baseSpd(formSpecies()); }
+    inline u8 type1(void) const override { return Personal<Generation::SIX>::type1(formSpecies()); }
+    inline u8 type2(void) const override { return Personal<Generation::SIX>::type2(formSpecies()); }
+    inline u8 genderType(void) const override { return Personal<Generation::SIX>::gender(formSpecies()); }
+    inline u8 baseFriendship(void) const override { return Personal<Generation::SIX>::baseFriendship(formSpecies()); }
+    inline u8 expType(void) const override { return Personal<Generation::SIX>::expType(formSpecies()); }
+    inline u8 abilities(u8 n) const override { return Personal<Generation::SIX>::ability(formSpecies(), n); }
+    inline u16 formStatIndex(void) const override { return Personal<Generation::SIX>::formStatIndex(formSpecies()); }
 };
 
 #endif
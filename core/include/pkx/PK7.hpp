@@ -35,14 +35,12 @@ class PK7 : public PKX
 protected:
     static constexpr u16 hyperTrainLookup[6] = {0, 1, 2, 5, 3, 4};
 
-    void shuffleArray(u8 sv) override;
-    void crypt(void) override;
     void reorderMoves(void) override;
 
 public:
-    PK7() { length = 232; data = new u8[length]; std::fill_n(data, length, 0); }
-    PK7(u8* dt, bool ekx = false, bool party = false);
-    virtual ~PK7() { delete[] data; };
+    PK7() { length = 232; allocate(); std::fill_n(data, length, 0); }
+    PK7(u8* dt, bool ekx = false, bool party = false, bool direct = false);
+    virtual ~PK7() {}
 
     std::shared_ptr<PKX> clone(void) override;
 
@@ -118,6 +116,9 @@ public:
 
     std::string htName(void) const;
     void htName(const std::string& v);
+    // Raw names for comparing against the save's OT name in trade()
+    std::u16string_view htNameView(void) const;
+    std::u16string_view otNameView(void) const;
     u8 htGender(void) const;
     void htGender(u8 v);
     u8 currentHandler(void) const override;
@@ -209,6 +210,7 @@ public:
     void shiny(bool v) override;
     u16 formSpecies(void) const override;
     u16 stat(const u8 stat) const override;
+    void stats(std::array<u16, 6>& out) const override;
 
     int partyCurrHP(void) const override;
     void partyCurrHP(u16 v) override;
@@ -219,19 +221,19 @@ public:
     
     std::shared_ptr<PKX> previous(void) const override;
 
-    inline u8 baseHP(void) const override { return PersonalSMUSUM::baseHP(formSpecies()); }
-    inline u8 baseAtk(void) const override { return PersonalSMUSUM::baseAtk(formSpecies()); }
-    inline u8 baseDef(void) const override { return PersonalSMUSUM::baseDef(formSpecies()); }
-    inline u8 baseSpe(void) const override { return PersonalSMUSUM::baseSpe(formSpecies()); }
-    inline u8 baseSpa(void) const override { return PersonalSMUSUM::baseSpa(formSpecies()); }
-    inline u8 baseSpd(void) const override { return PersonalSMUSUM::baseSpd(formSpecies()); }
-    inline u8 type1(void) const override { return PersonalSMUSUM::type1(formSpecies()); }
-    inline u8 type2(void) const override { return PersonalSMUSUM::type2(formSpecies()); }
-    inline u8 genderType(void) const override { return PersonalSMUSUM::gender(formSpecies()); }
-    inline u8 baseFriendship(void) const override { return PersonalSMUSUM::baseFriendship(formSpecies()); }
-    inline u8 expType(void) const override { return PersonalSMUSUM::expType(formSpecies()); }
-    inline u8 abilities(u8 n) const override { return PersonalSMUSUM::ability(formSpecies(), n); }
-    inline u16 formStatIndex(void) const override { return PersonalSMUSUM::formStatIndex(formSpecies()); }
+    inline u8 baseHP(void) const override { return Personal<Generation::SEVEN>::baseHP(formSpecies()); }
+    inline u8 baseAtk(void) const override { return Personal<Generation::SEVEN>::baseAtk(formSpecies()); }
+    inline u8 baseDef(void) const override { return Personal<Generation::SEVEN>::baseDef(formSpecies()); }
+    inline u8 baseSpe(void) const override { return Personal<Generation::SEVEN>::baseSpe(formSpecies()); }
+    inline u8 baseSpa(void) const override { return Personal<Generation::SEVEN>::baseSpa(formSpecies()); }
+    inline u8 baseSpd(void) const override { return Personal<Generation::SEVEN>::baseSpd(formSpecies()); }
+    inline u8 type1(void) const override { return Personal<Generation::SEVEN>::type1(formSpecies()); }
+    inline u8 type2(void) const override { return Personal<Generation::SEVEN>::type2(formSpecies()); }
+    inline u8 genderType(void) const override { return Personal<Generation::SEVEN>::gender(formSpecies()); }
+    inline u8 baseFriendship(void) const override { return Personal<Generation::SEVEN>::baseFriendship(formSpecies()); }
+    inline u8 expType(void) const override { return Personal<Generation::SEVEN>::expType(formSpecies()); }
+    inline u8 abilities(u8 n) const override { return Personal<Generation::SEVEN>::ability(formSpecies(), n); }
+    inline u16 formStatIndex(void) const override { return Personal<Generation::SEVEN>::formStatIndex(formSpecies()); }
 };
 
 #endif
@@ -0,0 +1,121 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef PKFILTER_HPP
+#define PKFILTER_HPP
+
+#include "generation.hpp"
+#include "types.h"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+// A conjunction of field comparisons, compiled into per-generation tests on the stored, decrypted
+// bytes of a slot so that scans don't have to construct PKX objects
+class PKFilter
+{
+public:
+    enum class Field : u8
+    {
+        Species,
+        Form,
+        HeldItem,
+        TID,
+        SID,
+        PID,
+        Nature,
+        Gender,
+        Ability,
+        Ball,
+        Version,
+        Shiny,
+        Egg,
+        IVHP,
+        IVAtk,
+        IVDef,
+        IVSpe,
+        IVSpA,
+        IVSpD,
+        IVTotal,
+        Move // Matches if any of the four moves compares true
+    };
+
+    enum class Op : u8
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    // An empty filter matches every occupied slot
+    PKFilter();
+    PKFilter& where(Field field, Op op, u32 value);
+    PKFilter& where(Field field, u32 value) { return where(field, Op::Equal, value); }
+    // Restricts matches to slots of one generation
+    PKFilter& generation(Generation gen);
+
+    // Terms are joined by '&' and are either "field op value" or a flag that may be negated with '!',
+    // e.g. "species=25 & shiny & iv.spe>=31 & !egg". Values are decimal or 0x-prefixed hex
+    static std::optional<PKFilter> parse(const std::string& text);
+
+    // data is a stored, decrypted slot of the given generation
+    bool matches(Generation gen, const u8* data) const;
+
+private:
+    enum class Read : u8
+    {
+        U8,
+        U16,
+        U32,
+        Gen4Nature, // PID % 25
+        Gen4Ball,   // The larger of the two ball bytes
+        Shiny,      // shift holds the shiny threshold's bit count
+        IVTotal,
+        AnyMove
+    };
+    struct Test
+    {
+        u16 offset;
+        u8 shift;
+        Read read;
+        u32 mask;
+        Op op = Op::Equal;
+        u32 value = 0;
+    };
+    static std::optional<Test> compile(Generation gen, Field field);
+    static bool compare(u32 lhs, Op op, u32 rhs);
+    static bool passes(const Test& test, const u8* data);
+
+    // Indexed by Generation value; a generation that can't match has no entry
+    std::array<std::optional<std::vector<Test>>, 5> tests;
+};
+
+#endif
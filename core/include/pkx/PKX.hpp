@@ -28,9 +28,12 @@
 #define PKX_HPP
 
 #include <algorithm>
+#include <array>
 #include <memory>
+#include <optional>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 #include "types.h"
 #include "personal.hpp"
@@ -38,29 +41,111 @@
 #include "generation.hpp"
 #include "Item.hpp"
 #include "random.hpp"
+#include "slab.hpp"
 
 class PKX
 {
 protected:
-    u32 expTable(u8 row, u8 col) const;
-    u8 blockPosition(u8 index) const;
-    u8 blockPositionInvert(u8 index) const;
-    u32 seedStep(u32 seed);
+    // Experience needed for level row + 1 in growth rate col
+    static u32 expTable(u8 row, u8 col);
+    // Binary searches the growth rate's thresholds
+    static u8 levelFromExp(u8 expType, u32 exp);
+    // The stat formula for all six stats at once; ivs already account for hyper training
+    void calcStats(std::array<u16, 6>& out, const u8* ivs, const u8* evs) const;
+    // A PID for this Pokemon's species, form, origin and IDs with the given traits, or the current
+    // PID if no PID has them all
+    u32 matchingPID(u8 gender, u8 nature, u8 abilityNum, bool shiny) const;
+    static u8 blockPosition(u8 index);
+    static u8 blockPositionInvert(u8 index);
+    static u32 seedStep(u32 seed);
     virtual void reorderMoves(void);
 
-    virtual void crypt(void) = 0;
-    virtual void shuffleArray(u8 sv) = 0;
-
     u32 length = 0;
 
-    u8* data;
+    u8* data = nullptr;
+    // Set for views, which read and write another buffer in place and don't own data
+    bool directAccess = false;
+    // Set when data shares one block with the object and its control block, as create() lays them out
+    bool inlinePayload = false;
+
+    // The longest payload of any generation (a Gen 6/7 party entry or a PB7)
+    static constexpr u32 MAX_LENGTH = 260;
+    // Room for a payload right after the block create() is constructing an object in; taken by allocate()
+    static thread_local u8* reservedPayload;
+
+    // Owned payloads come from the block create() reserved or otherwise from the slab, and are freed with
+    // the object; views keep no payload
+    void allocate(void)
+    {
+        if (reservedPayload && length <= MAX_LENGTH)
+        {
+            data = reservedPayload;
+            inlinePayload = true;
+        }
+        else
+        {
+            data = (u8*)Slab::allocate(length);
+        }
+        reservedPayload = nullptr;
+    }
+
+    // Allocates the shared_ptr control block, the object and room for its payload as one slab block
+    template <typename T>
+    struct PayloadAllocator
+    {
+        using value_type = T;
+
+        PayloadAllocator() = default;
+        template <typename U>
+        PayloadAllocator(const PayloadAllocator<U>&) {}
+
+        T* allocate(size_t n)
+        {
+            u8* block = (u8*)Slab::allocate(n * sizeof(T) + MAX_LENGTH);
+            reservedPayload = block + n * sizeof(T);
+            return (T*)block;
+        }
+        void deallocate(T* ptr, size_t n) { Slab::deallocate(ptr, n * sizeof(T) + MAX_LENGTH); }
+
+        template <typename U>
+        bool operator==(const PayloadAllocator<U>&) const { return true; }
+        template <typename U>
+        bool operator!=(const PayloadAllocator<U>&) const { return false; }
+    };
 
 public:
+    // XORs len bytes (a multiple of 2) with the keystream of the LCG starting at seed
+    static void cryptStream(u8* buf, u32 len, u32 seed);
+    // Decrypts or encrypts count stored entries of a generation in place; entries are stride bytes
+    // long and back to back, and stride may include party data after the boxed part (LGPE)
+    static void cryptBoxes(Generation gen, u8* base, size_t count, size_t stride, bool decrypt);
+
     virtual u8* rawData(void) { return data; }
+    bool isView(void) const { return directAccess; }
+    // Owning copy that stays valid when the viewed slot is overwritten
+    std::shared_ptr<PKX> materialize(void) { return clone(); }
     void decrypt(void);
     void encrypt(void);
     virtual std::shared_ptr<PKX> clone(void) = 0;
-    virtual ~PKX() { };
+    // Like std::make_shared, but the control block, the object and its payload are one slab block, so
+    // an owning PKX costs a single allocation. A view leaves the payload room unused
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> create(Args&&... args)
+    {
+        std::shared_ptr<T> ret = std::allocate_shared<T>(PayloadAllocator<T>(), std::forward<Args>(args)...);
+        reservedPayload = nullptr;
+        return ret;
+    }
+    PKX() {}
+    PKX(const PKX&) = delete;
+    PKX& operator=(const PKX&) = delete;
+    virtual ~PKX()
+    {
+        if (!directAccess && !inlinePayload)
+        {
+            Slab::deallocate(data, length);
+        }
+    }
 
     virtual Generation generation(void) const = 0;
     bool gen7(void) const;
@@ -71,6 +156,29 @@ public:
     int genNumber(void) const;
     void fixMoves(void);
 
+    enum class Shininess : u8
+    {
+        Any,
+        Shiny,
+        NotShiny
+    };
+    struct PIDSpec
+    {
+        u16 species;
+        u8 gender;
+        u8 originGame;
+        u8 nature;
+        u8 form;
+        u8 abilityNum;
+        Generation gen;
+        Shininess shiny = Shininess::Any;
+        u16 TID = 0;
+        u16 SID = 0;
+    };
+    // Builds a PID satisfying the spec rather than drawing until one fits; empty if no PID can
+    static std::optional<u32> generatePID(const PIDSpec& spec);
+    // Empty if no PID satisfies the spec
+    static std::vector<u32> generatePIDs(const PIDSpec& spec, size_t count);
     static u32 getRandomPID(u16 species, u8 gender, u8 originGame, u8 nature, u8 form, u8 abilityNum, u32 oldPid, Generation gen);
 
     // BLOCK A
@@ -190,6 +298,8 @@ public:
     virtual void shiny(bool v) = 0;
     virtual u16 formSpecies(void) const = 0;
     virtual u16 stat(const u8 stat) const = 0;
+    // All six stats in stat() order, reading level, nature and base stats once
+    virtual void stats(std::array<u16, 6>& out) const;
 
     // Hehehehe... to be done
     // virtual u8 sleepTurns(void) const = 0;
@@ -0,0 +1,77 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+#ifndef PKXVIEW_HPP
+#define PKXVIEW_HPP
+
+#include <new>
+#include <type_traits>
+#include "PB7.hpp"
+#include "PK4.hpp"
+#include "PK5.hpp"
+#include "PK6.hpp"
+#include "PK7.hpp"
+
+// Caller-owned room for one PKX of any generation, so a view over a save or bank slot can live on
+// the stack. Building a new one destroys the last, so a loop can reuse a single PKXView
+class PKXView
+{
+public:
+    PKXView() {}
+    PKXView(const PKXView&) = delete;
+    PKXView& operator=(const PKXView&) = delete;
+    ~PKXView() { reset(); }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args)
+    {
+        static_assert(sizeof(T) <= sizeof(storage) && alignof(T) <= alignof(Storage), "PKXView storage is too small");
+        reset();
+        T* ret = new (&storage) T(std::forward<Args>(args)...);
+        pkm = ret;
+        return *ret;
+    }
+    void reset(void)
+    {
+        if (pkm)
+        {
+            pkm->~PKX();
+            pkm = nullptr;
+        }
+    }
+
+    PKX* get(void) const { return pkm; }
+    PKX& operator*(void) const { return *pkm; }
+    PKX* operator->(void) const { return pkm; }
+    explicit operator bool(void) const { return pkm != nullptr; }
+
+private:
+    using Storage = std::aligned_union_t<0, PK4, PK5, PK6, PK7, PB7>;
+    Storage storage;
+    PKX* pkm = nullptr;
+};
+
+#endif
@@ -0,0 +1,45 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include "types.h"
+#include <array>
+
+// Experience and stat formulas shared by every generation, kept apart from PKX so they build on their own
+namespace Stats
+{
+    // Experience needed for level row + 1 in growth rate col
+    u32 expTable(u8 row, u8 col);
+    // Binary searches the growth rate's thresholds
+    u8 levelFromExp(u8 expType, u32 exp);
+    // The stat formula for all six stats at once, in PKX::stat() order; ivs already account for hyper training
+    void calc(std::array<u16, 6>& out, const u8* bases, const u8* ivs, const u8* evs, u8 level, u8 nature);
+}
+
+#endif
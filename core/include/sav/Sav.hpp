@@ -27,8 +27,11 @@
 #ifndef SAV_HPP
 #define SAV_HPP
 
+#include <algorithm>
+#include <bitset>
 #include <memory>
 #include <stdint.h>
+#include "PKFilter.hpp"
 #include "PKX.hpp"
 #include "WCX.hpp"
 #include "utils.hpp"
@@ -52,6 +55,8 @@ enum Pouch
     ZCrystals
 };
 
+class PKXView;
+
 class Sav
 {
 protected:
@@ -96,18 +101,55 @@ protected:
     u8* data;
     u32 length = 0;
     Game game;
+    // One bit per checksummed block; resign() only recomputes the blocks written since the last resign
+    std::bitset<128> dirtyBlocks;
+    // Set by cryptBoxData(true), cleared by cryptBoxData(false)
+    bool decryptedBoxes = false;
+
+    // Flags every block of a sorted offset/length table that overlaps [offset, offset + size)
+    template <typename Len, size_t N>
+    void markBlocks(const u32 (&ofs)[N], const Len (&len)[N], u32 offset, u32 size)
+    {
+        size_t i = std::upper_bound(ofs, ofs + N, offset) - ofs;
+        if (i > 0 && ofs[i - 1] + len[i - 1] > offset)
+        {
+            dirtyBlocks.set(i - 1);
+        }
+        for (; i < N && ofs[i] < offset + size; i++)
+        {
+            dirtyBlocks.set(i);
+        }
+    }
     static u16 ccitt16(const u8* buf, u32 len);
-    static std::unique_ptr<Sav> checkDSType(u8* dt);
-    static bool validSequence(u8* dt, u8* pattern, int shift = 0);
+    static bool validSequence(const u8* dt, const u8* pattern, int shift = 0);
 
 public:
     u8 boxes = 0;
 
     virtual ~Sav();
     virtual void resign(void) = 0;
-
-    static bool isValidDSSave(u8* dt);
-    static std::unique_ptr<Sav> getSave(u8* dt, size_t length);
+    // Must be called after writing to data outside of the setters below
+    virtual void markDirty(u32 offset, u32 size = 1) = 0;
+    void markAllDirty(void) { dirtyBlocks.set(); }
+
+    // What a 0x80000 DS save turned out to be
+    struct DSSaveInfo
+    {
+        bool valid = false;
+        // Only meaningful if valid
+        Game game = Game::DP;
+        // Gen 4 only: 0 or 0x40000, the partitions holding the current general and storage blocks by their
+        // save counters, as Sav4 picks them
+        u32 generalPartition = 0;
+        u32 storagePartition = 0;
+    };
+    // Checks the Gen 5 checksums, then the Gen 4 block identifiers of both partitions, stopping at the first
+    // match. Cheap enough to run on every load: two checksums and at most six 10-byte comparisons
+    static DSSaveInfo detectDSSave(const u8* dt);
+    // Takes ownership of dt, which the save then works in directly; it may be larger than length
+    static std::unique_ptr<Sav> getSave(std::unique_ptr<u8[]> dt, size_t length);
+    // Same, for a DS save that detectDSSave has already been run on
+    static std::unique_ptr<Sav> getSave(std::unique_ptr<u8[]> dt, const DSSaveInfo& info);
 
     virtual u16 TID(void) const = 0;
     virtual void TID(u16 v) = 0;
@@ -151,6 +193,9 @@ public:
     virtual void pkm(std::shared_ptr<PKX> pk, u8 slot) = 0;
     virtual std::shared_ptr<PKX> pkm(u8 box, u8 slot, bool ekx = false) const = 0;
     virtual void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) = 0;
+    // Non-owning PKX over a (decrypted) box slot, built in view; call commitView after writing through it
+    virtual PKX& pkmView(PKXView& view, u8 box, u8 slot) = 0;
+    void commitView(u8 box, u8 slot) { markDirty(boxOffset(box, slot), boxOffset(box, slot + 1) - boxOffset(box, slot)); }
     void transfer(std::shared_ptr<PKX> &pk);
     virtual void trade(std::shared_ptr<PKX> pk) = 0; // Look into bank boolean parameter
     virtual std::shared_ptr<PKX> emptyPkm() const = 0;
@@ -163,6 +208,10 @@ public:
     virtual std::unique_ptr<WCX> mysteryGift(int pos) const = 0;
     virtual void mysteryGift(WCX& wc, int& pos) = 0;
     virtual void cryptBoxData(bool crypted) = 0;
+    bool boxesDecrypted(void) const { return decryptedBoxes; }
+    // Bitmask of the slots in a box whose stored contents match the filter; works on encrypted boxes
+    // too, decrypting slot by slot into scratch space. Only reads, so boxes can be scanned concurrently
+    u32 find(const PKFilter& filter, u8 box) const;
     virtual std::string boxName(u8 box) const = 0;
     virtual void boxName(u8 box, const std::string& name) = 0;
     virtual u8 partyCount(void) const = 0;
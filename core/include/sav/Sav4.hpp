@@ -27,6 +27,7 @@
 #ifndef SAV4_HPP
 #define SAV4_HPP
 
+#include <array>
 #include <vector>
 #include "personal.hpp"
 #include "Sav.hpp"
@@ -37,13 +38,14 @@ class Sav4 : public Sav
 protected:
     int Trainer1;
     int MailItems, PouchBalls, BattleItems;
-    int GBOOffset, SBOOffset;
 
     int gbo = -1;
     int sbo = -1;
 
     void GBO(void);
     void SBO(void);
+    std::array<int, 3> generalBlock(void) const;
+    std::array<int, 3> storageBlock(void) const;
 
     bool checkInsertForm(std::vector<u8> &forms, u8 formNum);
     std::vector<u8> getForms(u16 species);
@@ -53,6 +55,7 @@ protected:
 
 public:
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     u16 TID(void) const override;
     void TID(u16 v) override;
@@ -96,6 +99,7 @@ public:
     // that's because PKSM works with decrypted boxes and
     // crypts them back during resigning
     void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) override;
+    PKX& pkmView(PKXView& view, u8 box, u8 slot) override;
     void pkm(std::shared_ptr<PKX> pk, u8 slot) override;
 
     void trade(std::shared_ptr<PKX> pk) override;
@@ -122,6 +126,10 @@ public:
     int maxItem(void) const { return game == Game::DP ? 464 : game == Game::Pt ? 467 : 536; };
     int maxAbility(void) const { return 123; }
     int maxBall(void) const { return 0x18; }
+    // Offsets of the general and storage block save counters within a partition
+    static std::array<int, 2> counterOffsets(Game game);
+    // 0 or 0x40000: the partition whose copy of the block with its counter at ofs was saved last
+    static int activePartition(const u8* dt, int ofs);
     int getGBO(void) const { return gbo; }
     int getSBO(void) const { return sbo; }
 
@@ -131,7 +139,7 @@ public:
     virtual std::map<Pouch, std::vector<int>> validItems(void) const = 0;
     std::string pouchName(Pouch pouch) const override;
 
-    u8 formCount(u16 species) const override { return PersonalDPPtHGSS::formCount(species); }
+    u8 formCount(u16 species) const override { return Personal<Generation::FOUR>::formCount(species); }
 };
 
 #endif
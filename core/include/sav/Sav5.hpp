@@ -85,6 +85,7 @@ public:
     // that's because PKSM works with decrypted boxes and
     // crypts them back during resigning
     void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) override;
+    PKX& pkmView(PKXView& view, u8 box, u8 slot) override;
     void pkm(std::shared_ptr<PKX> pk, u8 slot) override;
 
     void trade(std::shared_ptr<PKX> pk) override;
@@ -119,7 +120,7 @@ public:
     virtual std::map<Pouch, std::vector<int>> validItems(void) const = 0;
     std::string pouchName(Pouch pouch) const override;
 
-    u8 formCount(u16 species) const override { return PersonalBWB2W2::formCount(species); }
+    u8 formCount(u16 species) const override { return Personal<Generation::FIVE>::formCount(species); }
 };
 
 #endif
@@ -61,6 +61,7 @@ public:
     void language(u8 v) override;
     std::string otName(void) const override;
     void otName(const std::string& v) override;
+    std::u16string_view otNameView(void) const;
     u32 money(void) const override;
     void money(u32 v) override;
     u32 BP(void) const override;
@@ -85,6 +86,7 @@ public:
     // that's because PKSM works with decrypted boxes and
     // crypts them back during resigning
     void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) override;
+    PKX& pkmView(PKXView& view, u8 box, u8 slot) override;
     void pkm(std::shared_ptr<PKX> pk, u8 slot) override;
 
     void trade(std::shared_ptr<PKX> pk) override;
@@ -118,7 +120,7 @@ public:
     virtual std::map<Pouch, std::vector<int>> validItems(void) const = 0;
     std::string pouchName(Pouch pouch) const override;
 
-    u8 formCount(u16 species) const override { return PersonalXYORAS::formCount(species); }
+    u8 formCount(u16 species) const override { return Personal<Generation::SIX>::formCount(species); }
 };
 
 #endif
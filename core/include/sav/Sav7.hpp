@@ -52,7 +52,7 @@ private:
     bool sanitizeFormsToIterate(int species, int& fs, int& fe, int formIn) const;
 
 public:
-    u16 check16(u8* buf, u32 blockID, u32 len) const;
+    u16 check16(const u8* buf, u32 blockID, u32 len) const;
     virtual void resign(void) = 0;
 
     u16 TID(void) const override;
@@ -73,6 +73,7 @@ public:
     void language(u8 v) override;
     std::string otName(void) const override;
     void otName(const std::string& v) override;
+    std::u16string_view otNameView(void) const;
     u32 money(void) const override;
     void money(u32 v) override;
     u32 BP(void) const override;
@@ -98,6 +99,7 @@ public:
     // that's because PKSM works with decrypted boxes and
     // crypts them back during resigning
     void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) override;
+    PKX& pkmView(PKXView& view, u8 box, u8 slot) override;
     void pkm(std::shared_ptr<PKX> pk, u8 slot) override;
 
     void trade(std::shared_ptr<PKX> pk) override;
@@ -131,7 +133,7 @@ public:
     virtual std::map<Pouch, std::vector<int>> validItems(void) const = 0;
     std::string pouchName(Pouch pouch) const override;
 
-    u8 formCount(u16 species) const override { return PersonalSMUSUM::formCount(species); }
+    u8 formCount(u16 species) const override { return Personal<Generation::SEVEN>::formCount(species); }
 };
 
 #endif
@@ -89,10 +89,11 @@ private:
     };
     
 public:
-    SavB2W2(u8* dt);
+    SavB2W2(std::unique_ptr<u8[]> dt);
     virtual ~SavB2W2();
 
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
 
@@ -85,10 +85,11 @@ private:
     };
     
 public:
-    SavBW(u8* dt);
+    SavBW(std::unique_ptr<u8[]> dt);
     virtual ~SavBW();
 
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
    
     std::map<Pouch, std::vector<int>> validItems(void) const override;
     
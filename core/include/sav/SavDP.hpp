@@ -32,7 +32,7 @@
 class SavDP : public Sav4
 {
 public:
-    SavDP(u8* dt);
+    SavDP(std::unique_ptr<u8[]> dt);
     virtual ~SavDP() { };
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
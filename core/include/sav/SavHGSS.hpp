@@ -32,7 +32,7 @@
 class SavHGSS : public Sav4
 {
 public:
-    SavHGSS(u8* dt);
+    SavHGSS(std::unique_ptr<u8[]> dt);
     virtual ~SavHGSS() { };
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
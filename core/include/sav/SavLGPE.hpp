@@ -59,11 +59,12 @@ protected:
     bool sanitizeFormsToIterate(int species, int& fs, int& fe, int formIn) const;
 
 public:
-    SavLGPE(u8* dt);
+    SavLGPE(std::unique_ptr<u8[]> dt, size_t size);
     ~SavLGPE();
 
-    u16 check16(u8* buf, u32 blockID, u32 len) const;
+    u16 check16(const u8* buf, u32 blockID, u32 len) const;
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     u16 boxedPkm(void) const;
     void boxedPkm(u16 v);
@@ -92,6 +93,7 @@ public:
     void language(u8 v) override;
     std::string otName(void) const override;
     void otName(const std::string& v) override;
+    std::u16string_view otNameView(void) const;
     u32 money(void) const override;
     void money(u32 v) override;
     u32 BP(void) const override { return 0; } // TODO
@@ -117,6 +119,7 @@ public:
     // that's because PKSM works with decrypted boxes and
     // crypts them back during resigning
     void pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade) override;
+    PKX& pkmView(PKXView& view, u8 box, u8 slot) override;
     void pkm(std::shared_ptr<PKX> pk, u8 slot) override;
 
     void trade(std::shared_ptr<PKX> pk) override;
@@ -151,7 +154,7 @@ public:
     std::map<Pouch, std::vector<int>> validItems(void) const override;
     std::string pouchName(Pouch pouch) const override;
 
-    u8 formCount(u16 species) const override { return PersonalLGPE::formCount(species); }
+    u8 formCount(u16 species) const override { return Personal<Generation::LGPE>::formCount(species); }
 };
 
 #endif
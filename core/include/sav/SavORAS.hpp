@@ -57,10 +57,11 @@ protected:
     };
     
 public:
-    SavORAS(u8* dt);
+    SavORAS(std::unique_ptr<u8[]> dt);
     virtual ~SavORAS() { };
 
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
 };
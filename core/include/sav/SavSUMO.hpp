@@ -87,10 +87,11 @@ protected:
     int dexFormCount(int species) const override;
 
 public:
-    SavSUMO(u8* dt);
+    SavSUMO(std::unique_ptr<u8[]> dt);
     virtual ~SavSUMO() { };
 
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
 
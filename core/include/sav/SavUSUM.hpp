@@ -89,10 +89,11 @@ protected:
     int dexFormCount(int species) const override;
 
 public:
-    SavUSUM(u8* dt);
+    SavUSUM(std::unique_ptr<u8[]> dt);
     virtual ~SavUSUM() { };
     
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
     
     std::map<Pouch, std::vector<int>> validItems(void) const override;
 
@@ -55,10 +55,11 @@ protected:
     };
     
 public:
-    SavXY(u8* dt);
+    SavXY(std::unique_ptr<u8[]> dt);
     virtual ~SavXY() { };
 
     void resign(void) override;
+    void markDirty(u32 offset, u32 size = 1) override;
 
     std::map<Pouch, std::vector<int>> validItems(void) const override;
 };
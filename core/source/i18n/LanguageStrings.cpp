@@ -25,23 +25,74 @@
 */
 
 #include "LanguageStrings.hpp"
+#include <functional>
 #include <stdio.h>
+#include <string.h>
 
-static nlohmann::json& formJson()
+namespace
 {
-    static nlohmann::json forms;
-    static bool first = true;
-    if (first)
+    // forms.bin, built by common/I18nPacker/packer.py from forms.json. Shared by every language
+    class FormIndex
     {
-        FILE* in = fopen("romfs:/i18n/forms.json", "rt");
-        if (!ferror(in))
+    public:
+        static constexpr size_t GENERATION_COUNT = size_t(Generation::LGPE) + 1;
+
+        FormIndex()
         {
-            forms = nlohmann::json::parse(in, nullptr, false);
+            FILE* in = fopen("romfs:/i18n/forms.bin", "rb");
+            if (!in)
+            {
+                return;
+            }
+            fseek(in, 0, SEEK_END);
+            size_t size = ftell(in);
+            fseek(in, 0, SEEK_SET);
+            blob.resize((size + sizeof(u32) - 1) / sizeof(u32));
+            bool ok = fread(blob.data(), 1, size, in) == size;
+            fclose(in);
+
+            const u8* data = (const u8*)blob.data();
+            if (!ok || size < 16 || memcmp(data, "PKSF", 4) || blob[1] != 1 || blob[3] != GENERATION_COUNT ||
+                16 + blob[2] * GENERATION_COUNT * 2 * sizeof(u16) > size)
+            {
+                blob.clear();
+                return;
+            }
+            speciesCount = blob[2];
+            spans = (const u16*)(data + 16);
+            indices = spans + speciesCount * GENERATION_COUNT * 2;
+            indexCount = (data + size - (const u8*)indices) / sizeof(u16);
+        }
+
+        // Index into the forms table of a form's name, or -1 if the species doesn't have that form
+        int index(u16 species, u8 form, Generation generation) const
+        {
+            // Anything that isn't a known generation is treated as Gen 7, as forms.json lookups always did
+            size_t gen = size_t(generation) < GENERATION_COUNT ? size_t(generation) : size_t(Generation::SEVEN);
+            if (species < speciesCount)
+            {
+                const u16* span = spans + (species * GENERATION_COUNT + gen) * 2;
+                if (form < span[1] && span[0] + form < indexCount)
+                {
+                    return indices[span[0] + form];
+                }
+            }
+            return -1;
         }
-        fclose(in);
-        first = false;
+
+    private:
+        std::vector<u32> blob;
+        size_t speciesCount = 0;
+        const u16* spans = nullptr;
+        const u16* indices = nullptr;
+        size_t indexCount = 0;
+    };
+
+    const FormIndex& formIndex()
+    {
+        static const FormIndex index;
+        return index;
     }
-    return forms;
 }
 
 std::string LanguageStrings::folder(Language lang) const
@@ -67,284 +118,254 @@ std::string LanguageStrings::folder(Language lang) const
 
 LanguageStrings::LanguageStrings(Language lang)
 {
-    load(lang, "/abilities.txt", abilities);
-    load(lang, "/balls.txt", balls);
-    load(lang, "/forms.txt", forms);
-    load(lang, "/hp.txt", hps);
-    load(lang, "/items.txt", items);
-    load(lang, "/moves.txt", moves);
-    load(lang, "/natures.txt", natures);
-    load(lang, "/species.txt", speciess);
-    load(lang, "/games.txt", games);
-    loadMap(lang, "/locations4.txt", locations4);
-    loadMap(lang, "/locations5.txt", locations5);
-    loadMap(lang, "/locations6.txt", locations6);
-    loadMap(lang, "/locations7.txt", locations7);
-    loadMap(lang, "/locationsLGPE.txt", locationsLGPE);
-    loadGui(lang);
+    loadStrings(lang);
 }
 
-void LanguageStrings::load(Language lang, const std::string name, std::vector<std::string>& array)
+void LanguageStrings::loadStrings(Language lang)
 {
     static const std::string base = "romfs:/i18n/";
-    std::string path = io::exists(base + folder(lang) + name) ? base + folder(lang) + name : base + folder(Language::EN) + name;
-    
-    std::string tmp;
-    FILE* values = fopen(path.c_str(), "rt");
-    if (ferror(values))
+    std::string path = io::exists(base + folder(lang) + "/strings.bin") ? base + folder(lang) + "/strings.bin" : base + folder(Language::EN) + "/strings.bin";
+
+    FILE* in = fopen(path.c_str(), "rb");
+    if (!in)
     {
-        fclose(values);
         return;
     }
-    char* data = (char*)malloc(128);
-    size_t size = 0;
-    while (!feof(values) && !ferror(values))
-    {
-        size = std::max(size, (size_t)128);
-        if (__getline(&data, &size, values) >= 0)
-        {
-            tmp = std::string(data);
-            tmp = tmp.substr(0, tmp.find('\n'));
-            array.push_back(tmp.substr(0, tmp.find('\r')));
-        }
-        else
-        {
-            break;
-        }
-    }
-    fclose(values);
-    free(data);
-}
+    fseek(in, 0, SEEK_END);
+    size_t size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    // Stored as u32s so that the offset tables can be read in place
+    blob.resize((size + sizeof(u32) - 1) / sizeof(u32));
+    bool ok = fread(blob.data(), 1, size, in) == size;
+    fclose(in);
 
-void LanguageStrings::loadMap(Language lang, const std::string name, std::map<u16, std::string>& map)
-{
-    static const std::string base = "romfs:/i18n/";
-    std::string path = io::exists(base + folder(lang) + name) ? base + folder(lang) + name : base + folder(Language::EN) + name;
-
-    std::string tmp;
-    FILE* values = fopen(path.c_str(), "rt");
-    if (ferror(values))
+    const u8* data = (const u8*)blob.data();
+    if (!ok || size < 12 || memcmp(data, "PKSI", 4) || blob[1] != 3 || blob[2] != TABLE_COUNT || size < 12 + 16 * TABLE_COUNT)
     {
-        fclose(values);
+        blob.clear();
         return;
     }
-    char* data = (char*)malloc(128);
-    size_t size = 0;
-    while (!feof(values) && !ferror(values))
+    for (size_t i = 0; i < TABLE_COUNT; i++)
     {
-        size = std::max(size, (size_t)128);
-        if (__getline(&data, &size, values) >= 0)
+        const u32* header = blob.data() + 3 + 4 * i;
+        if (header[1] + (header[0] + 1) * sizeof(u32) > size || header[2] + header[0] * (i == GUI ? sizeof(u32) : sizeof(u16)) > size || header[3] + sizeof(u32) > size)
         {
-            tmp = std::string(data);
-            tmp = tmp.substr(0, tmp.find('\n'));
-            u16 val = std::stoi(tmp.substr(0, 4), 0, 16);
-            map[val] = tmp.substr(0, tmp.find('\r')).substr(5);
+            blob.clear();
+            tables = {};
+            return;
         }
-        else
+        tables[i].count = header[0];
+        tables[i].offsets = (const u32*)(data + header[1]);
+        tables[i].ids = header[2] ? (const u16*)(data + header[2]) : nullptr;
+        if (i == GUI && header[2] && header[3])
         {
-            break;
+            u32 bucketCount = *(const u32*)(data + header[3]);
+            // The key names follow their hashes, so that a hash hit can be confirmed
+            const u32* names = (const u32*)(data + header[2]) + header[0];
+            if (header[3] + sizeof(u32) + bucketCount * sizeof(u16) > size || bucketCount <= header[0] || (bucketCount & (bucketCount - 1)) ||
+                header[2] + (2 * header[0] + 1) * sizeof(u32) > size || names[header[0]] > size ||
+                std::adjacent_find(names, names + header[0] + 1, std::greater_equal<u32>()) != names + header[0] + 1)
+            {
+                blob.clear();
+                tables = {};
+                return;
+            }
+            guiKeys = (const u32*)(data + header[2]);
+            guiNames = names;
+            guiBuckets = (const u16*)(data + header[3] + sizeof(u32));
+            guiBucketMask = bucketCount - 1;
         }
     }
-    fclose(values);
-    free(data);
+
+    gui.reserve(tables[GUI].count);
+    for (size_t i = 0; i < tables[GUI].count; i++)
+    {
+        gui.emplace_back(string(GUI, i));
+    }
 }
 
-void LanguageStrings::loadGui(Language lang)
+std::string_view LanguageStrings::string(Table table, size_t index) const
 {
-    static const std::string base = "romfs:/i18n/";
-    std::string path = io::exists(base + folder(lang) + "/gui.json") ? base + folder(lang) + "/gui.json" : base + folder(Language::EN) + "/gui.json";
+    const u32* offsets = tables[table].offsets;
+    return std::string_view((const char*)blob.data() + offsets[index], offsets[index + 1] - offsets[index] - 1);
+}
 
-    FILE* values = fopen(path.c_str(), "rt");
-    gui = nlohmann::json::parse(values, nullptr, false);
-    fclose(values);
+size_t LanguageStrings::find(Table table, u16 id) const
+{
+    const StringTable& strings = tables[table];
+    const u16* found = std::lower_bound(strings.ids, strings.ids + strings.count, id);
+    return found != strings.ids + strings.count && *found == id ? found - strings.ids : strings.count;
 }
 
-const std::string& LanguageStrings::ability(u8 v) const
+std::string_view LanguageStrings::ability(u8 v) const
 {
-    return v < abilities.size() ? abilities.at(v) : localize("INVALID_ABILITY");
+    return v < tables[ABILITIES].count ? string(ABILITIES, v) : localize("INVALID_ABILITY");
 }
 
-const std::string& LanguageStrings::ball(u8 v) const
+std::string_view LanguageStrings::ball(u8 v) const
 {
-    return v < balls.size() ? balls.at(v) : localize("INVALID_BALL");
+    return v < tables[BALLS].count ? string(BALLS, v) : localize("INVALID_BALL");
 }
 
-const std::string& LanguageStrings::form(u16 species, u8 form, Generation generation) const
+std::string_view LanguageStrings::form(u16 species, u8 form, Generation generation) const
 {
-    std::string sSpecies = std::to_string((int)species);
-    if (!formJson().contains(sSpecies))
+    int index = formIndex().index(species, form, generation);
+    if (index >= 0 && (size_t)index < tables[FORMS].count)
     {
-        // Not sure how the json sorts it, so just do a linear search. Aren't that many (only 44) anyways
-        for (int i : formJson()["megas"])
-        {
-            if (i == species)
-            {
-                if (form == 1)
-                {
-                    return forms.at(146);
-                }
-                else if (form == 0)
-                {
-                    return forms.at(0);
-                }
-                else
-                {
-                    return localize("INVALID_FORM");
-                }
-            }
-        }
-    }
-    else
-    {
-        std::vector<int> formIndices;
-        if (formJson()[sSpecies].is_object())
-        {
-            if (formJson()[sSpecies].find(genToString(generation)) != formJson()[sSpecies].end())
-            {
-                formIndices = formJson()[sSpecies][genToString(generation)].get<std::vector<int>>();
-            }
-        }
-        else
-        {
-            formIndices = formJson()[sSpecies].get<std::vector<int>>();
-        }
-
-        if (form < formIndices.size())
-        {
-            size_t formNameIndex = formIndices[form];
-            if (formNameIndex < forms.size())
-            {
-                return forms.at(formNameIndex);
-            }
-        }
+        return string(FORMS, index);
     }
     return localize("INVALID_FORM");
 }
 
-const std::string& LanguageStrings::hp(u8 v) const
+std::string_view LanguageStrings::hp(u8 v) const
 {
-    return v < hps.size() ? hps.at(v) : localize("INVALID_HP");
+    return v < tables[HPS].count ? string(HPS, v) : localize("INVALID_HP");
 }
 
-const std::string& LanguageStrings::item(u16 v) const
+std::string_view LanguageStrings::item(u16 v) const
 {
-    return v < items.size() ? items.at(v) : localize("INVALID_ITEM");
+    return v < tables[ITEMS].count ? string(ITEMS, v) : localize("INVALID_ITEM");
 }
 
-const std::string& LanguageStrings::move(u16 v) const
+std::string_view LanguageStrings::move(u16 v) const
 {
-    return v < moves.size() ? moves.at(v) : localize("INVALID_MOVE");
+    return v < tables[MOVES].count ? string(MOVES, v) : localize("INVALID_MOVE");
 }
 
-const std::string& LanguageStrings::nature(u8 v) const
+std::string_view LanguageStrings::nature(u8 v) const
 {
-    return v < natures.size() ? natures.at(v) : localize("INVALID_NATURE");
+    return v < tables[NATURES].count ? string(NATURES, v) : localize("INVALID_NATURE");
 }
 
-const std::string& LanguageStrings::species(u16 v) const
+std::string_view LanguageStrings::species(u16 v) const
 {
-    return v < speciess.size() ? speciess.at(v) : localize("INVALID_SPECIES");
+    return v < tables[SPECIES].count ? string(SPECIES, v) : localize("INVALID_SPECIES");
 }
 
-const std::string& LanguageStrings::localize(const std::string& v) const
+const std::string& LanguageStrings::localize(u32 key, std::string_view v) const
 {
     static std::string MISSING = "MISSING: ";
     if (MISSING != "MISSING: ")
     {
         MISSING = "MISSING: ";
     }
-    if (gui.count(v))
+    if (guiBuckets)
     {
-        return gui.at(v).get_ref<const std::string&>();
-    }
-    else
-    {
-        MISSING += v;
-        return MISSING;
+        for (u32 slot = key & guiBucketMask; guiBuckets[slot] != 0; slot = (slot + 1) & guiBucketMask)
+        {
+            u32 index = guiBuckets[slot] - 1;
+            // An unknown key can share its hash with a known one
+            if (guiKeys[index] == key &&
+                std::string_view((const char*)blob.data() + guiNames[index], guiNames[index + 1] - guiNames[index] - 1) == v)
+            {
+                return gui[index];
+            }
+        }
     }
+    MISSING += v;
+    return MISSING;
 }
 
-const std::vector<std::string>& LanguageStrings::rawItems() const
+std::vector<std::string_view> LanguageStrings::rawItems() const
 {
-    return items;
+    std::vector<std::string_view> ret;
+    ret.reserve(tables[ITEMS].count);
+    for (size_t i = 0; i < tables[ITEMS].count; i++)
+    {
+        ret.push_back(string(ITEMS, i));
+    }
+    return ret;
 }
 
-const std::vector<std::string>& LanguageStrings::rawMoves() const
+std::vector<std::string_view> LanguageStrings::rawMoves() const
 {
-    return moves;
+    std::vector<std::string_view> ret;
+    ret.reserve(tables[MOVES].count);
+    for (size_t i = 0; i < tables[MOVES].count; i++)
+    {
+        ret.push_back(string(MOVES, i));
+    }
+    return ret;
 }
 
-const std::string& LanguageStrings::location(u16 v, Generation generation) const
+LanguageStrings::Table LanguageStrings::locationTable(Generation generation) const
 {
-    std::map<u16, std::string>::const_iterator i;
     switch (generation)
     {
         case Generation::FOUR:
-            if ((i = locations4.find(v)) != locations4.end())
-            {
-                return i->second;
-            }
-            break;
+            return LOCATIONS4;
         case Generation::FIVE:
-            if ((i = locations5.find(v)) != locations5.end())
-            {
-                return i->second;
-            }
-            break;
+            return LOCATIONS5;
         case Generation::SIX:
-            if ((i = locations6.find(v)) != locations6.end())
-            {
-                return i->second;
-            }
-            break;
+            return LOCATIONS6;
         case Generation::SEVEN:
-            if ((i = locations7.find(v)) != locations7.end())
-            {
-                return i->second;
-            }
-            break;
+            return LOCATIONS7;
         case Generation::LGPE:
-            if ((i = locationsLGPE.find(v)) != locationsLGPE.end())
-            {
-                return i->second;
-            }
-            break;
+            return LOCATIONSLGPE;
         default:
-            break;
+            return TABLE_COUNT;
+    }
+}
+
+std::string_view LanguageStrings::location(u16 v, Generation generation) const
+{
+    Table table = locationTable(generation);
+    if (table != TABLE_COUNT)
+    {
+        size_t index = find(table, v);
+        if (index < tables[table].count)
+        {
+            return string(table, index);
+        }
     }
     return localize("INVALID_LOCATION");
 }
 
-const std::string& LanguageStrings::game(u8 v) const
+std::string_view LanguageStrings::game(u8 v) const
 {
-    if (v < games.size() && games.at(v) != "")
+    if (v < tables[GAMES].count && !string(GAMES, v).empty())
     {
-        return games.at(v);
+        return string(GAMES, v);
     }
     return localize("INVALID_GAME");
 }
 
-const std::map<u16, std::string>& LanguageStrings::locations(Generation g) const
+std::vector<std::pair<u16, std::string_view>> LanguageStrings::locations(Generation g) const
 {
-    static std::map<u16, std::string> emptyMap;
-    switch (g)
+    std::vector<std::pair<u16, std::string_view>> ret;
+    Table table = locationTable(g);
+    if (table != TABLE_COUNT)
     {
-        case Generation::FOUR:
-            return locations4;
-        case Generation::FIVE:
-            return locations5;
-        case Generation::SIX:
-            return locations6;
-        case Generation::SEVEN:
-            return locations7;
-        case Generation::LGPE:
-            return locationsLGPE;
-        default:
-            return emptyMap;
+        ret.reserve(tables[table].count);
+        for (size_t i = 0; i < tables[table].count; i++)
+        {
+            ret.emplace_back(tables[table].ids[i], string(table, i));
+        }
+    }
+    return ret;
+}
+
+const SearchIndex& LanguageStrings::searchIndex(Table table) const
+{
+    static const SearchIndex empty{std::vector<std::string_view>{}};
+    if (table == TABLE_COUNT)
+    {
+        return empty;
+    }
+    if (!searchIndexes[table])
+    {
+        std::vector<std::string_view> names;
+        names.reserve(tables[table].count);
+        for (size_t i = 0; i < tables[table].count; i++)
+        {
+            names.push_back(string(table, i));
+        }
+        searchIndexes[table] = std::make_unique<SearchIndex>(names);
     }
+    return *searchIndexes[table];
 }
 
 size_t LanguageStrings::numGameStrings() const
 {
-    return games.size();
+    return tables[GAMES].count;
 }
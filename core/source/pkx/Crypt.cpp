@@ -0,0 +1,175 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "Crypt.hpp"
+#include <algorithm>
+
+u8 Crypt::blockPosition(u8 index)
+{
+    static constexpr u8 blocks[128] =
+    {
+        0, 1, 2, 3,
+        0, 1, 3, 2,
+        0, 2, 1, 3,
+        0, 3, 1, 2,
+        0, 2, 3, 1,
+        0, 3, 2, 1,
+        1, 0, 2, 3,
+        1, 0, 3, 2,
+        2, 0, 1, 3,
+        3, 0, 1, 2,
+        2, 0, 3, 1,
+        3, 0, 2, 1,
+        1, 2, 0, 3,
+        1, 3, 0, 2,
+        2, 1, 0, 3,
+        3, 1, 0, 2,
+        2, 3, 0, 1,
+        3, 2, 0, 1,
+        1, 2, 3, 0,
+        1, 3, 2, 0,
+        2, 1, 3, 0,
+        3, 1, 2, 0,
+        2, 3, 1, 0,
+        3, 2, 1, 0,
+
+        // duplicates of 0-7 to eliminate modulus
+        0, 1, 2, 3,
+        0, 1, 3, 2,
+        0, 2, 1, 3,
+        0, 3, 1, 2,
+        0, 2, 3, 1,
+        0, 3, 2, 1,
+        1, 0, 2, 3,
+        1, 0, 3, 2,
+    };
+
+    return blocks[index];
+}
+
+u8 Crypt::blockPositionInvert(u8 index)
+{
+    static constexpr u8 blocks[32] =
+    {
+        0, 1, 2, 4, 3, 5, 6, 7, 12, 18, 13, 19, 8, 10, 14, 20, 16, 22, 9, 11, 15, 21, 17, 23,
+        0, 1, 2, 4, 3, 5, 6, 7, // duplicates of 0-7 to eliminate modulus
+    };
+
+    return blocks[index];
+}
+
+u32 Crypt::seedStep(u32 seed) { return seed * 0x41C64E6D + 0x6073; }
+
+namespace
+{
+    // Multipliers and increments that advance the LCG by 1 to 4 steps at once, so four
+    // keystream words can be computed from the same seed instead of one after another
+    struct LCGJump
+    {
+        u32 mul[4];
+        u32 add[4];
+        constexpr LCGJump() : mul(), add()
+        {
+            mul[0] = 0x41C64E6D;
+            add[0] = 0x6073;
+            for (int i = 1; i < 4; i++)
+            {
+                mul[i] = mul[i - 1] * mul[0];
+                add[i] = add[i - 1] * mul[0] + add[0];
+            }
+        }
+    };
+
+    constexpr LCGJump jump;
+}
+
+void Crypt::cryptStream(u8* buf, u32 len, u32 seed)
+{
+    u32 i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        u32 s1 = jump.mul[0] * seed + jump.add[0];
+        u32 s2 = jump.mul[1] * seed + jump.add[1];
+        u32 s3 = jump.mul[2] * seed + jump.add[2];
+        u32 s4 = jump.mul[3] * seed + jump.add[3];
+        seed = s4;
+        // Each step yields its high half-word; pack two of them per 32-bit XOR
+        *(u32*)(buf + i) ^= (s1 >> 16) | (s2 & 0xFFFF0000);
+        *(u32*)(buf + i + 4) ^= (s3 >> 16) | (s4 & 0xFFFF0000);
+    }
+    for (; i < len; i += 2)
+    {
+        seed = seedStep(seed);
+        *(u16*)(buf + i) ^= seed >> 16;
+    }
+}
+
+void Crypt::cryptBoxes(Generation gen, u8* base, size_t count, size_t stride, bool decrypt)
+{
+    // Gen 4 and 5 seed the boxed part with the checksum, later generations with the encryption constant
+    const bool checksumSeed = gen == Generation::FOUR || gen == Generation::FIVE;
+    const u32 boxLength = checksumSeed ? 136 : 232;
+    const u32 blockLength = checksumSeed ? 32 : 56;
+    u8 blocks[4 * 56];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        u8* entry = base + i * stride;
+        // This is the PID in Gen 4 and 5, which is also what they use as encryption constant
+        u32 ec = *(u32*)entry;
+        u8 sv = (ec >> 13) & 31;
+
+        if (!decrypt)
+        {
+            u16 chk = 0;
+            for (u32 j = 8; j < boxLength; j += 2)
+            {
+                chk += *(u16*)(entry + j);
+            }
+            *(u16*)(entry + 6) = chk;
+            sv = blockPositionInvert(sv);
+        }
+        else
+        {
+            cryptStream(entry + 8, boxLength - 8, checksumSeed ? *(u16*)(entry + 6) : ec);
+            cryptStream(entry + boxLength, stride - boxLength, ec);
+        }
+
+        std::copy(entry + 8, entry + 8 + 4 * blockLength, blocks);
+        for (u8 block = 0; block < 4; block++)
+        {
+            u8 ofs = blockPosition(sv * 4 + block);
+            std::copy(blocks + blockLength * ofs, blocks + blockLength * ofs + blockLength, entry + 8 + blockLength * block);
+        }
+
+        if (!decrypt)
+        {
+            cryptStream(entry + 8, boxLength - 8, checksumSeed ? *(u16*)(entry + 6) : ec);
+            cryptStream(entry + boxLength, stride - boxLength, ec);
+        }
+    }
+}
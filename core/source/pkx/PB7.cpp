@@ -27,59 +27,26 @@
 #include "PB7.hpp"
 #include "random.hpp"
 
-void PB7::shuffleArray(u8 sv)
+PB7::PB7(u8* dt, bool ekx, bool direct)
 {
-    static const int blockLength = 56;
-    u8 index = sv * 4;
-    
-    u8 cdata[length];
-    std::copy(data, data + length, cdata);
-
-    for (u8 block = 0; block < 4; block++)
-    {
-        u8 ofs = blockPosition(index + block);
-        std::copy(
-            cdata + 8 + blockLength * ofs, 
-            cdata + 8 + blockLength * ofs + blockLength, 
-            data + 8 + blockLength * block
-        );
-    }
-}
-
-void PB7::crypt(void)
-{
-    u32 seed = encryptionConstant();
-    for (int i = 0x08; i < 232; i += 2)
+    length = 260;
+    directAccess = direct;
+    if (directAccess)
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        data = dt;
     }
-    seed = encryptionConstant();
-    for (u32 i = 232; i < length; i += 2)
+    else
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        allocate();
+        std::copy(dt, dt + length, data);
     }
-}
-
-PB7::PB7(u8* dt, bool ekx)
-{
-    length = 260;
-    data = new u8[length];
-    std::fill_n(data, length, 0);
-
-    std::copy(dt, dt + length, data);
     if (ekx)
     {
         decrypt();
     }
 }
 
-std::shared_ptr<PKX> PB7::clone(void) { return std::make_shared<PB7>(data); }
+std::shared_ptr<PKX> PB7::clone(void) { return PKX::create<PB7>(data); }
 
 Generation PB7::generation(void) const { return Generation::LGPE; }
 
@@ -201,6 +168,8 @@ void PB7::nicknamed(bool v) { *(u32*)(data + 0x74) = (*(u32*)(data + 0x74) & 0x7
 
 std::string PB7::htName(void) const { return StringUtils::getString(data, 0x78, 12); }
 void PB7::htName(const std::string& v) { StringUtils::setString(data, v, 0x78, 12); }
+std::u16string_view PB7::htNameView(void) const { return StringUtils::getStringView(data, 0x78, 12); }
+std::u16string_view PB7::otNameView(void) const { return StringUtils::getStringView(data, 0xB0, 12); }
 
 u8 PB7::htGender(void) const { return data[0x92]; }
 void PB7::htGender(u8 v) { data[0x92] = v; }
@@ -359,10 +328,7 @@ u16 PB7::PSV(void) const { return ((PID() >> 16) ^ (PID() & 0xFFFF)) >> 4; }
 
 u8 PB7::level(void) const
 {
-    u8 i = 1;
-    u8 xpType = expType();
-    while (experience() >= expTable(i, xpType) && ++i < 100);
-    return i;
+    return levelFromExp(expType(), experience());
 }
 
 void PB7::level(u8 v)
@@ -373,19 +339,9 @@ void PB7::level(u8 v)
 bool PB7::shiny(void) const { return TSV() == PSV(); }
 void PB7::shiny(bool v)
 {
-    if (v)
+    if (shiny() != v)
     {
-        while (!shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-    }
-    else
-    {
-        while (shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
+        PID(matchingPID(gender(), nature(), abilityNumber(), v));
     }
 }
 
@@ -393,12 +349,12 @@ u16 PB7::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalLGPE::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::LGPE>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalLGPE::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::LGPE>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
@@ -433,6 +389,21 @@ u16 PB7::stat(const u8 stat) const
     return calc * mult / 10 + awakened(stat);
 }
 
+void PB7::stats(std::array<u16, 6>& out) const
+{
+    u8 ivs[6], evs[6];
+    for (int i = 0; i < 6; i++)
+    {
+        ivs[i] = ((data[0xDE] >> hyperTrainLookup[i]) & 1) == 1 ? 31 : iv(i);
+        evs[i] = ev(i);
+    }
+    calcStats(out, ivs, evs);
+    for (int i = 0; i < 6; i++)
+    {
+        out[i] += awakened(i);
+    }
+}
+
 int PB7::partyCurrHP(void) const
 {
     if (length == 232)
@@ -496,19 +467,22 @@ void PB7::partyCP(u16 v)
 
 u16 PB7::CP() const
 {
-    int base = stat(0) + 10 + level(); // HP
+    std::array<u16, 6> calc;
+    stats(calc);
+    u8 lvl = level();
+    int base = calc[0] + 10 + lvl; // HP
     int mult = ((currentFriendship() / 255.0f / 10.0f) + 1.0f) * 100.0f;
     int awake = awakened(0);
 
     for (int i = 1; i < 6; i++)
     {
-        base += stat(i) * mult / 100;
+        base += calc[i] * mult / 100;
         awake += awakened(i);
     }
 
-    base = (u16)((float)(base * 6 * level()) / 100.0f);
+    base = (u16)((float)(base * 6 * lvl) / 100.0f);
 
-    double modifier = level() / 100.0 + 2.0;
+    double modifier = lvl / 100.0 + 2.0;
     awake = (u16) modifier * awake;
     return std::min(10000, base + awake);
 }
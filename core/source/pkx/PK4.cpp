@@ -27,57 +27,24 @@
 #include "PK4.hpp"
 #include "random.hpp"
 
-void PK4::shuffleArray(u8 sv)
+PK4::PK4(u8* dt, bool ekx, bool party, bool direct)
 {
-    static const int blockLength = 32;
-    u8 index = sv * 4;
-    
-    u8 cdata[length];
-    std::copy(data, data + length, cdata);
-
-    for (u8 block = 0; block < 4; block++)
-    {
-        u8 ofs = blockPosition(index + block);
-        std::copy(
-            cdata + 8 + blockLength * ofs, 
-            cdata + 8 + blockLength * ofs + blockLength, 
-            data + 8 + blockLength * block
-        );
-    }
-}
-
-void PK4::crypt(void)
-{
-	u32 seed = checksum();
-
-    for (int i = 0x08; i < 136; i += 2)
+    length = party ? 236 : 136;
+    directAccess = direct;
+    if (directAccess)
     {
-        seed = seedStep(seed);
-        data[i] ^= (seed >> 16);
-        data[i+1] ^= (seed >> 24);
+        data = dt;
     }
-
-    seed = PID();
-    for (u32 i = 136; i < length; i += 2)
+    else
     {
-        seed = seedStep(seed);
-        data[i] ^= (seed >> 16);
-        data[i+1] ^= (seed >> 24);
+        allocate();
+        std::copy(dt, dt + length, data);
     }
-}
-
-PK4::PK4(u8* dt, bool ekx, bool party)
-{
-    length = party ? 236 : 136;
-    data = new u8[length];
-    std::fill_n(data, length, 0);
-    
-    std::copy(dt, dt + length, data);
     if (ekx)
         decrypt();
 }
 
-std::shared_ptr<PKX> PK4::clone(void) { return std::make_shared<PK4>(data, false, length == 236); }
+std::shared_ptr<PKX> PK4::clone(void) { return PKX::create<PK4>(data, false, length == 236); }
 
 Generation PK4::generation(void) const { return Generation::FOUR; }
 
@@ -93,22 +60,7 @@ void PK4::currentHandler(u8 v) { (void)v; }
 u8 PK4::abilityNumber(void) const { return 1 << ((PID() >> 16) & 1); }
 void PK4::abilityNumber(u8 v)
 {
-    if (shiny())
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), v, PID(), generation()));
-        }
-        while (!shiny());
-    }
-    else
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), v, PID(), generation()));
-        }
-        while (shiny());
-    }
+    PID(matchingPID(gender(), nature(), v, shiny()));
 }
 
 u32 PK4::PID(void) const { return *(u32*)(data); }
@@ -213,22 +165,7 @@ u8 PK4::gender(void) const { return (data[0x40] >> 1) & 0x3; }
 void PK4::gender(u8 g)
 {
     data[0x40] = u8((data[0x40] & ~0x06) | (g << 1));
-    if (shiny())
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), g, version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (!shiny());
-    }
-    else
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), g, version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (shiny());
-    }
+    PID(matchingPID(g, nature(), abilityNumber(), shiny()));
 }
 
 u8 PK4::alternativeForm(void) const { return data[0x40] >> 3; }
@@ -237,22 +174,7 @@ void PK4::alternativeForm(u8 v) { data[0x40] = u8((data[0x40] & 0x07) | (v << 3)
 u8 PK4::nature(void) const { return PID() % 25; }
 void PK4::nature(u8 v)
 {
-    if (shiny())
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), v, alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (!shiny());
-    }
-    else
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), v, alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (shiny());
-    }
+    PID(matchingPID(gender(), v, abilityNumber(), shiny()));
 }
 
 u8 PK4::shinyLeaf(void) const { return *(u8*)(data + 0x41); }
@@ -425,10 +347,7 @@ u16 PK4::PSV(void) const { return ((PID() >> 16) ^ (PID() & 0xFFFF)) >> 3; }
 
 u8 PK4::level(void) const
 {
-    u8 i = 1;
-    u8 xpType = expType();
-    while (experience() >= expTable(i, xpType) && ++i < 100);
-    return i;
+    return levelFromExp(expType(), experience());
 }
 
 void PK4::level(u8 v)
@@ -439,19 +358,9 @@ void PK4::level(u8 v)
 bool PK4::shiny(void) const { return TSV() == PSV(); }
 void PK4::shiny(bool v)
 {
-    if (v)
-    {
-        while (!shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-    }
-    else
+    if (shiny() != v)
     {
-        while (shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
+        PID(matchingPID(gender(), nature(), abilityNumber(), v));
     }
 }
 
@@ -459,12 +368,12 @@ u16 PK4::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalDPPtHGSS::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::FOUR>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalDPPtHGSS::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::FOUR>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
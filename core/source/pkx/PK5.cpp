@@ -28,57 +28,24 @@
 #include "loader.hpp"
 #include "random.hpp"
 
-void PK5::shuffleArray(u8 sv)
+PK5::PK5(u8* dt, bool ekx, bool party, bool direct)
 {
-    static const int blockLength = 32;
-    u8 index = sv * 4;
-    
-    u8 cdata[length];
-    std::copy(data, data + length, cdata);
-
-    for (u8 block = 0; block < 4; block++)
-    {
-        u8 ofs = blockPosition(index + block);
-        std::copy(
-            cdata + 8 + blockLength * ofs, 
-            cdata + 8 + blockLength * ofs + blockLength, 
-            data + 8 + blockLength * block
-        );
-    }
-}
-
-void PK5::crypt(void)
-{
-    u32 seed = checksum();
-
-    for (int i = 0x08; i < 136; i += 2)
+    length = party ? 220 : 136;
+    directAccess = direct;
+    if (directAccess)
     {
-        seed = seedStep(seed);
-        data[i] ^= (seed >> 16);
-        data[i+1] ^= (seed >> 24);
+        data = dt;
     }
-
-    seed = PID();
-    for (u32 i = 136; i < length; i += 2)
+    else
     {
-        seed = seedStep(seed);
-        data[i] ^= (seed >> 16);
-        data[i+1] ^= (seed >> 24);
+        allocate();
+        std::copy(dt, dt + length, data);
     }
-}
-
-PK5::PK5(u8* dt, bool ekx, bool party)
-{
-    length = party ? 220 : 136;
-    data = new u8[length];
-    std::fill_n(data, length, 0);
-
-    std::copy(dt, dt + length, data);
     if (ekx)
         decrypt();
 }
 
-std::shared_ptr<PKX> PK5::clone(void) { return std::make_shared<PK5>(data, false, length == 236); }
+std::shared_ptr<PKX> PK5::clone(void) { return PKX::create<PK5>(data, false, length == 236); }
 
 Generation PK5::generation(void) const { return Generation::FIVE; }
 
@@ -94,22 +61,7 @@ void PK5::currentHandler(u8 v) { (void)v; }
 u8 PK5::abilityNumber(void) const { return hiddenAbility() ? 4 : 1 << ((PID() >> 16) & 1); }
 void PK5::abilityNumber(u8 v)
 {
-    if (shiny())
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), v, PID(), generation()));
-        }
-        while (!shiny());
-    }
-    else
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), v, PID(), generation()));
-        }
-        while (shiny());
-    }
+    PID(matchingPID(gender(), nature(), v, shiny()));
 }
 
 u32 PK5::PID(void) const { return *(u32*)(data); }
@@ -214,22 +166,7 @@ u8 PK5::gender(void) const { return (data[0x40] >> 1) & 0x3; }
 void PK5::gender(u8 g)
 {
     data[0x40] = u8((data[0x40] & ~0x06) | (g << 1));
-    if (shiny())
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), g, version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (!shiny());
-    }
-    else
-    {
-        do
-        {
-            PID(PKX::getRandomPID(species(), g, version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-        while (shiny());
-    }
+    PID(matchingPID(g, nature(), abilityNumber(), shiny()));
 }
 
 u8 PK5::alternativeForm(void) const { return data[0x40] >> 3; }
@@ -341,10 +278,7 @@ u16 PK5::PSV(void) const { return ((PID() >> 16) ^ (PID() & 0xFFFF)) >> 3; }
 
 u8 PK5::level(void) const
 {
-    u8 i = 1;
-    u8 xpType = expType();
-    while (experience() >= expTable(i, xpType) && ++i < 100);
-    return i;
+    return levelFromExp(expType(), experience());
 }
 
 void PK5::level(u8 v)
@@ -355,19 +289,9 @@ void PK5::level(u8 v)
 bool PK5::shiny(void) const { return TSV() == PSV(); }
 void PK5::shiny(bool v)
 {
-    if (v)
-    {
-        while (!shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-    }
-    else
+    if (shiny() != v)
     {
-        while (shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
+        PID(matchingPID(gender(), nature(), abilityNumber(), v));
     }
 }
 
@@ -375,12 +299,12 @@ u16 PK5::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalBWB2W2::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::FIVE>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalBWB2W2::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::FIVE>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
@@ -559,7 +483,7 @@ std::shared_ptr<PKX> PK5::next(void) const
     pk6->alternativeForm(alternativeForm());
     pk6->nature(nature());
 
-    pk6->nickname(i18n::species(pk6->language(), pk6->species()));
+    pk6->nickname(std::string(i18n::species(pk6->language(), pk6->species())));
     if (nicknamed())
         pk6->nickname(nickname());
 
@@ -28,59 +28,26 @@
 #include "loader.hpp"
 #include "random.hpp"
 
-void PK6::shuffleArray(u8 sv)
+PK6::PK6(u8* dt, bool ekx, bool party, bool direct)
 {
-    static const int blockLength = 56;
-    u8 index = sv * 4;
-    
-    u8 cdata[length];
-    std::copy(data, data + length, cdata);
-
-    for (u8 block = 0; block < 4; block++)
-    {
-        u8 ofs = blockPosition(index + block);
-        std::copy(
-            cdata + 8 + blockLength * ofs, 
-            cdata + 8 + blockLength * ofs + blockLength, 
-            data + 8 + blockLength * block
-        );
-    }
-}
-
-void PK6::crypt(void)
-{
-    u32 seed = encryptionConstant();
-    for (int i = 0x08; i < 232; i += 2)
+    length = party ? 260 : 232;
+    directAccess = direct;
+    if (directAccess)
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        data = dt;
     }
-    seed = encryptionConstant();
-    for (u32 i = 232; i < length; i += 2)
+    else
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        allocate();
+        std::copy(dt, dt + length, data);
     }
-}
-
-PK6::PK6(u8* dt, bool ekx, bool party)
-{
-    length = party ? 260 : 232;
-    data = new u8[length];
-    std::fill_n(data, length, 0);
-    
-    std::copy(dt, dt + length, data);
     if (ekx)
     {
         decrypt();
     }
 }
 
-std::shared_ptr<PKX> PK6::clone(void) { return std::make_shared<PK6>(data, false, length == 260); }
+std::shared_ptr<PKX> PK6::clone(void) { return PKX::create<PK6>(data, false, length == 260); }
 
 Generation PK6::generation(void) const { return Generation::SIX; }
 
@@ -227,6 +194,8 @@ void PK6::nicknamed(bool v) { *(u32*)(data + 0x74) = (*(u32*)(data + 0x74) & 0x7
 
 std::string PK6::htName(void) const { return StringUtils::getString(data, 0x78, 12); }
 void PK6::htName(const std::string& v) { StringUtils::setString(data, v, 0x78, 12); }
+std::u16string_view PK6::htNameView(void) const { return StringUtils::getStringView(data, 0x78, 12); }
+std::u16string_view PK6::otNameView(void) const { return StringUtils::getStringView(data, 0xB0, 13); }
 
 u8 PK6::htGender(void) const { return data[0x92]; }
 void PK6::htGender(u8 v) { data[0x92] = v; }
@@ -385,10 +354,7 @@ u16 PK6::PSV(void) const { return ((PID() >> 16) ^ (PID() & 0xFFFF)) >> 4; }
 
 u8 PK6::level(void) const
 {
-    u8 i = 1;
-    u8 xpType = expType();
-    while (experience() >= expTable(i, xpType) && ++i < 100);
-    return i;
+    return levelFromExp(expType(), experience());
 }
 
 void PK6::level(u8 v)
@@ -399,19 +365,9 @@ void PK6::level(u8 v)
 bool PK6::shiny(void) const { return TSV() == PSV(); }
 void PK6::shiny(bool v)
 {
-    if (v)
-    {
-        while (!shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-    }
-    else
+    if (shiny() != v)
     {
-        while (shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
+        PID(matchingPID(gender(), nature(), abilityNumber(), v));
     }
 }
 
@@ -419,12 +375,12 @@ u16 PK6::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalXYORAS::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::SIX>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalXYORAS::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::SIX>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
@@ -28,59 +28,26 @@
 #include "loader.hpp"
 #include "random.hpp"
 
-void PK7::shuffleArray(u8 sv)
+PK7::PK7(u8* dt, bool ekx, bool party, bool direct)
 {
-    static const int blockLength = 56;
-    u8 index = sv * 4;
-    
-    u8 cdata[length];
-    std::copy(data, data + length, cdata);
-
-    for (u8 block = 0; block < 4; block++)
-    {
-        u8 ofs = blockPosition(index + block);
-        std::copy(
-            cdata + 8 + blockLength * ofs, 
-            cdata + 8 + blockLength * ofs + blockLength, 
-            data + 8 + blockLength * block
-        );
-    }
-}
-
-void PK7::crypt(void)
-{
-    u32 seed = encryptionConstant();
-    for (int i = 0x08; i < 232; i += 2)
+    length = party ? 260 : 232;
+    directAccess = direct;
+    if (directAccess)
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        data = dt;
     }
-    seed = encryptionConstant();
-    for (u32 i = 232; i < length; i += 2)
+    else
     {
-        u16 temp = *(u16*)(data + i);
-        seed = seedStep(seed);
-        temp ^= (seed >> 16);
-        *(u16*)(data + i) = temp;
+        allocate();
+        std::copy(dt, dt + length, data);
     }
-}
-
-PK7::PK7(u8* dt, bool ekx, bool party)
-{
-    length = party ? 260 : 232;
-    data = new u8[length];
-    std::fill_n(data, length, 0);
-    
-    std::copy(dt, dt + length, data);
     if (ekx)
     {
         decrypt();
     }
 }
 
-std::shared_ptr<PKX> PK7::clone(void) { return std::make_shared<PK7>(data, false, length == 260); }
+std::shared_ptr<PKX> PK7::clone(void) { return PKX::create<PK7>(data, false, length == 260); }
 
 Generation PK7::generation(void) const { return Generation::SEVEN; }
 
@@ -202,6 +169,8 @@ void PK7::nicknamed(bool v) { *(u32*)(data + 0x74) = (*(u32*)(data + 0x74) & 0x7
 
 std::string PK7::htName(void) const { return StringUtils::getString(data, 0x78, 12); }
 void PK7::htName(const std::string& v) { StringUtils::setString(data, v, 0x78, 12); }
+std::u16string_view PK7::htNameView(void) const { return StringUtils::getStringView(data, 0x78, 12); }
+std::u16string_view PK7::otNameView(void) const { return StringUtils::getStringView(data, 0xB0, 13); }
 
 u8 PK7::htGender(void) const { return data[0x92]; }
 void PK7::htGender(u8 v) { data[0x92] = v; }
@@ -361,10 +330,7 @@ u16 PK7::PSV(void) const { return ((PID() >> 16) ^ (PID() & 0xFFFF)) >> 4; }
 
 u8 PK7::level(void) const
 {
-    u8 i = 1;
-    u8 xpType = expType();
-    while (experience() >= expTable(i, xpType) && ++i < 100);
-    return i;
+    return levelFromExp(expType(), experience());
 }
 
 void PK7::level(u8 v)
@@ -375,19 +341,9 @@ void PK7::level(u8 v)
 bool PK7::shiny(void) const { return TSV() == PSV(); }
 void PK7::shiny(bool v)
 {
-    if (v)
+    if (shiny() != v)
     {
-        while (!shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
-    }
-    else
-    {
-        while (shiny())
-        {
-            PID(PKX::getRandomPID(species(), gender(), version(), nature(), alternativeForm(), abilityNumber(), PID(), generation()));
-        }
+        PID(matchingPID(gender(), nature(), abilityNumber(), v));
     }
 }
 
@@ -395,12 +351,12 @@ u16 PK7::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalSMUSUM::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::SEVEN>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalSMUSUM::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::SEVEN>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
@@ -435,6 +391,17 @@ u16 PK7::stat(const u8 stat) const
     return calc * mult / 10;
 }
 
+void PK7::stats(std::array<u16, 6>& out) const
+{
+    u8 ivs[6], evs[6];
+    for (int i = 0; i < 6; i++)
+    {
+        ivs[i] = ((data[0xDE] >> hyperTrainLookup[i]) & 1) == 1 ? 31 : iv(i);
+        evs[i] = ev(i);
+    }
+    calcStats(out, ivs, evs);
+}
+
 std::shared_ptr<PKX> PK7::previous(void) const
 {
     u8 dt[232];
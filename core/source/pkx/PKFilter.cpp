@@ -0,0 +1,375 @@
+/*
+*   This file is part of PKSM
+*   Copyright (C) 2016-2019 Bernardo Giordano, Admiral Fish, piepie62
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+*       * Requiring preservation of specified reasonable legal notices or
+*         author attributions in that material or in the Appropriate Legal
+*         Notices displayed by works containing it.
+*       * Prohibiting misrepresentation of the origin of that material,
+*         or requiring that modified versions of such material be marked in
+*         reasonable ways as different from the original version.
+*/
+
+
+#include "PKFilter.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    struct FieldName
+    {
+        const char* name;
+        PKFilter::Field field;
+    };
+
+    constexpr FieldName fieldNames[] = {
+        {"species", PKFilter::Field::Species},
+        {"form", PKFilter::Field::Form},
+        {"item", PKFilter::Field::HeldItem},
+        {"tid", PKFilter::Field::TID},
+        {"sid", PKFilter::Field::SID},
+        {"pid", PKFilter::Field::PID},
+        {"nature", PKFilter::Field::Nature},
+        {"gender", PKFilter::Field::Gender},
+        {"ability", PKFilter::Field::Ability},
+        {"ball", PKFilter::Field::Ball},
+        {"version", PKFilter::Field::Version},
+        {"shiny", PKFilter::Field::Shiny},
+        {"egg", PKFilter::Field::Egg},
+        {"iv.hp", PKFilter::Field::IVHP},
+        {"iv.atk", PKFilter::Field::IVAtk},
+        {"iv.def", PKFilter::Field::IVDef},
+        {"iv.spe", PKFilter::Field::IVSpe},
+        {"iv.spa", PKFilter::Field::IVSpA},
+        {"iv.spd", PKFilter::Field::IVSpD},
+        {"ivs", PKFilter::Field::IVTotal},
+        {"move", PKFilter::Field::Move}
+    };
+
+    std::string trim(const std::string& str)
+    {
+        size_t first = str.find_first_not_of(" \t");
+        if (first == std::string::npos)
+        {
+            return "";
+        }
+        return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+    }
+
+    std::optional<u32> parseValue(const std::string& str)
+    {
+        if (str.empty())
+        {
+            return std::nullopt;
+        }
+        char* end;
+        unsigned long value = std::strtoul(str.c_str(), &end, 0);
+        if (*end != '\0')
+        {
+            return std::nullopt;
+        }
+        return (u32)value;
+    }
+}
+
+PKFilter::PKFilter()
+{
+    // Every generation starts out requiring an occupied slot
+    for (auto& gen : tests)
+    {
+        gen = std::vector<Test>{{0x08, 0, Read::U16, 0xFFFF, Op::NotEqual, 0}};
+    }
+}
+
+std::optional<PKFilter::Test> PKFilter::compile(Generation gen, Field field)
+{
+    bool oldLayout = gen == Generation::FOUR || gen == Generation::FIVE;
+    switch (field)
+    {
+        case Field::Species:
+            return Test{0x08, 0, Read::U16, 0xFFFF};
+        case Field::HeldItem:
+            return Test{0x0A, 0, Read::U16, 0xFFFF};
+        case Field::TID:
+            return Test{0x0C, 0, Read::U16, 0xFFFF};
+        case Field::SID:
+            return Test{0x0E, 0, Read::U16, 0xFFFF};
+        case Field::PID:
+            return Test{u16(oldLayout ? 0x00 : 0x18), 0, Read::U32, 0xFFFFFFFF};
+        case Field::Form:
+            return Test{u16(oldLayout ? 0x40 : 0x1D), 3, Read::U8, 0x1F};
+        case Field::Gender:
+            return Test{u16(oldLayout ? 0x40 : 0x1D), 1, Read::U8, 0x3};
+        case Field::Nature:
+            if (gen == Generation::FOUR)
+            {
+                return Test{0x00, 0, Read::Gen4Nature, 0xFF};
+            }
+            return Test{u16(oldLayout ? 0x41 : 0x1C), 0, Read::U8, 0xFF};
+        case Field::Ability:
+            return Test{u16(oldLayout ? 0x15 : 0x14), 0, Read::U8, 0xFF};
+        case Field::Ball:
+            if (gen == Generation::FOUR)
+            {
+                return Test{0x83, 0, Read::Gen4Ball, 0xFF};
+            }
+            return Test{u16(oldLayout ? 0x83 : 0xDC), 0, Read::U8, 0xFF};
+        case Field::Version:
+            return Test{u16(oldLayout ? 0x5F : 0xDF), 0, Read::U8, 0xFF};
+        case Field::Shiny:
+            return Test{u16(oldLayout ? 0x00 : 0x18), u8(oldLayout ? 3 : 4), Read::Shiny, 0x1};
+        case Field::Egg:
+            return Test{u16(oldLayout ? 0x38 : 0x74), 30, Read::U32, 0x1};
+        case Field::IVHP:
+        case Field::IVAtk:
+        case Field::IVDef:
+        case Field::IVSpe:
+        case Field::IVSpA:
+        case Field::IVSpD:
+            return Test{u16(oldLayout ? 0x38 : 0x74), u8(5 * (u8(field) - u8(Field::IVHP))), Read::U32, 0x1F};
+        case Field::IVTotal:
+            return Test{u16(oldLayout ? 0x38 : 0x74), 0, Read::IVTotal, 0xFF};
+        case Field::Move:
+            return Test{u16(oldLayout ? 0x28 : 0x5A), 0, Read::AnyMove, 0xFFFF};
+    }
+    return std::nullopt;
+}
+
+PKFilter& PKFilter::where(Field field, Op op, u32 value)
+{
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        if (tests[i])
+        {
+            if (auto test = compile(Generation(i), field))
+            {
+                test->op = op;
+                test->value = value;
+                tests[i]->push_back(*test);
+            }
+            else
+            {
+                tests[i] = std::nullopt;
+            }
+        }
+    }
+    return *this;
+}
+
+PKFilter& PKFilter::generation(Generation gen)
+{
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        if (Generation(i) != gen)
+        {
+            tests[i] = std::nullopt;
+        }
+    }
+    return *this;
+}
+
+std::optional<PKFilter> PKFilter::parse(const std::string& text)
+{
+    PKFilter ret;
+    size_t start = 0;
+    while (start <= text.size())
+    {
+        size_t end = text.find('&', start);
+        if (end == std::string::npos)
+        {
+            end = text.size();
+        }
+        std::string term = trim(text.substr(start, end - start));
+        start = end + 1;
+        if (term.empty())
+        {
+            if (end == text.size() && start == 1)
+            {
+                break; // The whole filter is empty
+            }
+            return std::nullopt;
+        }
+
+        size_t opPos = term.find_first_of("=!<>", 1);
+        std::string name;
+        Op op = Op::Equal;
+        std::optional<u32> value;
+        if (opPos == std::string::npos)
+        {
+            // A bare flag, possibly negated
+            bool negated = term[0] == '!';
+            name = trim(term.substr(negated ? 1 : 0));
+            value = negated ? 0 : 1;
+            if (name != "shiny" && name != "egg")
+            {
+                return std::nullopt;
+            }
+        }
+        else
+        {
+            name = trim(term.substr(0, opPos));
+            size_t valuePos = opPos + 1;
+            bool hasEqual = valuePos < term.size() && term[valuePos] == '=';
+            switch (term[opPos])
+            {
+                case '=':
+                    op = Op::Equal;
+                    valuePos += hasEqual ? 1 : 0;
+                    break;
+                case '!':
+                    if (!hasEqual)
+                    {
+                        return std::nullopt;
+                    }
+                    op = Op::NotEqual;
+                    valuePos++;
+                    break;
+                case '<':
+                    op = hasEqual ? Op::LessEqual : Op::Less;
+                    valuePos += hasEqual ? 1 : 0;
+                    break;
+                case '>':
+                    op = hasEqual ? Op::GreaterEqual : Op::Greater;
+                    valuePos += hasEqual ? 1 : 0;
+                    break;
+            }
+            std::string valueStr = trim(term.substr(valuePos));
+            if (name == "gen")
+            {
+                if (op != Op::Equal)
+                {
+                    return std::nullopt;
+                }
+                if (valueStr == "lgpe")
+                {
+                    ret.generation(Generation::LGPE);
+                    continue;
+                }
+                value = parseValue(valueStr);
+                if (!value || *value < 4 || *value > 7)
+                {
+                    return std::nullopt;
+                }
+                ret.generation(Generation(*value - 4));
+                continue;
+            }
+            value = parseValue(valueStr);
+            if (!value)
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto found = std::find_if(std::begin(fieldNames), std::end(fieldNames), [&name](const FieldName& field) { return name == field.name; });
+        if (found == std::end(fieldNames))
+        {
+            return std::nullopt;
+        }
+        ret.where(found->field, op, *value);
+    }
+    return ret;
+}
+
+bool PKFilter::compare(u32 lhs, Op op, u32 rhs)
+{
+    switch (op)
+    {
+        case Op::Equal:
+            return lhs == rhs;
+        case Op::NotEqual:
+            return lhs != rhs;
+        case Op::Less:
+            return lhs < rhs;
+        case Op::LessEqual:
+            return lhs <= rhs;
+        case Op::Greater:
+            return lhs > rhs;
+        case Op::GreaterEqual:
+            return lhs >= rhs;
+    }
+    return false;
+}
+
+bool PKFilter::passes(const Test& test, const u8* data)
+{
+    const u8* field = data + test.offset;
+    u32 value;
+    switch (test.read)
+    {
+        case Read::U8:
+            value = *field;
+            break;
+        case Read::U16:
+            value = *(const u16*)field;
+            break;
+        case Read::U32:
+            value = *(const u32*)field;
+            break;
+        case Read::Gen4Nature:
+            value = *(const u32*)field % 25;
+            break;
+        case Read::Gen4Ball:
+            value = std::max(field[0], field[3]);
+            break;
+        case Read::Shiny:
+        {
+            u32 pid = *(const u32*)field;
+            u16 tsv = *(const u16*)(data + 0x0C) ^ *(const u16*)(data + 0x0E);
+            u16 psv = u16(pid >> 16) ^ u16(pid);
+            value = (tsv >> test.shift) == (psv >> test.shift);
+            return compare(value, test.op, test.value);
+        }
+        case Read::IVTotal:
+        {
+            u32 ivs = *(const u32*)field;
+            value = 0;
+            for (int i = 0; i < 6; i++)
+            {
+                value += (ivs >> (5 * i)) & 0x1F;
+            }
+            return compare(value, test.op, test.value);
+        }
+        case Read::AnyMove:
+            for (int i = 0; i < 4; i++)
+            {
+                if (compare(((const u16*)field)[i], test.op, test.value))
+                {
+                    return true;
+                }
+            }
+            return false;
+    }
+    return compare((value >> test.shift) & test.mask, test.op, test.value);
+}
+
+bool PKFilter::matches(Generation gen, const u8* data) const
+{
+    if (size_t(gen) >= tests.size() || !tests[size_t(gen)])
+    {
+        return false;
+    }
+    for (const Test& test : *tests[size_t(gen)])
+    {
+        if (!passes(test, data))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -25,171 +25,60 @@
 */
 
 #include "PKX.hpp"
+#include "Crypt.hpp"
 #include "PK6.hpp"
+#include "Stats.hpp"
 
-u32 PKX::expTable(u8 row, u8 col) const
+thread_local u8* PKX::reservedPayload = nullptr;
+
+u32 PKX::expTable(u8 row, u8 col)
 {
-    static constexpr u32 table[100][6] = {
-        {0, 0, 0, 0, 0, 0},
-        {8, 15, 4, 9, 6, 10},
-        {27, 52, 13, 57, 21, 33},
-        {64, 122, 32, 96, 51, 80},
-        {125, 237, 65, 135, 100, 156},
-        {216, 406, 112, 179, 172, 270},
-        {343, 637, 178, 236, 274, 428},
-        {512, 942, 276, 314, 409, 640},
-        {729, 1326, 393, 419, 583, 911},
-        {1000, 1800, 540, 560, 800, 1250},
-        {1331, 2369, 745, 742, 1064, 1663},
-        {1728, 3041, 967, 973, 1382, 2160},
-        {2197, 3822, 1230, 1261, 1757, 2746},
-        {2744, 4719, 1591, 1612, 2195, 3430},
-        {3375, 5737, 1957, 2035, 2700, 4218},
-        {4096, 6881, 2457, 2535, 3276, 5120},
-        {4913, 8155, 3046, 3120, 3930, 6141},
-        {5832, 9564, 3732, 3798, 4665, 7290},
-        {6859, 11111, 4526, 4575, 5487, 8573},
-        {8000, 12800, 5440, 5460, 6400, 10000},
-        {9261, 14632, 6482, 6458, 7408, 11576},
-        {10648, 16610, 7666, 7577, 8518, 13310},
-        {12167, 18737, 9003, 8825, 9733, 15208},
-        {13824, 21012, 10506, 10208, 11059, 17280},
-        {15625, 23437, 12187, 11735, 12500, 19531},
-        {17576, 26012, 14060, 13411, 14060, 21970},
-        {19683, 28737, 16140, 15244, 15746, 24603},
-        {21952, 31610, 18439, 17242, 17561, 27440},
-        {24389, 34632, 20974, 19411, 19511, 30486},
-        {27000, 37800, 23760, 21760, 21600, 33750},
-        {29791, 41111, 26811, 24294, 23832, 37238},
-        {32768, 44564, 30146, 27021, 26214, 40960},
-        {35937, 48155, 33780, 29949, 28749, 44921},
-        {39304, 51881, 37731, 33084, 31443, 49130},
-        {42875, 55737, 42017, 36435, 34300, 53593},
-        {46656, 59719, 46656, 40007, 37324, 58320},
-        {50653, 63822, 50653, 43808, 40522, 63316},
-        {54872, 68041, 55969, 47846, 43897, 68590},
-        {59319, 72369, 60505, 52127, 47455, 74148},
-        {64000, 76800, 66560, 56660, 51200, 80000},
-        {68921, 81326, 71677, 61450, 55136, 86151},
-        {74088, 85942, 78533, 66505, 59270, 92610},
-        {79507, 90637, 84277, 71833, 63605, 99383},
-        {85184, 95406, 91998, 77440, 68147, 106480},
-        {91125, 100237, 98415, 83335, 72900, 113906},
-        {97336, 105122, 107069, 89523, 77868, 121670},
-        {103823, 110052, 114205, 96012, 83058, 129778},
-        {110592, 115015, 123863, 102810, 88473, 138240},
-        {117649, 120001, 131766, 109923, 94119, 147061},
-        {125000, 125000, 142500, 117360, 100000, 156250},
-        {132651, 131324, 151222, 125126, 106120, 165813},
-        {140608, 137795, 163105, 133229, 112486, 175760},
-        {148877, 144410, 172697, 141677, 119101, 186096},
-        {157464, 151165, 185807, 150476, 125971, 196830},
-        {166375, 158056, 196322, 159635, 133100, 207968},
-        {175616, 165079, 210739, 169159, 140492, 219520},
-        {185193, 172229, 222231, 179056, 148154, 231491},
-        {195112, 179503, 238036, 189334, 156089, 243890},
-        {205379, 186894, 250562, 199999, 164303, 256723},
-        {216000, 194400, 267840, 211060, 172800, 270000},
-        {226981, 202013, 281456, 222522, 181584, 283726},
-        {238328, 209728, 300293, 234393, 190662, 297910},
-        {250047, 217540, 315059, 246681, 200037, 312558},
-        {262144, 225443, 335544, 259392, 209715, 327680},
-        {274625, 233431, 351520, 272535, 219700, 343281},
-        {287496, 241496, 373744, 286115, 229996, 359370},
-        {300763, 249633, 390991, 300140, 240610, 375953},
-        {314432, 257834, 415050, 314618, 251545, 393040},
-        {328509, 267406, 433631, 329555, 262807, 410636},
-        {343000, 276458, 459620, 344960, 274400, 428750},
-        {357911, 286328, 479600, 360838, 286328, 447388},
-        {373248, 296358, 507617, 377197, 298598, 466560},
-        {389017, 305767, 529063, 394045, 311213, 486271},
-        {405224, 316074, 559209, 411388, 324179, 506530},
-        {421875, 326531, 582187, 429235, 337500, 527343},
-        {438976, 336255, 614566, 447591, 351180, 548720},
-        {456533, 346965, 639146, 466464, 365226, 570666},
-        {474552, 357812, 673863, 485862, 379641, 593190},
-        {493039, 367807, 700115, 505791, 394431, 616298},
-        {512000, 378880, 737280, 526260, 409600, 640000},
-        {531441, 390077, 765275, 547274, 425152, 664301},
-        {551368, 400293, 804997, 568841, 441094, 689210},
-        {571787, 411686, 834809, 590969, 457429, 714733},
-        {592704, 423190, 877201, 613664, 474163, 740880},
-        {614125, 433572, 908905, 636935, 491300, 767656},
-        {636056, 445239, 954084, 660787, 508844, 795070},
-        {658503, 457001, 987754, 685228, 526802, 823128},
-        {681472, 467489, 1035837, 710266, 545177, 851840},
-        {704969, 479378, 1071552, 735907, 563975, 881211},
-        {729000, 491346, 1122660, 762160, 583200, 911250},
-        {753571, 501878, 1160499, 789030, 602856, 941963},
-        {778688, 513934, 1214753, 816525, 622950, 973360},
-        {804357, 526049, 1254796, 844653, 643485, 1005446},
-        {830584, 536557, 1312322, 873420, 664467, 1038230},
-        {857375, 548720, 1354652, 902835, 685900, 1071718},
-        {884736, 560922, 1415577, 932903, 707788, 1105920},
-        {912673, 571333, 1460276, 963632, 730138, 1140841},
-        {941192, 583539, 1524731, 995030, 752953, 1176490},
-        {970299, 591882, 1571884, 1027103, 776239, 1212873},
-        {1000000, 600000, 1640000, 1059860, 800000, 1250000}
-    };
-
-    return table[row][col]; 
+    return Stats::expTable(row, col);
 }
 
-u8 PKX::blockPosition(u8 index) const
+u8 PKX::levelFromExp(u8 expType, u32 exp)
 {
-    static constexpr u8 blocks[128] =
-    {
-        0, 1, 2, 3,
-        0, 1, 3, 2,
-        0, 2, 1, 3,
-        0, 3, 1, 2,
-        0, 2, 3, 1,
-        0, 3, 2, 1,
-        1, 0, 2, 3,
-        1, 0, 3, 2,
-        2, 0, 1, 3,
-        3, 0, 1, 2,
-        2, 0, 3, 1,
-        3, 0, 2, 1,
-        1, 2, 0, 3,
-        1, 3, 0, 2,
-        2, 1, 0, 3,
-        3, 1, 0, 2,
-        2, 3, 0, 1,
-        3, 2, 0, 1,
-        1, 2, 3, 0,
-        1, 3, 2, 0,
-        2, 1, 3, 0,
-        3, 1, 2, 0,
-        2, 3, 1, 0,
-        3, 2, 1, 0,
-
-        // duplicates of 0-7 to eliminate modulus
-        0, 1, 2, 3,
-        0, 1, 3, 2,
-        0, 2, 1, 3,
-        0, 3, 1, 2,
-        0, 2, 3, 1,
-        0, 3, 2, 1,
-        1, 0, 2, 3,
-        1, 0, 3, 2,
-    };
-
-    return blocks[index];
+    return Stats::levelFromExp(expType, exp);
 }
 
-u8 PKX::blockPositionInvert(u8 index) const
+void PKX::stats(std::array<u16, 6>& out) const
 {
-    static constexpr u8 blocks[32] =
+    u8 ivs[6], evs[6];
+    for (int i = 0; i < 6; i++)
     {
-        0, 1, 2, 4, 3, 5, 6, 7, 12, 18, 13, 19, 8, 10, 14, 20, 16, 22, 9, 11, 15, 21, 17, 23,
-        0, 1, 2, 4, 3, 5, 6, 7, // duplicates of 0-7 to eliminate modulus
-    };
+        ivs[i] = iv(i);
+        evs[i] = ev(i);
+    }
+    calcStats(out, ivs, evs);
+}
 
-    return blocks[index];
+void PKX::calcStats(std::array<u16, 6>& out, const u8* ivs, const u8* evs) const
+{
+    const u8 bases[6] = {baseHP(), baseAtk(), baseDef(), baseSpe(), baseSpa(), baseSpd()};
+    Stats::calc(out, bases, ivs, evs, level(), nature());
 }
 
-u32 PKX::seedStep(u32 seed) { return seed * 0x41C64E6D + 0x6073; }
+u8 PKX::blockPosition(u8 index)
+{
+    return Crypt::blockPosition(index);
+}
+
+u8 PKX::blockPositionInvert(u8 index)
+{
+    return Crypt::blockPositionInvert(index);
+}
+
+u32 PKX::seedStep(u32 seed) { return Crypt::seedStep(seed); }
+
+void PKX::cryptStream(u8* buf, u32 len, u32 seed)
+{
+    Crypt::cryptStream(buf, len, seed);
+}
+
+void PKX::cryptBoxes(Generation gen, u8* base, size_t count, size_t stride, bool decrypt)
+{
+    Crypt::cryptBoxes(gen, base, count, stride, decrypt);
+}
 
 void PKX::reorderMoves(void)
 {
@@ -220,17 +109,12 @@ void PKX::reorderMoves(void)
 
 void PKX::decrypt(void)
 {
-    u8 sv = (encryptionConstant() >> 13) & 31;
-    crypt();
-    shuffleArray(sv);
+    cryptBoxes(generation(), data, 1, length, true);
 }
 
 void PKX::encrypt(void)
 {
-    u8 sv = (encryptionConstant() >> 13) & 31;
-    refreshChecksum();
-    shuffleArray(blockPositionInvert(sv));
-    crypt();
+    cryptBoxes(generation(), data, 1, length, false);
 }
 
 bool PKX::gen7(void) const { return version() >= 30 && version() <= 33;}
@@ -352,91 +236,177 @@ u8 PKX::genFromBytes(u8* data, size_t length, bool ekx)
     return 0;
 }
 
-static inline u8 genderFromRatio(u32 pid, u8 gt)
+namespace
 {
-    switch (gt)
+    constexpr u32 unownBits = 0x03030303;
+
+    // Spreads a Gen 3 Unown form value over the two low bits of each PID byte; the form is the value % 28
+    constexpr u32 unownPIDBits(u32 val)
     {
-        case 0xFF:
-            return 2;
-        case 0xFE:
-            return 1;
-        case 0:
-            return 0;
-        default:
-            return (pid & 0xFF) < gt ? 1 : 0;
+        return (val & 0xC0) << 18 | (val & 0x30) << 12 | (val & 0xC) << 6 | (val & 0x3);
+    }
+
+    bool shinyPID(u32 pid, u16 tsv, u8 shift)
+    {
+        return ((tsv ^ (pid >> 16) ^ (pid & 0xFFFF)) >> shift) == 0;
     }
 }
 
-static inline u8 getUnownForm(u32 pid)
+u32 PKX::getRandomPID(u16 species, u8 gender, u8 originGame, u8 nature, u8 form, u8 abilityNum, u32 oldPid, Generation gen)
 {
-    u32 val = (pid & 0x3000000) >> 18 | (pid & 0x30000) >> 12 | (pid & 0x300) >> 6 | (pid & 0x3);
-    return val % 28;
+    return generatePID({species, gender, originGame, nature, form, abilityNum, gen}).value_or(oldPid);
 }
 
-u32 PKX::getRandomPID(u16 species, u8 gender, u8 originGame, u8 nature, u8 form, u8 abilityNum, u32 oldPid, Generation gen)
+std::optional<u32> PKX::generatePID(const PIDSpec& spec)
 {
-    if (originGame >= 24) // Origin game over gen 5
+    bool legacy = spec.originGame < 24; // Origin game before gen 6
+    bool unown = spec.originGame <= 5 && spec.species == 201;
+    bool natureBound = spec.originGame <= 15;
+    u8 genderType = PersonalDispatch::gender(spec.gen == Generation::LGPE ? Generation::SEVEN : spec.gen, spec.species);
+    bool genderBound = legacy && spec.gender != 2 && genderType != 0 && genderType != 254 && genderType != 255;
+    int abilityBit = legacy && !unown && (spec.abilityNum == 1 || spec.abilityNum == 2) ? (spec.gen == Generation::FIVE ? 16 : 0) : -1;
+    u8 shift = spec.gen == Generation::FOUR || spec.gen == Generation::FIVE ? 3 : 4;
+    u16 tsv = spec.TID ^ spec.SID;
+
+    // Each attempt fixes the constrained bits, then searches the free ones for the nature. A dead end
+    // only takes another attempt from a new random start; the cap is just a backstop, as a satisfiable
+    // spec essentially never needs more than a few
+    for (int attempt = 0; attempt < 4096; attempt++)
     {
-        return randomNumbers();
-    }
+        u32 pid = randomNumbers();
+        u32 fixed = 0;
 
-    u8 (*genderTypeFinder)(u16 species);
-    switch (gen)
-    {
-        case Generation::FOUR:
-            genderTypeFinder = PersonalDPPtHGSS::gender;
-            break;
-        case Generation::FIVE:
-            genderTypeFinder = PersonalBWB2W2::gender;
-            break;
-        case Generation::SIX:
-            genderTypeFinder = PersonalXYORAS::gender;
-            break;
-        case Generation::SEVEN:
-        default:
-            genderTypeFinder = PersonalSMUSUM::gender;
-            break;
-    }
+        if (unown)
+        {
+            // Form values are val % 28 for any byte val; pick one whose high bits agree with the shiny
+            // XOR when shininess is required
+            u8 candidates[10];
+            u8 count = 0;
+            for (u32 val = spec.form; val < 256; val += 28)
+            {
+                if (spec.shiny != Shininess::Shiny || ((val >> 6) & 3) == (((val >> 2) & 3) ^ ((tsv >> 8) & 3)))
+                {
+                    candidates[count++] = val;
+                }
+            }
+            if (count == 0)
+            {
+                // Depends on nothing random: this form can't be shiny with these IDs
+                return std::nullopt;
+            }
+            pid = (pid & ~unownBits) | unownPIDBits(candidates[randomNumbers() % count]);
+            fixed |= unownBits;
+        }
 
-    u8 genderType = genderTypeFinder(species);
-    bool g3unown = originGame <= 5 && species == 201;
-    while (true)
-    {
-        u32 possiblePID = randomNumbers();
-        if (originGame <= 15 && possiblePID % 25 != nature)
+        if (genderBound)
         {
-            continue;
+            u32 low = spec.gender == 1 ? 0 : genderType;
+            u32 high = spec.gender == 1 ? genderType : 256;
+            u32 byte = low + randomNumbers() % (high - low);
+            if (abilityBit == 0 && (byte & 1) != u32(spec.abilityNum == 2))
+            {
+                // Stay within the gender range when fixing the ability bit
+                if (byte + 1 < high)
+                {
+                    byte++;
+                }
+                else if (byte > low)
+                {
+                    byte--;
+                }
+            }
+            pid = (pid & ~0xFF) | byte;
+            fixed |= 0xFF;
         }
 
-        if (g3unown)
+        if (abilityBit >= 0)
         {
-            if (getUnownForm(possiblePID) != form)
+            pid = spec.abilityNum == 2 ? pid | (1 << abilityBit) : pid & ~(1 << abilityBit);
+            fixed |= 1 << abilityBit;
+        }
+
+        // Bit flips that keep every constraint so far. A shiny PID ties the upper bits of its halves
+        // together, so those bits flip in pairs
+        u32 toggles[32];
+        int toggleCount = 0;
+        if (spec.shiny == Shininess::Shiny)
+        {
+            u16 lowHalf = pid & 0xFFFF;
+            u16 highHalf = ((lowHalf ^ tsv) & ~((1 << shift) - 1)) | ((pid >> 16) & ((1 << shift) - 1));
+            pid = (highHalf << 16) | lowHalf;
+            for (int bit = 0; bit < 16; bit++)
             {
-                continue;
+                u32 mask = bit < shift ? 1 << bit : (1 << bit) | (1 << (bit + 16));
+                if (!(mask & fixed))
+                {
+                    toggles[toggleCount++] = mask;
+                }
+                if (bit < shift && !((1 << (bit + 16)) & fixed))
+                {
+                    toggles[toggleCount++] = 1 << (bit + 16);
+                }
             }
         }
-        else if (abilityNum != 4)
+        else
         {
-            if (abilityNum == 1 && (possiblePID & (1 << (gen == Generation::FIVE ? 16 : 0))))
+            for (int bit = 0; bit < 32; bit++)
             {
-                continue;
+                if (!((1 << bit) & fixed))
+                {
+                    toggles[toggleCount++] = 1 << bit;
+                }
             }
-            else if (abilityNum == 2 && !(possiblePID & (1 << (gen == Generation::FIVE ? 16 : 0))))
+        }
+
+        if (natureBound && pid % 25 != spec.nature)
+        {
+            // Gray code walk over every combination of up to 12 randomly chosen toggles
+            std::shuffle(toggles, toggles + toggleCount, randomNumbers);
+            int used = std::min(toggleCount, 12);
+            bool found = false;
+            for (u32 i = 1; i < (1u << used); i++)
+            {
+                pid ^= toggles[__builtin_ctz(i)];
+                if (pid % 25 == spec.nature)
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
             {
                 continue;
             }
         }
 
-        if (genderType == 255 || genderType == 254 || genderType == 0 || gender == 2)
+        if (spec.shiny == Shininess::NotShiny && shinyPID(pid, tsv, shift))
         {
-            return possiblePID;
+            continue;
         }
+        return pid;
+    }
+    return std::nullopt;
+}
 
-        if (gender == genderFromRatio(possiblePID, genderType))
+std::vector<u32> PKX::generatePIDs(const PIDSpec& spec, size_t count)
+{
+    std::vector<u32> ret(count);
+    for (auto& pid : ret)
+    {
+        std::optional<u32> generated = generatePID(spec);
+        if (!generated)
         {
-            return possiblePID;
+            return {};
         }
+        pid = *generated;
     }
+    return ret;
+}
+
+u32 PKX::matchingPID(u8 gender, u8 nature, u8 abilityNum, bool shiny) const
+{
+    return generatePID({species(), gender, version(), nature, alternativeForm(), abilityNum, generation(),
+        shiny ? Shininess::Shiny : Shininess::NotShiny, TID(), SID()}).value_or(PID());
 }
 
 u32 PKX::versionTID() const
@@ -35,123 +35,111 @@
 #include "SavUSUM.hpp"
 #include "SavXY.hpp"
 #include "SavLGPE.hpp"
+#include "crc.hpp"
 
 Sav::~Sav() { delete[] data; }
 
 u16 Sav::ccitt16(const u8* buf, u32 len)
 {
-    u16 crc = 0xFFFF;
-    for (u32 i = 0; i < len; i++)
-    {
-        crc ^= (u16)(buf[i] << 8);
-        for (u32 j = 0; j < 0x8; j++)
-        {
-            if ((crc & 0x8000) > 0)
-                crc = (u16)((crc << 1) ^ 0x1021);
-            else
-                crc <<= 1;
-        }
-    }
-    return crc;
+    return CRC::ccitt16(buf, len);
 }
 
-std::unique_ptr<Sav> Sav::getSave(u8* dt, size_t length)
+std::unique_ptr<Sav> Sav::getSave(std::unique_ptr<u8[]> dt, size_t length)
 {
     switch (length)
     {
         case 0x6CC00:
-            return std::make_unique<SavUSUM>(dt);
+            return std::make_unique<SavUSUM>(std::move(dt));
         case 0x6BE00:
-            return std::make_unique<SavSUMO>(dt);
+            return std::make_unique<SavSUMO>(std::move(dt));
         case 0x76000:
-            return std::make_unique<SavORAS>(dt);
+            return std::make_unique<SavORAS>(std::move(dt));
         case 0x65600:
-            return std::make_unique<SavXY>(dt);
+            return std::make_unique<SavXY>(std::move(dt));
         case 0x80000:
-            return checkDSType(dt);
+        {
+            DSSaveInfo info = detectDSSave(dt.get());
+            return getSave(std::move(dt), info);
+        }
         case 0xB8800:
         case 0x100000:
-            return std::make_unique<SavLGPE>(dt);
+            return std::make_unique<SavLGPE>(std::move(dt), length);
         default:
             return std::unique_ptr<Sav>(nullptr);
     }
 }
 
-bool Sav::isValidDSSave(u8* dt)
+Sav::DSSaveInfo Sav::detectDSSave(const u8* dt)
 {
+    DSSaveInfo ret;
     u16 chk1 = *(u16*)(dt + 0x24000 - 0x100 + 0x8C + 0xE);
     u16 actual1 = ccitt16(dt + 0x24000 - 0x100, 0x8C);
     if (chk1 == actual1)
     {
-        return true;
+        ret.valid = true;
+        ret.game = Game::BW;
+        return ret;
     }
     u16 chk2 = *(u16*)(dt + 0x26000 - 0x100 + 0x94 + 0xE);
     u16 actual2 = ccitt16(dt + 0x26000 - 0x100, 0x94);
     if (chk2 == actual2)
     {
-        return true;
+        ret.valid = true;
+        ret.game = Game::B2W2;
+        return ret;
     }
 
-    // Check for block identifiers
-    u8 dpPattern[] = { 0x00, 0xC1, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    u8 ptPattern[] = { 0x2C, 0xCF, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    u8 hgssPattern[] = { 0x28, 0xF6, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    if (validSequence(dt, dpPattern))
-        return true;
-    if (validSequence(dt, ptPattern))
-        return true;
-    if (validSequence(dt, hgssPattern))
-        return true;
-
-    // Check the other save
-    if (validSequence(dt, dpPattern, 0x40000))
-        return true;
-    if (validSequence(dt, ptPattern, 0x40000))
-        return true;
-    if (validSequence(dt, hgssPattern, 0x40000))
-        return true;
-    return false;
+    // Check for block identifiers, in the first save and then the other
+    static constexpr u8 patterns[][10] = {
+        { 0x00, 0xC1, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 }, // DP
+        { 0x2C, 0xCF, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 }, // Pt
+        { 0x28, 0xF6, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 }  // HGSS
+    };
+    static constexpr Game games[] = { Game::DP, Game::Pt, Game::HGSS };
+    for (u32 partition : { 0x0, 0x40000 })
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            if (validSequence(dt, patterns[i], partition))
+            {
+                ret.valid = true;
+                ret.game = games[i];
+                std::array<int, 2> counters = Sav4::counterOffsets(ret.game);
+                ret.generalPartition = Sav4::activePartition(dt, counters[0]);
+                ret.storagePartition = Sav4::activePartition(dt, counters[1]);
+                return ret;
+            }
+        }
+    }
+    return ret;
 }
 
-std::unique_ptr<Sav> Sav::checkDSType(u8* dt)
+std::unique_ptr<Sav> Sav::getSave(std::unique_ptr<u8[]> dt, const DSSaveInfo& info)
 {
-    u16 chk1 = *(u16*)(dt + 0x24000 - 0x100 + 0x8C + 0xE);
-    u16 actual1 = ccitt16(dt + 0x24000 - 0x100, 0x8C);
-    if (chk1 == actual1)
+    if (!info.valid)
     {
-        return std::make_unique<SavBW>(dt);
+        return nullptr;
     }
-    u16 chk2 = *(u16*)(dt + 0x26000 - 0x100 + 0x94 + 0xE);
-    u16 actual2 = ccitt16(dt + 0x26000 - 0x100, 0x94);
-    if (chk2 == actual2)
+    switch (info.game)
     {
-        return std::make_unique<SavB2W2>(dt);
+        case Game::BW:
+            return std::make_unique<SavBW>(std::move(dt));
+        case Game::B2W2:
+            return std::make_unique<SavB2W2>(std::move(dt));
+        case Game::DP:
+            return std::make_unique<SavDP>(std::move(dt));
+        case Game::Pt:
+            return std::make_unique<SavPT>(std::move(dt));
+        case Game::HGSS:
+            return std::make_unique<SavHGSS>(std::move(dt));
+        default:
+            return nullptr;
     }
-
-    // Check for block identifiers
-    u8 dpPattern[] = { 0x00, 0xC1, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    u8 ptPattern[] = { 0x2C, 0xCF, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    u8 hgssPattern[] = { 0x28, 0xF6, 0x00, 0x00, 0x23, 0x06, 0x06, 0x20, 0x00, 0x00 };
-    if (validSequence(dt, dpPattern))
-        return std::make_unique<SavDP>(dt);
-    if (validSequence(dt, ptPattern))
-        return std::make_unique<SavPT>(dt);
-    if (validSequence(dt, hgssPattern))
-        return std::make_unique<SavHGSS>(dt);
-
-    // Check the other save
-    if (validSequence(dt, dpPattern, 0x40000))
-        return std::make_unique<SavDP>(dt);
-    if (validSequence(dt, ptPattern, 0x40000))
-        return std::make_unique<SavPT>(dt);
-    if (validSequence(dt, hgssPattern, 0x40000))
-        return std::make_unique<SavHGSS>(dt);
-    return nullptr;
 }
 
-bool Sav::validSequence(u8* dt, u8* pattern, int shift)
+bool Sav::validSequence(const u8* dt, const u8* pattern, int shift)
 {
-    int ofs = *(u16*)(pattern) - 0xC + shift;
+    int ofs = *(const u16*)(pattern) - 0xC + shift;
     for (int i = 0; i < 10; i++)
         if (dt[i + ofs] != pattern[i])
             return false;
@@ -173,6 +161,28 @@ void Sav::transfer(std::shared_ptr<PKX> &pk)
     }
 }
 
+u32 Sav::find(const PKFilter& filter, u8 box) const
+{
+    u32 ret = 0;
+    u32 size = boxOffset(box, 1) - boxOffset(box, 0);
+    u8 scratch[260];
+    for (u8 slot = 0; slot < 30 && box * 30 + slot < maxSlot(); slot++)
+    {
+        const u8* pkm = data + boxOffset(box, slot);
+        if (!decryptedBoxes)
+        {
+            std::copy(pkm, pkm + size, scratch);
+            PKX::cryptBoxes(generation(), scratch, 1, size, true);
+            pkm = scratch;
+        }
+        if (filter.matches(generation(), pkm))
+        {
+            ret |= 1 << slot;
+        }
+    }
+    return ret;
+}
+
 void Sav::fixParty()
 {
     // Poor man's bubble sort-like thing
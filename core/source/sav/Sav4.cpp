@@ -25,84 +25,101 @@
 */
 
 #include "Sav4.hpp"
+#include "PKXView.hpp"
 #include "PGT.hpp"
 
-void Sav4::GBO(void)
+std::array<int, 2> Sav4::counterOffsets(Game game)
+{
+    // general, storage
+    return {game == Game::DP ? 0xC0F0 : game == Game::Pt ? 0xCF1C : 0xF618, game == Game::DP ? 0x1E2D0 : game == Game::Pt ? 0x1F100 : 0x21A00};
+}
+
+int Sav4::activePartition(const u8* dt, int ofs)
 {
-    int ofs = GBOOffset;
-    u8 temp[10], dummy[10];
+    u8 dummy[10];
     std::fill_n(dummy, 10, 0xFF);
-    
-    std::copy(data + ofs, data + ofs + 10, temp);
-    if (!memcmp(temp, dummy, 10)) {
-        gbo = 0x40000;
-        return;
+
+    if (!memcmp(dt + ofs, dummy, 10)) {
+        return 0x40000;
     }
-    
-    std::copy(data + ofs + 0x40000, data + ofs + 0x4000A, temp);
-    if (!memcmp(temp, dummy, 10)) {
-        gbo = 0;
-        return;
+
+    if (!memcmp(dt + ofs + 0x40000, dummy, 10)) {
+        return 0;
     }
 
-    u16 c1 = *(u16*)(data + ofs), c2 = *(u16*)(data + ofs + 0x40000);
-    
-    gbo = (c1 >= c2) ? 0 : 0x40000;
+    u16 c1 = *(const u16*)(dt + ofs), c2 = *(const u16*)(dt + ofs + 0x40000);
+
+    return (c1 >= c2) ? 0 : 0x40000;
+}
+
+void Sav4::GBO(void)
+{
+    gbo = activePartition(data, counterOffsets(game)[0]);
 }
 
 void Sav4::SBO(void)
 {
-    int ofs = SBOOffset;
-    u8 temp[10], dummy[10];
-    std::fill_n(dummy, 10, 0xFF);
-    
-    std::copy(data + ofs, data + ofs + 10, temp);
-    if (!memcmp(temp, dummy, 10)) {
-        sbo = 0x40000;
-        return;
-    }
-    
-    std::copy(data + ofs + 0x40000, data + ofs + 0x4000A, temp);
-    if (!memcmp(temp, dummy, 10)) {
-        sbo = 0;
-        return;
-    }
+    sbo = activePartition(data, counterOffsets(game)[1]);
+}
 
-    u16 c1 = *(u16*)(data + ofs), c2 = *(u16*)(data + ofs + 0x40000);
-    
-    sbo = (c1 >= c2) ? 0 : 0x40000;
+std::array<int, 3> Sav4::generalBlock(void) const
+{
+    // start, end, chkoffset
+    return {0x0, game == Game::DP ? 0xC0EC : game == Game::Pt ? 0xCF18 : 0xF618, game == Game::DP ? 0xC0FE : game == Game::Pt ? 0xCF2A : 0xF626};
+}
+
+std::array<int, 3> Sav4::storageBlock(void) const
+{
+    return {game == Game::DP ? 0xC100 : game == Game::Pt ? 0xCF2C : 0xF700, game == Game::DP ? 0x1E2CC : game == Game::Pt ? 0x1F0FC : 0x21A00, game == Game::DP ? 0x1E2DE : game == Game::Pt ? 0x1F10E : 0x21A0E};
 }
 
 void Sav4::resign(void)
 {
-    u8* tmp = new u8[0x12300];
     u16 cs;
-    // start, end, chkoffset
-    int general[3] = {0x0, game == Game::DP ? 0xC0EC : game == Game::Pt ? 0xCF18 : 0xF618, game == Game::DP ? 0xC0FE : game == Game::Pt ? 0xCF2A : 0xF626};
-    int storage[3] = {game == Game::DP ? 0xC100 : game == Game::Pt ? 0xCF2C : 0xF700, game == Game::DP ? 0x1E2CC : game == Game::Pt ? 0x1F0FC : 0x21A00, game == Game::DP ? 0x1E2DE : game == Game::Pt ? 0x1F10E : 0x21A0E};
-    
-    std::copy(data + gbo + general[0], data + gbo + general[1], tmp);
-    cs = ccitt16(tmp, general[1] - general[0]);
-    *(u16*)(data + gbo + general[2]) = cs;
+    std::array<int, 3> general = generalBlock();
+    std::array<int, 3> storage = storageBlock();
+
+    if (dirtyBlocks[0])
+    {
+        cs = ccitt16(data + gbo + general[0], general[1] - general[0]);
+        *(u16*)(data + gbo + general[2]) = cs;
+    }
+
+    if (dirtyBlocks[1])
+    {
+        cs = ccitt16(data + sbo + storage[0], storage[1] - storage[0]);
+        *(u16*)(data + sbo + storage[2]) = cs;
+    }
+
+    dirtyBlocks.reset();
+}
 
-    std::copy(data + sbo + storage[0], data + sbo + storage[1], tmp);
-    cs = ccitt16(tmp, storage[1] - storage[0]);
-    *(u16*)(data + sbo + storage[2]) = cs;
+void Sav4::markDirty(u32 offset, u32 size)
+{
+    std::array<int, 3> general = generalBlock();
+    std::array<int, 3> storage = storageBlock();
 
-    delete[] tmp;
+    if (offset < u32(gbo + general[1]) && offset + size > u32(gbo + general[0]))
+    {
+        dirtyBlocks.set(0);
+    }
+    if (offset < u32(sbo + storage[1]) && offset + size > u32(sbo + storage[0]))
+    {
+        dirtyBlocks.set(1);
+    }
 }
 
 u16 Sav4::TID(void) const { return *(u16*)(data + Trainer1 + 0x10); }
-void Sav4::TID(u16 v) { *(u16*)(data + Trainer1 + 0x10) = v; }
+void Sav4::TID(u16 v) { *(u16*)(data + Trainer1 + 0x10) = v; markDirty(Trainer1 + 0x10, 2); }
 
 u16 Sav4::SID(void) const { return *(u16*)(data + Trainer1 + 0x12); }
-void Sav4::SID(u16 v) { *(u16*)(data + Trainer1 + 0x12) = v; }
+void Sav4::SID(u16 v) { *(u16*)(data + Trainer1 + 0x12) = v; markDirty(Trainer1 + 0x12, 2); }
 
 u8 Sav4::version(void) const { return game == DP ? 10 : game == Pt ? 12 : 7; }
 void Sav4::version(u8 v) { (void)v; }
 
 u8 Sav4::gender(void) const { return data[Trainer1 + 0x18]; }
-void Sav4::gender(u8 v) { data[Trainer1 + 0x18] = v; }
+void Sav4::gender(u8 v) { data[Trainer1 + 0x18] = v; markDirty(Trainer1 + 0x18); }
 
 u8 Sav4::subRegion(void) const { return 0; } // Unused
 void Sav4::subRegion(u8 v) { (void)v; }
@@ -114,16 +131,16 @@ u8 Sav4::consoleRegion(void) const { return 0; } // Unused
 void Sav4::consoleRegion(u8 v) { (void)v; }
 
 u8 Sav4::language(void) const { return data[Trainer1 + 0x19]; }
-void Sav4::language(u8 v) { data[Trainer1 + 0x19] = v; }
+void Sav4::language(u8 v) { data[Trainer1 + 0x19] = v; markDirty(Trainer1 + 0x19); }
 
 std::string Sav4::otName(void) const { return StringUtils::getString4(data, Trainer1, 8); }
-void Sav4::otName(const std::string& v) { StringUtils::setString4(data, v, Trainer1, 8); }
+void Sav4::otName(const std::string& v) { StringUtils::setString4(data, v, Trainer1, 8); markDirty(Trainer1, 16); }
 
 u32 Sav4::money(void) const { return *(u32*)(data + Trainer1 + 0x14); }
-void Sav4::money(u32 v) { *(u32*)(data + Trainer1 + 0x14) = v; }
+void Sav4::money(u32 v) { *(u32*)(data + Trainer1 + 0x14) = v; markDirty(Trainer1 + 0x14, 4); }
 
 u32 Sav4::BP(void) const { return *(u16*)(data + Trainer1 + 0x20); } // Returns Coins @ Game Corner
-void Sav4::BP(u32 v) { *(u16*)(data + Trainer1 + 0x20) = v; }
+void Sav4::BP(u32 v) { *(u16*)(data + Trainer1 + 0x20) = v; markDirty(Trainer1 + 0x20, 2); }
 
 u8 Sav4::badges(void) const
 {
@@ -145,13 +162,13 @@ u8 Sav4::badges(void) const
 }
 
 u16 Sav4::playedHours(void) const { return *(u16*)(data + Trainer1 + 0x22); }
-void Sav4::playedHours(u16 v) { *(u16*)(data + Trainer1 + 0x22) = v; }
+void Sav4::playedHours(u16 v) { *(u16*)(data + Trainer1 + 0x22) = v; markDirty(Trainer1 + 0x22, 2); }
 
 u8 Sav4::playedMinutes(void) const { return data[Trainer1 + 0x24]; }
-void Sav4::playedMinutes(u8 v) { data[Trainer1 + 0x24] = v; }
+void Sav4::playedMinutes(u8 v) { data[Trainer1 + 0x24] = v; markDirty(Trainer1 + 0x24); }
 
 u8 Sav4::playedSeconds(void) const { return data[Trainer1 + 0x25]; }
-void Sav4::playedSeconds(u8 v) { data[Trainer1 + 0x25] = v; }
+void Sav4::playedSeconds(u8 v) { data[Trainer1 + 0x25] = v; markDirty(Trainer1 + 0x25); }
 
 u8 Sav4::currentBox(void) const
 {
@@ -163,6 +180,7 @@ void Sav4::currentBox(u8 v)
 {
     int ofs = game == Game::HGSS ? boxOffset(maxBoxes(), 0) : Box - 4;
     data[ofs] = v;
+    markDirty(ofs);
 }
 
 u32 Sav4::boxOffset(u8 box, u8 slot) const { return Box + 136*box*30 + (game == Game::HGSS ? box*0x10 : 0) + slot*136; }
@@ -170,10 +188,7 @@ u32 Sav4::partyOffset(u8 slot) const { return Party + slot*236; }
 
 std::shared_ptr<PKX> Sav4::pkm(u8 slot) const
 {
-    u8 buf[236];
-    u32 ofs = partyOffset(slot);
-    std::copy(data + ofs, data + ofs + 236, buf);
-    return std::make_shared<PK4>(buf, true, true);
+    return PKX::create<PK4>(data + partyOffset(slot), true, true);
 }
 
 void Sav4::pkm(std::shared_ptr<PKX> pk, u8 slot)
@@ -184,25 +199,25 @@ void Sav4::pkm(std::shared_ptr<PKX> pk, u8 slot)
 
     if (pk->getLength() != 236)
     {        
+        std::array<u16, 6> stats;
+        pk4->stats(stats);
         for (int i = 0; i < 6; i++)
         {
-            pk4->partyStat(i, pk4->stat(i));
+            pk4->partyStat(i, stats[i]);
         }
         pk4->partyLevel(pk4->level());
-        pk4->partyCurrHP(pk4->stat(0));
+        pk4->partyCurrHP(stats[0]);
     }
 
     pk4->encrypt();
     std::fill(data + partyOffset(slot), data + partyOffset(slot + 1), (u8)0);
     std::copy(pk4->rawData(), pk4->rawData() + pk4->getLength(), data + partyOffset(slot));
+    markDirty(partyOffset(slot), 236);
 }
 
 std::shared_ptr<PKX> Sav4::pkm(u8 box, u8 slot, bool ekx) const
 {
-    u8 buf[136];
-    u32 ofs = boxOffset(box, slot);
-    std::copy(data + ofs, data + ofs + 136, buf);
-    return std::make_shared<PK4>(buf, ekx);
+    return PKX::create<PK4>(data + boxOffset(box, slot), ekx);
 }
 
 void Sav4::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
@@ -214,6 +229,12 @@ void Sav4::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
     }
 
     std::copy(pk->rawData(), pk->rawData() + 136, data + boxOffset(box, slot));
+    markDirty(boxOffset(box, slot), 136);
+}
+
+PKX& Sav4::pkmView(PKXView& view, u8 box, u8 slot)
+{
+    return view.emplace<PK4>(data + boxOffset(box, slot), false, false, true);
 }
 
 void Sav4::trade(std::shared_ptr<PKX> pk)
@@ -229,17 +250,11 @@ void Sav4::trade(std::shared_ptr<PKX> pk)
 
 void Sav4::cryptBoxData(bool crypted)
 {
+    decryptedBoxes = crypted;
     for (u8 box = 0; box < boxes; box++)
     {
-        for (u8 slot = 0; slot < 30; slot++)
-        {
-            std::shared_ptr<PKX> pk4 = pkm(box, slot, crypted);
-            if (!crypted)
-            {
-                pk4->encrypt();
-            }
-            pkm(pk4, box, slot, false);
-        }
+        PKX::cryptBoxes(Generation::FOUR, data + boxOffset(box, 0), 30, 136, crypted);
+        markDirty(boxOffset(box, 0), 30 * 136);
     }
 }
 
@@ -248,6 +263,8 @@ void Sav4::mysteryGift(WCX& wc, int& pos)
     PGT* pgt = (PGT*)&wc;
     *(data + WondercardFlags + (2047 >> 3)) = 0x80;
     std::copy(pgt->rawData(), pgt->rawData() + PGT::length, data + WondercardData + pos * PGT::length);
+    markDirty(WondercardFlags + (2047 >> 3));
+    markDirty(WondercardData + pos * PGT::length, PGT::length);
     pos++;
 }
 
@@ -256,10 +273,11 @@ std::string Sav4::boxName(u8 box) const { return StringUtils::getString4(data, b
 void Sav4::boxName(u8 box, const std::string& name)
 {
     StringUtils::setString4(data, name, boxOffset(18, 0) + box*0x28 + (game == Game::HGSS ? 0x8 : 0), 9);
+    markDirty(boxOffset(18, 0) + box*0x28 + (game == Game::HGSS ? 0x8 : 0), 18);
 }
 
 u8 Sav4::partyCount(void) const { return data[Party - 4]; }
-void Sav4::partyCount(u8 v) { data[Party - 4] = v; }
+void Sav4::partyCount(u8 v) { data[Party - 4] = v; markDirty(Party - 4); }
 
 void Sav4::dex(std::shared_ptr<PKX> pk)
 {
@@ -272,6 +290,8 @@ void Sav4::dex(std::shared_ptr<PKX> pk)
     int bit = pk->species() - 1;
     u8 mask = (u8)(1 << (bit & 7));
     int ofs = PokeDex + (bit >> 3) + 0x4;
+    // Every flag and form written below, including by setForms, lives in the general block
+    markDirty(PokeDex);
 
     /* 4 BitRegions with 0x40*8 bits
     * Region 0: Caught (Captured/Owned) flags
@@ -670,27 +690,35 @@ void Sav4::item(Item& item, Pouch pouch, u16 slot)
     {
         case NormalItem:
             std::copy(write.first, write.first + write.second, data + PouchHeldItem + slot * 4);
+            markDirty(PouchHeldItem + slot * 4, write.second);
             break;
         case KeyItem:
             std::copy(write.first, write.first + write.second, data + PouchKeyItem + slot * 4);
+            markDirty(PouchKeyItem + slot * 4, write.second);
             break;
         case TM:
             std::copy(write.first, write.first + write.second, data + PouchTMHM + slot * 4);
+            markDirty(PouchTMHM + slot * 4, write.second);
             break;
         case Mail:
             std::copy(write.first, write.first + write.second, data + MailItems + slot * 4);
+            markDirty(MailItems + slot * 4, write.second);
             break;
         case Medicine:
             std::copy(write.first, write.first + write.second, data + PouchMedicine + slot * 4);
+            markDirty(PouchMedicine + slot * 4, write.second);
             break;
         case Berry:
             std::copy(write.first, write.first + write.second, data + PouchBerry + slot * 4);
+            markDirty(PouchBerry + slot * 4, write.second);
             break;
         case Ball:
             std::copy(write.first, write.first + write.second, data + PouchBalls + slot * 4);
+            markDirty(PouchBalls + slot * 4, write.second);
             break;
         case Battle:
             std::copy(write.first, write.first + write.second, data + BattleItems + slot * 4);
+            markDirty(BattleItems + slot * 4, write.second);
             break;
         default:
             return;
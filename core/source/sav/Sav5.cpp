@@ -25,18 +25,19 @@
 */
 
 #include "Sav5.hpp"
+#include "PKXView.hpp"
 
 u16 Sav5::TID(void) const { return *(u16*)(data + Trainer1 + 0x14); }
-void Sav5::TID(u16 v) { *(u16*)(data + Trainer1 + 0x14) = v; }
+void Sav5::TID(u16 v) { *(u16*)(data + Trainer1 + 0x14) = v; markDirty(Trainer1 + 0x14, 2); }
 
 u16 Sav5::SID(void) const { return *(u16*)(data + Trainer1 + 0x16); }
-void Sav5::SID(u16 v) { *(u16*)(data + Trainer1 + 0x16) = v; }
+void Sav5::SID(u16 v) { *(u16*)(data + Trainer1 + 0x16) = v; markDirty(Trainer1 + 0x16, 2); }
 
 u8 Sav5::version(void) const { return data[Trainer1 + 0x1F]; }
-void Sav5::version(u8 v) { data[Trainer1 + 0x1F] = v; }
+void Sav5::version(u8 v) { data[Trainer1 + 0x1F] = v; markDirty(Trainer1 + 0x1F); }
 
 u8 Sav5::gender(void) const { return data[Trainer1 + 0x21]; }
-void Sav5::gender(u8 v) { data[Trainer1 + 0x21] = v; }
+void Sav5::gender(u8 v) { data[Trainer1 + 0x21] = v; markDirty(Trainer1 + 0x21); }
 
 u8 Sav5::subRegion(void) const { return 0; } // Unused
 void Sav5::subRegion(u8 v) { (void)v; }
@@ -48,16 +49,16 @@ u8 Sav5::consoleRegion(void) const { return 0; } // Unused
 void Sav5::consoleRegion(u8 v) { (void)v; }
 
 u8 Sav5::language(void) const { return data[Trainer1 + 0x1E]; }
-void Sav5::language(u8 v) { data[Trainer1 + 0x1E] = v; }
+void Sav5::language(u8 v) { data[Trainer1 + 0x1E] = v; markDirty(Trainer1 + 0x1E); }
 
 std::string Sav5::otName(void) const { return StringUtils::getString(data, Trainer1 + 0x4, 8, u'\uFFFF'); }
-void Sav5::otName(const std::string& v) { StringUtils::setString(data, v, Trainer1 + 0x4, 8, u'\uFFFF', 0); }
+void Sav5::otName(const std::string& v) { StringUtils::setString(data, v, Trainer1 + 0x4, 8, u'\uFFFF', 0); markDirty(Trainer1 + 0x4, 16); }
 
 u32 Sav5::money(void) const { return *(u32*)(data + Trainer2); }
-void Sav5::money(u32 v) { *(u32*)(data + Trainer2) = v; }
+void Sav5::money(u32 v) { *(u32*)(data + Trainer2) = v; markDirty(Trainer2, 4); }
 
 u32 Sav5::BP(void) const { return *(u32*)(data + BattleSubway); }
-void Sav5::BP(u32 v) { *(u32*)(data + BattleSubway) = v; }
+void Sav5::BP(u32 v) { *(u32*)(data + BattleSubway) = v; markDirty(BattleSubway, 4); }
 
 u8 Sav5::badges(void) const
 {
@@ -71,25 +72,23 @@ u8 Sav5::badges(void) const
 }
 
 u16 Sav5::playedHours(void) const { return *(u16*)(data + Trainer1 + 0x24); }
-void Sav5::playedHours(u16 v) { *(u16*)(data + Trainer1 + 0x24) = v; }
+void Sav5::playedHours(u16 v) { *(u16*)(data + Trainer1 + 0x24) = v; markDirty(Trainer1 + 0x24, 2); }
 
 u8 Sav5::playedMinutes(void) const { return data[Trainer1 + 0x26]; }
-void Sav5::playedMinutes(u8 v) { data[Trainer1 + 0x26] = v; }
+void Sav5::playedMinutes(u8 v) { data[Trainer1 + 0x26] = v; markDirty(Trainer1 + 0x26); }
 
 u8 Sav5::playedSeconds(void) const { return data[Trainer1 + 0x27]; }
-void Sav5::playedSeconds(u8 v) { data[Trainer1 + 0x27] = v; }
+void Sav5::playedSeconds(u8 v) { data[Trainer1 + 0x27] = v; markDirty(Trainer1 + 0x27); }
 
 u8 Sav5::currentBox(void) const { return data[PCLayout]; }
-void Sav5::currentBox(u8 v) { data[PCLayout] = v; }
+void Sav5::currentBox(u8 v) { data[PCLayout] = v; markDirty(PCLayout); }
 
 u32 Sav5::boxOffset(u8 box, u8 slot) const { return Box + 136*box*30 + 0x10*box + 136*slot ; }
 u32 Sav5::partyOffset(u8 slot) const { return Party + 8 + 220*slot; }
 
 std::shared_ptr<PKX> Sav5::pkm(u8 slot) const
 {
-    u8 buf[220];
-    std::copy(data + partyOffset(slot), data + partyOffset(slot) + 220, buf);
-    return std::make_shared<PK5>(buf, true, true);
+    return PKX::create<PK5>(data + partyOffset(slot), true, true);
 }
 
 void Sav5::pkm(std::shared_ptr<PKX> pk, u8 slot)
@@ -100,24 +99,25 @@ void Sav5::pkm(std::shared_ptr<PKX> pk, u8 slot)
 
     if (pk->getLength() != 220)
     {
+        std::array<u16, 6> stats;
+        pk5->stats(stats);
         for (int i = 0; i < 6; i++)
         {
-            pk5->partyStat(i, pk5->stat(i));
+            pk5->partyStat(i, stats[i]);
         }
         pk5->partyLevel(pk5->level());
-        pk5->partyCurrHP(pk5->stat(0));
+        pk5->partyCurrHP(stats[0]);
     }
 
     pk5->encrypt();
     std::fill(data + partyOffset(slot), data + partyOffset(slot + 1), (u8)0);
-    std::copy(pk5->rawData(), pk5->rawData() + pk5->getLength(), data + partyOffset(slot));    
+    std::copy(pk5->rawData(), pk5->rawData() + pk5->getLength(), data + partyOffset(slot));
+    markDirty(partyOffset(slot), 220);
 }
 
 std::shared_ptr<PKX> Sav5::pkm(u8 box, u8 slot, bool ekx) const
 {
-    u8 buf[136];
-    std::copy(data + boxOffset(box, slot), data + boxOffset(box, slot) + 136, buf);
-    return std::make_shared<PK5>(buf, ekx);
+    return PKX::create<PK5>(data + boxOffset(box, slot), ekx);
 }
 
 void Sav5::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
@@ -129,6 +129,12 @@ void Sav5::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
     }
 
     std::copy(pk->rawData(), pk->rawData() + 136, data + boxOffset(box, slot));
+    markDirty(boxOffset(box, slot), 136);
+}
+
+PKX& Sav5::pkmView(PKXView& view, u8 box, u8 slot)
+{
+    return view.emplace<PK5>(data + boxOffset(box, slot), false, false, true);
 }
 
 void Sav5::trade(std::shared_ptr<PKX> pk)
@@ -144,17 +150,11 @@ void Sav5::trade(std::shared_ptr<PKX> pk)
 
 void Sav5::cryptBoxData(bool crypted)
 {
+    decryptedBoxes = crypted;
     for (u8 box = 0; box < boxes; box++)
     {
-        for (u8 slot = 0; slot < 30; slot++)
-        {
-            std::shared_ptr<PKX> pk5 = pkm(box, slot, crypted);
-            if (!crypted)
-            {
-                pk5->encrypt();
-            }
-            pkm(pk5, box, slot, false);
-        }
+        PKX::cryptBoxes(Generation::FIVE, data + boxOffset(box, 0), 30, 136, crypted);
+        markDirty(boxOffset(box, 0), 30 * 136);
     }
 }
 
@@ -214,9 +214,11 @@ void Sav5::dex(std::shared_ptr<PKX> pk)
 
     // Set the Species Owned Flag
     data[ofs + brSize*0] |= (u8)(1 << (bit % 8));
+    markDirty(ofs + brSize*0);
 
     // Set the [Species/Gender/Shiny] Seen Flag
     data[PokeDex + 0x8 + shiftoff + bit / 8] |= (u8)(1 << (bit&7));
+    markDirty(PokeDex + 0x8 + shiftoff + bit / 8);
 
     // Set the Display flag if none are set
     bool displayed = false;
@@ -225,7 +227,10 @@ void Sav5::dex(std::shared_ptr<PKX> pk)
     displayed |= (data[ofs + brSize*7] & (u8)(1 << (bit&7))) != 0;
     displayed |= (data[ofs + brSize*8] & (u8)(1 << (bit&7))) != 0;
     if (!displayed) // offset is already biased by brSize, reuse shiftoff but for the display flags.
+    {
         data[ofs + brSize*(shift + 4)] |= (u8)(1 << (bit&7));
+        markDirty(ofs + brSize*(shift + 4));
+    }
 
     // Set the Language
     if (bit < 493) // shifted by 1, Gen5 species do not have international language bits
@@ -233,10 +238,11 @@ void Sav5::dex(std::shared_ptr<PKX> pk)
         int lang = pk->language() - 1; if (lang > 5) lang--; // 0-6 language vals
         if (lang < 0) lang = 1;
         data[PokeDexLanguageFlags + ((bit*7 + lang)>>3)] |= (u8)(1 << ((bit*7 + lang) & 7));
+        markDirty(PokeDexLanguageFlags + ((bit*7 + lang)>>3));
     }
 
     // Formes
-    int fc = PersonalBWB2W2::formCount(pk->species());
+    int fc = Personal<Generation::FIVE>::formCount(pk->species());
     int f = dexFormIndex(pk->species(), fc);
     if (f < 0) return;
 
@@ -246,6 +252,7 @@ void Sav5::dex(std::shared_ptr<PKX> pk)
 
     // Set Form Seen Flag
     data[formDex + formLen*shiny + (bit>>3)] |= (u8)(1 << (bit&7));
+    markDirty(formDex + formLen*shiny + (bit>>3));
 
     // Set displayed Flag if necessary, check all flags
     for (int i = 0; i < fc; i++)
@@ -258,6 +265,7 @@ void Sav5::dex(std::shared_ptr<PKX> pk)
     }
     bit = f + pk->alternativeForm();
     data[formDex + formLen * (2 + shiny) + (bit>>3)] |= (u8)(1 << (bit&7));
+    markDirty(formDex + formLen * (2 + shiny) + (bit>>3));
 }
 
 int Sav5::dexSeen(void) const
@@ -297,6 +305,8 @@ void Sav5::mysteryGift(WCX& wc, int& pos)
 
     *(data + WondercardFlags + pgf->ID()) |= 0x1 << (pgf->ID() & 7);
     std::copy(pgf->rawData(), pgf->rawData() + PGF::length, data + WondercardData + pos * PGF::length);
+    markDirty(WondercardFlags + pgf->ID());
+    markDirty(WondercardData + pos * PGF::length, PGF::length);
     pos = (pos + 1) % 12;
 }
 
@@ -305,10 +315,11 @@ std::string Sav5::boxName(u8 box) const { return StringUtils::getString(data, PC
 void Sav5::boxName(u8 box, const std::string& name)
 {
     StringUtils::setString(data, name, PCLayout + 0x28 * box + 4, 9, u'\uFFFF', 0);
+    markDirty(PCLayout + 0x28 * box + 4, 18);
 }
 
 u8 Sav5::partyCount(void) const { return data[Party + 4]; }
-void Sav5::partyCount(u8 v) { data[Party + 4] = v; }
+void Sav5::partyCount(u8 v) { data[Party + 4] = v; markDirty(Party + 4); }
 
 std::shared_ptr<PKX> Sav5::emptyPkm() const
 {
@@ -368,6 +379,7 @@ void Sav5::cryptMysteryGiftData()
         seed = seed * 0x41C64E6D + 0x6073; // Replace with seedStep?
         *(u16*)(data + WondercardFlags + i) ^= (seed >> 16);
     }
+    markDirty(WondercardFlags, 0xA90);
 }
 
 std::unique_ptr<WCX> Sav5::mysteryGift(int pos) const
@@ -383,18 +395,23 @@ void Sav5::item(Item& item, Pouch pouch, u16 slot)
     {
         case NormalItem:
             std::copy(write.first, write.first + write.second, data + PouchHeldItem + slot * 4);
+            markDirty(PouchHeldItem + slot * 4, write.second);
             break;
         case KeyItem:
             std::copy(write.first, write.first + write.second, data + PouchKeyItem + slot * 4);
+            markDirty(PouchKeyItem + slot * 4, write.second);
             break;
         case TM:
             std::copy(write.first, write.first + write.second, data + PouchTMHM + slot * 4);
+            markDirty(PouchTMHM + slot * 4, write.second);
             break;
         case Medicine:
             std::copy(write.first, write.first + write.second, data + PouchMedicine + slot * 4);
+            markDirty(PouchMedicine + slot * 4, write.second);
             break;
         case Berry:
             std::copy(write.first, write.first + write.second, data + PouchBerry + slot * 4);
+            markDirty(PouchBerry + slot * 4, write.second);
             break;
         default:
             return;
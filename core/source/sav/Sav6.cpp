@@ -25,39 +25,41 @@
 */
 
 #include "Sav6.hpp"
+#include "PKXView.hpp"
 
 u16 Sav6::TID(void) const { return *(u16*)(data + TrainerCard); }
-void Sav6::TID(u16 v) { *(u16*)(data + TrainerCard) = v; }
+void Sav6::TID(u16 v) { *(u16*)(data + TrainerCard) = v; markDirty(TrainerCard, 2); }
 
 u16 Sav6::SID(void) const { return *(u16*)(data + TrainerCard + 2); }
-void Sav6::SID(u16 v) { *(u16*)(data + TrainerCard + 2) = v; }
+void Sav6::SID(u16 v) { *(u16*)(data + TrainerCard + 2) = v; markDirty(TrainerCard + 2, 2); }
 
 u8 Sav6::version(void) const { return data[TrainerCard + 4]; }
-void Sav6::version(u8 v) { data[TrainerCard + 4] = v; }
+void Sav6::version(u8 v) { data[TrainerCard + 4] = v; markDirty(TrainerCard + 4); }
 
 u8 Sav6::gender(void) const { return data[TrainerCard + 5]; }
-void Sav6::gender(u8 v) { data[TrainerCard + 5] = v; }
+void Sav6::gender(u8 v) { data[TrainerCard + 5] = v; markDirty(TrainerCard + 5); }
 
 u8 Sav6::subRegion(void) const { return data[TrainerCard + 0x26]; }
-void Sav6::subRegion(u8 v) { data[TrainerCard + 0x26] = v; }
+void Sav6::subRegion(u8 v) { data[TrainerCard + 0x26] = v; markDirty(TrainerCard + 0x26); }
 
 u8 Sav6::country(void) const { return data[TrainerCard + 0x27]; }
-void Sav6::country(u8 v) { data[TrainerCard + 0x27] = v; }
+void Sav6::country(u8 v) { data[TrainerCard + 0x27] = v; markDirty(TrainerCard + 0x27); }
 
 u8 Sav6::consoleRegion(void) const { return data[TrainerCard + 0x2C]; }
-void Sav6::consoleRegion(u8 v) { data[TrainerCard + 0x2C] = v; }
+void Sav6::consoleRegion(u8 v) { data[TrainerCard + 0x2C] = v; markDirty(TrainerCard + 0x2C); }
 
 u8 Sav6::language(void) const { return data[TrainerCard + 0x2D]; }
-void Sav6::language(u8 v) { data[TrainerCard + 0x2D] = v; }
+void Sav6::language(u8 v) { data[TrainerCard + 0x2D] = v; markDirty(TrainerCard + 0x2D); }
 
 std::string Sav6::otName(void) const { return StringUtils::getString(data, TrainerCard + 0x48, 13); }
-void Sav6::otName(const std::string& v) { StringUtils::setString(data, v, TrainerCard + 0x48, 13); }
+std::u16string_view Sav6::otNameView(void) const { return StringUtils::getStringView(data, TrainerCard + 0x48, 13); }
+void Sav6::otName(const std::string& v) { StringUtils::setString(data, v, TrainerCard + 0x48, 13); markDirty(TrainerCard + 0x48, 26); }
 
 u32 Sav6::money(void) const { return *(u32*)(data + Trainer2 + 0x8); }
-void Sav6::money(u32 v) { *(u32*)(data + Trainer2 + 0x8) = v; }
+void Sav6::money(u32 v) { *(u32*)(data + Trainer2 + 0x8) = v; markDirty(Trainer2 + 0x8, 4); }
 
 u32 Sav6::BP(void) const { return *(u32*)(data + Trainer2 + (game == Game::XY ? 0x3C : 0x30)); }
-void Sav6::BP(u32 v) { *(u32*)(data + Trainer2 + (game == Game::XY ? 0x3C : 0x30)) = v; }
+void Sav6::BP(u32 v) { *(u32*)(data + Trainer2 + (game == Game::XY ? 0x3C : 0x30)) = v; markDirty(Trainer2 + (game == Game::XY ? 0x3C : 0x30), 4); }
 
 u8 Sav6::badges(void) const
 {
@@ -71,16 +73,16 @@ u8 Sav6::badges(void) const
 }
 
 u16 Sav6::playedHours(void) const { return *(u16*)(data + PlayTime); }
-void Sav6::playedHours(u16 v) { *(u16*)(data + PlayTime) = v; }
+void Sav6::playedHours(u16 v) { *(u16*)(data + PlayTime) = v; markDirty(PlayTime, 2); }
 
 u8 Sav6::playedMinutes(void) const { return *(u8*)(data + PlayTime + 2); }
-void Sav6::playedMinutes(u8 v) { *(u8*)(data + PlayTime + 2) = v; }
+void Sav6::playedMinutes(u8 v) { *(u8*)(data + PlayTime + 2) = v; markDirty(PlayTime + 2); }
 
 u8 Sav6::playedSeconds(void) const { return *(u8*)(data + PlayTime + 3); }
-void Sav6::playedSeconds(u8 v) { *(u8*)(data + PlayTime + 3) = v; }
+void Sav6::playedSeconds(u8 v) { *(u8*)(data + PlayTime + 3) = v; markDirty(PlayTime + 3); }
 
 u8 Sav6::currentBox(void) const { return data[LastViewedBox]; }
-void Sav6::currentBox(u8 v) { data[LastViewedBox] = v; }
+void Sav6::currentBox(u8 v) { data[LastViewedBox] = v; markDirty(LastViewedBox); }
 
 u32 Sav6::boxOffset(u8 box, u8 slot) const { return Box + 232*30*box + 232*slot; }
 
@@ -88,9 +90,7 @@ u32 Sav6::partyOffset(u8 slot) const { return Party + 260*slot; }
 
 std::shared_ptr<PKX> Sav6::pkm(u8 slot) const
 {
-    u8 tmp[260];
-    std::copy(data + partyOffset(slot), data + partyOffset(slot) + 260, tmp);
-    return std::make_shared<PK6>(tmp, true, true);
+    return PKX::create<PK6>(data + partyOffset(slot), true, true);
 }
 
 void Sav6::pkm(std::shared_ptr<PKX> pk, u8 slot)
@@ -101,24 +101,25 @@ void Sav6::pkm(std::shared_ptr<PKX> pk, u8 slot)
 
     if (pk->getLength() != 260)
     {
+        std::array<u16, 6> stats;
+        pk6->stats(stats);
         for (int i = 0; i < 6; i++)
         {
-            pk6->partyStat(i, pk6->stat(i));
+            pk6->partyStat(i, stats[i]);
         }
         pk6->partyLevel(pk6->level());
-        pk6->partyCurrHP(pk6->stat(0));
+        pk6->partyCurrHP(stats[0]);
     }
 
     pk6->encrypt();
     std::fill(data + partyOffset(slot), data + partyOffset(slot + 1), (u8)0);
     std::copy(pk6->rawData(), pk6->rawData() + pk6->getLength(), data + partyOffset(slot));
+    markDirty(partyOffset(slot), 260);
 }
 
 std::shared_ptr<PKX> Sav6::pkm(u8 box, u8 slot, bool ekx) const
 {
-    u8 tmp[232];
-    std::copy(data + boxOffset(box, slot), data + boxOffset(box, slot) + 232, tmp);
-    return std::make_shared<PK6>(tmp, ekx);
+    return PKX::create<PK6>(data + boxOffset(box, slot), ekx);
 }
 
 void Sav6::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
@@ -130,6 +131,12 @@ void Sav6::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
     }
 
     std::copy(pk->rawData(), pk->rawData() + 232, data + boxOffset(box, slot));
+    markDirty(boxOffset(box, slot), 232);
+}
+
+PKX& Sav6::pkmView(PKXView& view, u8 box, u8 slot)
+{
+    return view.emplace<PK6>(data + boxOffset(box, slot), false, false, true);
 }
 
 void Sav6::trade(std::shared_ptr<PKX> pk)
@@ -137,7 +144,7 @@ void Sav6::trade(std::shared_ptr<PKX> pk)
     PK6 *pk6 = (PK6*)pk.get();
     if (pk6->egg())
     {
-        if (otName() != pk6->otName() || TID() != pk6->TID() || SID() != pk6->SID() || gender() != pk6->otGender())
+        if (otNameView() != pk6->otNameView() || TID() != pk6->TID() || SID() != pk6->SID() || gender() != pk6->otGender())
         {
             pk6->metDay(Configuration::getInstance().day());
             pk6->metMonth(Configuration::getInstance().month());
@@ -146,7 +153,7 @@ void Sav6::trade(std::shared_ptr<PKX> pk)
         }
         return;
     }
-    else if (otName() == pk6->otName() && TID() == pk6->TID() && SID() == pk6->SID() && gender() == pk6->otGender())
+    else if (otNameView() == pk6->otNameView() && TID() == pk6->TID() && SID() == pk6->SID() && gender() == pk6->otGender())
     {
         pk6->currentHandler(0);
 
@@ -163,7 +170,7 @@ void Sav6::trade(std::shared_ptr<PKX> pk)
     }
     else
     {
-        if (otName() != pk6->htName() || gender() != pk6->htGender() || (pk6->geoCountry(0) == 0 && pk6->geoRegion(0) == 0 && !pk6->untradedEvent()))
+        if (otNameView() != pk6->htNameView() || gender() != pk6->htGender() || (pk6->geoCountry(0) == 0 && pk6->geoRegion(0) == 0 && !pk6->untradedEvent()))
         {
             for (int i = 4; i > 0; i--)
             {
@@ -174,7 +181,7 @@ void Sav6::trade(std::shared_ptr<PKX> pk)
             pk6->geoRegion(subRegion());
         }
 
-        if (pk6->htName() != otName())
+        if (pk6->htNameView() != otNameView())
         {
             pk6->htFriendship(pk6->baseFriendship());
             pk6->htAffection(0);
@@ -215,17 +222,11 @@ void Sav6::trade(std::shared_ptr<PKX> pk)
 
 void Sav6::cryptBoxData(bool crypted)
 {
+    decryptedBoxes = crypted;
     for (u8 box = 0; box < boxes; box++)
     {
-        for (u8 slot = 0; slot < 30; slot++)
-        {
-            std::shared_ptr<PKX> pk6 = pkm(box, slot, crypted);
-            if (!crypted)
-            {
-                pk6->encrypt();
-            }
-            pkm(pk6, box, slot, false);
-        }
+        PKX::cryptBoxes(Generation::SIX, data + boxOffset(box, 0), 30, 232, crypted);
+        markDirty(boxOffset(box, 0), 30 * 232);
     }
 }
 
@@ -350,12 +351,19 @@ void Sav6::dex(std::shared_ptr<PKX> pk)
 
     // Owned quality flag
     if (origin < 0x18 && bit < 649 && game != Game::ORAS) // Species: 1-649 for X/Y, and not for ORAS; Set the Foreign Owned Flag
+    {
         data[ofs + 0x644] |= mask;
+        markDirty(ofs + 0x644);
+    }
     else if (origin >= 0x18 || game == Game::ORAS) // Set Native Owned Flag (should always happen)
+    {
         data[ofs + (brSize * 0)] |= mask;
+        markDirty(ofs + (brSize * 0));
+    }
 
     // Set the [Species/Gender/Shiny] Seen Flag
     data[ofs + shiftoff] |= mask;
+    markDirty(ofs + shiftoff);
 
     // Set the Display flag if none are set
     bool displayed = false;
@@ -364,18 +372,25 @@ void Sav6::dex(std::shared_ptr<PKX> pk)
     displayed |= (data[ofs + brSize * 7] & mask) != 0;
     displayed |= (data[ofs + brSize * 8] & mask) != 0;
     if (!displayed) // offset is already biased by brSize, reuse shiftoff but for the display flags.
+    {
         data[ofs + brSize * 4 + shiftoff] |= mask;
+        markDirty(ofs + brSize * 4 + shiftoff);
+    }
 
     // Set the Language
     if (lang < 0) lang = 1;
     data[PokeDexLanguageFlags + (bit * 7 + lang) / 8] |= (u8)(1 << ((bit * 7 + lang) % 8));
+    markDirty(PokeDexLanguageFlags + (bit * 7 + lang) / 8);
 
     // Set DexNav count (only if not encountered previously)
     if (game == Game::ORAS && *(u16*)(data + EncounterCount + (pk->species() - 1) * 2) == 0)
+    {
         *(u16*)(data + EncounterCount + (pk->species() - 1) * 2) = 1;
+        markDirty(EncounterCount + (pk->species() - 1) * 2, 2);
+    }
 
     // Set Form flags
-    int fc = PersonalXYORAS::formCount(pk->species());
+    int fc = Personal<Generation::SIX>::formCount(pk->species());
     int f = dexFormIndex(pk->species(), fc);
     if (f < 0) return;
 
@@ -385,6 +400,7 @@ void Sav6::dex(std::shared_ptr<PKX> pk)
 
     // Set Form Seen Flag
     data[formDex + formLen*shiny + bit/8] |= (u8)(1 << (bit%8));
+    markDirty(formDex + formLen*shiny + bit/8);
 
     // Set Displayed Flag if necessary, check all flags
     for (int i = 0; i < fc; i++)
@@ -397,6 +413,7 @@ void Sav6::dex(std::shared_ptr<PKX> pk)
     }
     bit = f + pk->alternativeForm();
     data[formDex + formLen * (2 + shiny) + bit / 8] |= (u8)(1 << (bit % 8));
+    markDirty(formDex + formLen * (2 + shiny) + bit / 8);
 }
 
 int Sav6::dexSeen(void) const
@@ -436,6 +453,8 @@ void Sav6::mysteryGift(WCX& wc, int& pos)
     WC6* wc6 = (WC6*)&wc;
     *(u8*)(data + WondercardFlags + wc6->ID()/8) |= 0x1 << (wc6->ID() % 8);
     std::copy(wc6->rawData(), wc6->rawData() + 264, data + WondercardData + 264*pos);
+    markDirty(WondercardFlags + wc6->ID()/8);
+    markDirty(WondercardData + 264*pos, 264);
     pos = (pos + 1) % 24;
 }
 
@@ -444,10 +463,11 @@ std::string Sav6::boxName(u8 box) const { return StringUtils::getString(data, PC
 void Sav6::boxName(u8 box, const std::string& name)
 {
     StringUtils::setString(data, name, PCLayout + 0x22*box, 17);
+    markDirty(PCLayout + 0x22*box, 34);
 }
 
 u8 Sav6::partyCount(void) const { return data[Party + 6*260]; }
-void Sav6::partyCount(u8 v) { data[Party + 6*260] = v; }
+void Sav6::partyCount(u8 v) { data[Party + 6*260] = v; markDirty(Party + 6*260); }
 
 std::shared_ptr<PKX> Sav6::emptyPkm() const
 {
@@ -512,18 +532,23 @@ void Sav6::item(Item& item, Pouch pouch, u16 slot)
     {
         case NormalItem:
             std::copy(write.first, write.first + write.second, data + PouchHeldItem + slot * 4);
+            markDirty(PouchHeldItem + slot * 4, write.second);
             break;
         case KeyItem:
             std::copy(write.first, write.first + write.second, data + PouchKeyItem + slot * 4);
+            markDirty(PouchKeyItem + slot * 4, write.second);
             break;
         case TM:
             std::copy(write.first, write.first + write.second, data + PouchTMHM + slot * 4);
+            markDirty(PouchTMHM + slot * 4, write.second);
             break;
         case Medicine:
             std::copy(write.first, write.first + write.second, data + PouchMedicine + slot * 4);
+            markDirty(PouchMedicine + slot * 4, write.second);
             break;
         case Berry:
             std::copy(write.first, write.first + write.second, data + PouchBerry + slot * 4);
+            markDirty(PouchBerry + slot * 4, write.second);
             break;
         default:
             return;
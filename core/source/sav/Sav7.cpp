@@ -25,17 +25,25 @@
 */
 
 #include "Sav7.hpp"
+#include "PKXView.hpp"
 
-u16 Sav7::check16(u8* buf, u32 blockID, u32 len) const
+u16 Sav7::check16(const u8* buf, u32 blockID, u32 len) const
 {
+    u16 chk = ~0;
+    u32 i = 0;
     if (blockID == 36)
     {
-        u8 tmp[0x80] = {0};
-        std::copy(tmp, tmp + 0x80, buf + 0x100);
+        // Block 36 is checksummed as if the 0x80 bytes at 0x100 were zero
+        for (; i < 0x100; i++)
+        {
+            chk = (crc16[(buf[i] ^ chk) & 0xFF] ^ chk >> 8);
+        }
+        for (; i < 0x180; i++)
+        {
+            chk = (crc16[chk & 0xFF] ^ chk >> 8);
+        }
     }
-
-    u16 chk = ~0;
-    for (u32 i = 0; i < len; i++)
+    for (; i < len; i++)
     {
         chk = (crc16[(buf[i] ^ chk) & 0xFF] ^ chk >> 8);
     }
@@ -43,37 +51,38 @@ u16 Sav7::check16(u8* buf, u32 blockID, u32 len) const
 }
 
 u16 Sav7::TID(void) const { return *(u16*)(data + TrainerCard); }
-void Sav7::TID(u16 v) { *(u16*)(data + TrainerCard) = v; }
+void Sav7::TID(u16 v) { *(u16*)(data + TrainerCard) = v; markDirty(TrainerCard, 2); }
 
 u16 Sav7::SID(void) const { return *(u16*)(data + TrainerCard + 2); }
-void Sav7::SID(u16 v) { *(u16*)(data + TrainerCard + 2) = v; }
+void Sav7::SID(u16 v) { *(u16*)(data + TrainerCard + 2) = v; markDirty(TrainerCard + 2, 2); }
 
 u8 Sav7::version(void) const { return data[TrainerCard + 4]; }
-void Sav7::version(u8 v) { data[TrainerCard + 4] = v; }
+void Sav7::version(u8 v) { data[TrainerCard + 4] = v; markDirty(TrainerCard + 4); }
 
 u8 Sav7::gender(void) const { return data[TrainerCard + 5]; }
-void Sav7::gender(u8 v) { data[TrainerCard + 5] = v; }
+void Sav7::gender(u8 v) { data[TrainerCard + 5] = v; markDirty(TrainerCard + 5); }
 
 u8 Sav7::subRegion(void) const { return data[TrainerCard + 0x2E]; }
-void Sav7::subRegion(u8 v) { data[TrainerCard + 0x2E] = v; }
+void Sav7::subRegion(u8 v) { data[TrainerCard + 0x2E] = v; markDirty(TrainerCard + 0x2E); }
 
 u8 Sav7::country(void) const { return data[TrainerCard + 0x2F]; }
-void Sav7::country(u8 v) { data[TrainerCard + 0x2F] = v; }
+void Sav7::country(u8 v) { data[TrainerCard + 0x2F] = v; markDirty(TrainerCard + 0x2F); }
 
 u8 Sav7::consoleRegion(void) const { return data[TrainerCard + 0x34]; }
-void Sav7::consoleRegion(u8 v) { data[TrainerCard + 0x34] = v; }
+void Sav7::consoleRegion(u8 v) { data[TrainerCard + 0x34] = v; markDirty(TrainerCard + 0x34); }
 
 u8 Sav7::language(void) const { return data[TrainerCard + 0x35]; }
-void Sav7::language(u8 v) { data[TrainerCard + 0x35] = v; }
+void Sav7::language(u8 v) { data[TrainerCard + 0x35] = v; markDirty(TrainerCard + 0x35); }
 
 std::string Sav7::otName(void) const { return StringUtils::getString(data, TrainerCard + 0x38, 13); }
-void Sav7::otName(const std::string& v) { return StringUtils::setString(data, v, TrainerCard + 0x38, 13); }
+std::u16string_view Sav7::otNameView(void) const { return StringUtils::getStringView(data, TrainerCard + 0x38, 13); }
+void Sav7::otName(const std::string& v) { StringUtils::setString(data, v, TrainerCard + 0x38, 13); markDirty(TrainerCard + 0x38, 26); }
 
 u32 Sav7::money(void) const { return *(u32*)(data + Misc + 0x4); }
-void Sav7::money(u32 v) { *(u32*)(data + Misc + 0x4) = v > 9999999 ? 9999999 : v; }
+void Sav7::money(u32 v) { *(u32*)(data + Misc + 0x4) = v > 9999999 ? 9999999 : v; markDirty(Misc + 0x4, 4); }
 
 u32 Sav7::BP(void) const { return *(u32*)(data + Misc + 0x11C); }
-void Sav7::BP(u32 v) { *(u32*)(data + Misc + 0x11C) = v > 9999 ? 9999 : v; }
+void Sav7::BP(u32 v) { *(u32*)(data + Misc + 0x11C) = v > 9999 ? 9999 : v; markDirty(Misc + 0x11C, 4); }
 
 u8 Sav7::badges(void) const
 {
@@ -87,16 +96,16 @@ u8 Sav7::badges(void) const
 }
 
 u16 Sav7::playedHours(void) const { return *(u16*)(data + PlayTime); }
-void Sav7::playedHours(u16 v) { *(u16*)(data + PlayTime) = v; }
+void Sav7::playedHours(u16 v) { *(u16*)(data + PlayTime) = v; markDirty(PlayTime, 2); }
 
 u8 Sav7::playedMinutes(void) const { return data[PlayTime + 2]; }
-void Sav7::playedMinutes(u8 v) { data[PlayTime + 2] = v; }
+void Sav7::playedMinutes(u8 v) { data[PlayTime + 2] = v; markDirty(PlayTime + 2); }
 
 u8 Sav7::playedSeconds(void) const { return data[PlayTime + 3]; }
-void Sav7::playedSeconds(u8 v) { data[PlayTime + 3] = v; }
+void Sav7::playedSeconds(u8 v) { data[PlayTime + 3] = v; markDirty(PlayTime + 3); }
 
 u8 Sav7::currentBox(void) const { return data[LastViewedBox]; }
-void Sav7::currentBox(u8 v) { data[LastViewedBox] = v; }
+void Sav7::currentBox(u8 v) { data[LastViewedBox] = v; markDirty(LastViewedBox); }
 
 u32 Sav7::boxOffset(u8 box, u8 slot) const { return Box + 232*30*box + 232*slot; }
 
@@ -104,9 +113,7 @@ u32 Sav7::partyOffset(u8 slot) const { return Party + 260*slot; }
 
 std::shared_ptr<PKX> Sav7::pkm(u8 slot) const
 {
-    u8 buf[260];
-    std::copy(data + partyOffset(slot), data + partyOffset(slot) + 260, buf);
-    return std::make_unique<PK7>(buf, true, true);
+    return PKX::create<PK7>(data + partyOffset(slot), true, true);
 }
 
 void Sav7::pkm(std::shared_ptr<PKX> pk, u8 slot)
@@ -117,24 +124,25 @@ void Sav7::pkm(std::shared_ptr<PKX> pk, u8 slot)
 
     if (pk->getLength() != 260)
     {
+        std::array<u16, 6> stats;
+        pk7->stats(stats);
         for (int i = 0; i < 6; i++)
         {
-            pk7->partyStat(i, pk7->stat(i));
+            pk7->partyStat(i, stats[i]);
         }
         pk7->partyLevel(pk7->level());
-        pk7->partyCurrHP(pk7->stat(0));
+        pk7->partyCurrHP(stats[0]);
     }
 
     pk7->encrypt();
     std::fill(data + partyOffset(slot), data + partyOffset(slot + 1), (u8)0);
     std::copy(pk7->rawData(), pk7->rawData() + pk7->getLength(), data + partyOffset(slot));
+    markDirty(partyOffset(slot), 260);
 }
 
 std::shared_ptr<PKX> Sav7::pkm(u8 box, u8 slot, bool ekx) const
 {
-    u8 buf[232];
-    std::copy(data + boxOffset(box, slot), data + boxOffset(box, slot) + 232, buf);
-    return std::make_unique<PK7>(buf, ekx);
+    return PKX::create<PK7>(data + boxOffset(box, slot), ekx);
 }
 
 void Sav7::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
@@ -146,6 +154,12 @@ void Sav7::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
     }
     
     std::copy(pk->rawData(), pk->rawData() + 232, data + boxOffset(box, slot));
+    markDirty(boxOffset(box, slot), 232);
+}
+
+PKX& Sav7::pkmView(PKXView& view, u8 box, u8 slot)
+{
+    return view.emplace<PK7>(data + boxOffset(box, slot), false, false, true);
 }
 
 void Sav7::trade(std::shared_ptr<PKX> pk)
@@ -153,7 +167,7 @@ void Sav7::trade(std::shared_ptr<PKX> pk)
     PK7 *pk7 = (PK7*)pk.get();
     if (pk7->egg())
     {
-        if (otName() != pk7->otName() || TID() != pk7->TID() || SID() != pk7->SID() || gender() != pk7->otGender())
+        if (otNameView() != pk7->otNameView() || TID() != pk7->TID() || SID() != pk7->SID() || gender() != pk7->otGender())
         {
             pk7->metDay(Configuration::getInstance().day());
             pk7->metMonth(Configuration::getInstance().month());
@@ -162,13 +176,13 @@ void Sav7::trade(std::shared_ptr<PKX> pk)
         }
         return;
     }
-    else if (otName() == pk7->otName() && TID() == pk7->TID() && SID() == pk7->SID() && gender() == pk7->otGender())
+    else if (otNameView() == pk7->otNameView() && TID() == pk7->TID() && SID() == pk7->SID() && gender() == pk7->otGender())
     {
         pk7->currentHandler(0);   
     }
     else
     {
-        if (pk7->htName() != otName())
+        if (pk7->htNameView() != otNameView())
         {
             pk7->htFriendship(pk7->baseFriendship());
             pk7->htAffection(0);
@@ -181,17 +195,11 @@ void Sav7::trade(std::shared_ptr<PKX> pk)
 
 void Sav7::cryptBoxData(bool crypted)
 {
+    decryptedBoxes = crypted;
     for (u8 box = 0; box < boxes; box++)
     {
-        for (u8 slot = 0; slot < 30; slot++)
-        {
-            std::shared_ptr<PKX> pk7 = pkm(box, slot, crypted);
-            if (!crypted)
-            {
-                pk7->encrypt();
-            }
-            pkm(pk7, box, slot, false);
-        }
+        PKX::cryptBoxes(Generation::SEVEN, data + boxOffset(box, 0), 30, 232, crypted);
+        markDirty(boxOffset(box, 0), 30 * 232);
     }
 }
 
@@ -207,6 +215,7 @@ void Sav7::setDexFlags(int index, int gender, int shiny, int baseSpecies)
 
     int brSeen = shift * brSize;
     data[ofs + brSeen + bd] |= (u8)(1 << bm);
+    markDirty(ofs + brSeen + bd);
 
     bool displayed = false;
     for (u8 i = 0; i < 4; i++)
@@ -227,6 +236,7 @@ void Sav7::setDexFlags(int index, int gender, int shiny, int baseSpecies)
         return;
 
     data[ofs + (4 + shift) * brSize + bd] |= (u8)(1 << bm);
+    markDirty(ofs + (4 + shift) * brSize + bd);
 }
 
 bool Sav7::sanitizeFormsToIterate(int species, int& fs, int& fe, int formIn) const
@@ -309,15 +319,18 @@ void Sav7::dex(std::shared_ptr<PKX> pk)
         { // Already 2
             *(u32*)(data + PokeDex + 0x8E8 + shift*4) = pk->encryptionConstant();
             data[PokeDex + 0x84] |= (u8)(1 << shift);
+            markDirty(PokeDex + 0x8E8 + shift*4, 4);
         }
         else if ((data[PokeDex + 0x84] & (1 << shift)) == 0) 
         { // Not yet 1
             data[PokeDex + 0x84] |= (u8)(1 << shift); // 1
         }
+        markDirty(PokeDex + 0x84);
     }
 
     int off = PokeDex + 0x08 + 0x80;
     data[off + bd] |= (u8)(1 << bm);
+    markDirty(off + bd);
 
     int formstart = pk->alternativeForm();
     int formend = formstart;
@@ -334,7 +347,7 @@ void Sav7::dex(std::shared_ptr<PKX> pk)
         int bitIndex = bit;
         if (form > 0)
         {
-            u8 fc = PersonalSMUSUM::formCount(pk->species());
+            u8 fc = Personal<Generation::SEVEN>::formCount(pk->species());
             if (fc > 1)
             { // actually has forms
                 int f = dexFormIndex(pk->species(), fc, MaxSpeciesID - 1);
@@ -354,7 +367,10 @@ void Sav7::dex(std::shared_ptr<PKX> pk)
         if (lang < 0) lang = 1;
         int lbit = bit * langCount + lang;
         if (lbit >> 3 < 920)
+        {
             data[PokeDexLanguageFlags + (lbit >> 3)] |= (u8)(1 << (lbit & 7));
+            markDirty(PokeDexLanguageFlags + (lbit >> 3));
+        }
     }
 }
 
@@ -394,6 +410,8 @@ void Sav7::mysteryGift(WCX& wc, int& pos)
     WC7* wc7 = (WC7*)&wc;
     *(u8*)(data + WondercardFlags + wc7->ID()/8) |= 0x1 << (wc7->ID() % 8);
     std::copy(wc7->rawData(), wc7->rawData() + 264, data + WondercardData + 264*pos);
+    markDirty(WondercardFlags + wc7->ID()/8);
+    markDirty(WondercardData + 264*pos, 264);
     pos = (pos + 1) % 48;
 }
 
@@ -405,10 +423,11 @@ std::string Sav7::boxName(u8 box) const
 void Sav7::boxName(u8 box, const std::string& name)
 {
     StringUtils::setString(data, name, PCLayout + 0x22*box, 17);
+    markDirty(PCLayout + 0x22*box, 34);
 }
 
 u8 Sav7::partyCount(void) const { return data[Party + 6*260]; }
-void Sav7::partyCount(u8 v) { data[Party + 6*260] = v; }
+void Sav7::partyCount(u8 v) { data[Party + 6*260] = v; markDirty(Party + 6*260); }
 
 std::shared_ptr<PKX> Sav7::emptyPkm() const
 {
@@ -473,24 +492,31 @@ void Sav7::item(Item& item, Pouch pouch, u16 slot)
     {
         case NormalItem:
             std::copy(write.first, write.first + write.second, data + PouchHeldItem + slot * 4);
+            markDirty(PouchHeldItem + slot * 4, write.second);
             break;
         case KeyItem:
             std::copy(write.first, write.first + write.second, data + PouchKeyItem + slot * 4);
+            markDirty(PouchKeyItem + slot * 4, write.second);
             break;
         case TM:
             std::copy(write.first, write.first + write.second, data + PouchTMHM + slot * 4);
+            markDirty(PouchTMHM + slot * 4, write.second);
             break;
         case Medicine:
             std::copy(write.first, write.first + write.second, data + PouchMedicine + slot * 4);
+            markDirty(PouchMedicine + slot * 4, write.second);
             break;
         case Berry:
             std::copy(write.first, write.first + write.second, data + PouchBerry + slot * 4);
+            markDirty(PouchBerry + slot * 4, write.second);
             break;
         case ZCrystals:
             std::copy(write.first, write.first + write.second, data + PouchZCrystals + slot * 4);
+            markDirty(PouchZCrystals + slot * 4, write.second);
             break;
         case Battle:
             std::copy(write.first, write.first + write.second, data + BattleItems + slot * 4);
+            markDirty(BattleItems + slot * 4, write.second);
             break;
         default:
             return;
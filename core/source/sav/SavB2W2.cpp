@@ -26,14 +26,13 @@
 
 #include "SavB2W2.hpp"
 
-SavB2W2::SavB2W2(u8* dt)
+SavB2W2::SavB2W2(std::unique_ptr<u8[]> dt)
 {
     length = 0x26000;
     boxes = 24;
     game = Game::B2W2;
     
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
     PCLayout = 0x0;
     Trainer1 = 0x19400;
@@ -57,18 +56,26 @@ SavB2W2::~SavB2W2() { }
 void SavB2W2::resign(void)
 {
     const u8 blockCount = 74;
-    u8* tmp = new u8[*std::max_element(lengths, lengths + blockCount)];
     u16 cs;
 
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + blockOfs[i], data + blockOfs[i] + lengths[i], tmp);
-        cs = ccitt16(tmp, lengths[i]);
-        *(u16*)(data + chkMirror[i]) = cs;
-        *(u16*)(data + chkofs[i]) = cs;
+        if (dirtyBlocks[i])
+        {
+            cs = ccitt16(data + blockOfs[i], lengths[i]);
+            *(u16*)(data + chkMirror[i]) = cs;
+            *(u16*)(data + chkofs[i]) = cs;
+            // The mirror table is itself the last checksummed block, which is visited after this one
+            markDirty(chkMirror[i], 2);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
+}
+
+void SavB2W2::markDirty(u32 offset, u32 size)
+{
+    markBlocks(blockOfs, lengths, offset, size);
 }
 
 std::map<Pouch, std::vector<int>> SavB2W2::validItems() const
@@ -26,14 +26,13 @@
 
 #include "SavBW.hpp"
 
-SavBW::SavBW(u8* dt)
+SavBW::SavBW(std::unique_ptr<u8[]> dt)
 {
     length = 0x24000;
     boxes = 24;
     game = Game::BW;
     
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
     PCLayout = 0x0;
     Trainer1 = 0x19400;
@@ -57,18 +56,26 @@ SavBW::~SavBW() { }
 void SavBW::resign(void)
 {
     const u8 blockCount = 70;
-    u8* tmp = new u8[*std::max_element(lengths, lengths + blockCount)];
     u16 cs;
 
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + blockOfs[i], data + blockOfs[i] + lengths[i], tmp);
-        cs = ccitt16(tmp, lengths[i]);
-        *(u16*)(data + chkMirror[i]) = cs;
-        *(u16*)(data + chkofs[i]) = cs;
+        if (dirtyBlocks[i])
+        {
+            cs = ccitt16(data + blockOfs[i], lengths[i]);
+            *(u16*)(data + chkMirror[i]) = cs;
+            *(u16*)(data + chkofs[i]) = cs;
+            // The mirror table is itself the last checksummed block, which is visited after this one
+            markDirty(chkMirror[i], 2);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
+}
+
+void SavBW::markDirty(u32 offset, u32 size)
+{
+    markBlocks(blockOfs, lengths, offset, size);
 }
 
 std::map<Pouch, std::vector<int>> SavBW::validItems() const
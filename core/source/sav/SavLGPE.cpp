@@ -25,20 +25,21 @@
 */
 
 #include "SavLGPE.hpp"
+#include "PKXView.hpp"
 #include "PB7.hpp"
 #include "gui.hpp"
 #include "WB7.hpp"
 #include "random.hpp"
 
-SavLGPE::SavLGPE(u8* dt)
+SavLGPE::SavLGPE(std::unique_ptr<u8[]> dt, size_t size)
 {
-    length = 0x100000;
+    // Everything used is in the first 0xB8800 bytes, so both file sizes are kept as they are
+    length = size;
     boxes = 34; // Ish
     game = Game::LGPE;
     PokeDex = 0x2A00;
 
-    data = new u8[length]{0};
-    std::copy(dt, dt + 0xB8800, data);
+    data = dt.release();
 }
 
 SavLGPE::~SavLGPE() {}
@@ -56,6 +57,7 @@ u16 SavLGPE::partyBoxSlot(u8 slot) const
 void SavLGPE::partyBoxSlot(u8 slot, u16 v)
 {
     *(u16*)(data + 0x5A00 + slot * 2) = v;
+    markDirty(0x5A00 + slot * 2, 2);
 }
 
 u32 SavLGPE::partyOffset(u8 slot) const
@@ -76,6 +78,7 @@ u16 SavLGPE::boxedPkm() const
 void SavLGPE::boxedPkm(u16 v)
 {
     *(u16*)(data + 0x5A00 + 14) = v;
+    markDirty(0x5A00 + 14, 2);
 }
 
 u16 SavLGPE::followPkm() const
@@ -86,6 +89,7 @@ u16 SavLGPE::followPkm() const
 void SavLGPE::followPkm(u16 v)
 {
     *(u16*)(data + 0x5A00 + 12) = v;
+    markDirty(0x5A00 + 12, 2);
 }
 
 u8 SavLGPE::partyCount() const
@@ -145,6 +149,8 @@ void SavLGPE::compressBox()
                 std::copy(data + emptyOffset, data + emptyOffset + 260, emptyData);
                 std::copy(data + offset, data + offset + 260, data + emptyOffset);
                 std::copy(emptyData, emptyData + 260, data + offset);
+                markDirty(emptyOffset, 260);
+                markDirty(offset, 260);
                 for (int j = 0; j < partyCount(); j++)
                 {
                     if (partyBoxSlot(j) == i)
@@ -162,7 +168,7 @@ void SavLGPE::compressBox()
     }
 }
 
-u16 SavLGPE::check16(u8* buf, u32 blockID, u32 len) const
+u16 SavLGPE::check16(const u8* buf, u32 blockID, u32 len) const
 {
     u16 chk = 0;
     for (u32 i = 0; i < len; i++)
@@ -172,19 +178,25 @@ u16 SavLGPE::check16(u8* buf, u32 blockID, u32 len) const
     return chk;
 }
 
-void SavLGPE::resign()
+void SavLGPE::resign(void)
 {
     const u8 blockCount = 21;
-    u8* tmp = new u8[*std::max_element(chklen, chklen + blockCount)];
     const u32 csoff = 0xB861A;
 
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + chkofs[i], data + chkofs[i] + chklen[i], tmp);
-        *(u16*)(data + csoff + i*8) = check16(tmp, *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        if (dirtyBlocks[i])
+        {
+            *(u16*)(data + csoff + i*8) = check16(data + chkofs[i], *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
+}
+
+void SavLGPE::markDirty(u32 offset, u32 size)
+{
+    markBlocks(chkofs, chklen, offset, size);
 }
 
 u16 SavLGPE::TID() const
@@ -195,6 +207,7 @@ u16 SavLGPE::TID() const
 void SavLGPE::TID(u16 v)
 {
     *(u16*)(data + 0x1000) = v;
+    markDirty(0x1000, 2);
 }
 
 u16 SavLGPE::SID() const
@@ -205,6 +218,7 @@ u16 SavLGPE::SID() const
 void SavLGPE::SID(u16 v)
 {
     *(u16*)(data + 0x1002) = v;
+    markDirty(0x1002, 2);
 }
 
 u8 SavLGPE::version() const
@@ -215,6 +229,7 @@ u8 SavLGPE::version() const
 void SavLGPE::version(u8 v)
 {
     *(data + 0x1004) = v;
+    markDirty(0x1004);
 }
 
 u8 SavLGPE::gender() const
@@ -225,6 +240,7 @@ u8 SavLGPE::gender() const
 void SavLGPE::gender(u8 v)
 {
     *(data + 0x1005) = v;
+    markDirty(0x1005);
 }
 
 u8 SavLGPE::language() const
@@ -235,6 +251,7 @@ u8 SavLGPE::language() const
 void SavLGPE::language(u8 v)
 {
     *(data + 0x1035) = v;
+    markDirty(0x1035);
 }
 
 std::string SavLGPE::otName() const
@@ -245,6 +262,12 @@ std::string SavLGPE::otName() const
 void SavLGPE::otName(const std::string& v)
 {
     StringUtils::setString(data, v, 0x1000 + 0x38, 13);
+    markDirty(0x1000 + 0x38, 26);
+}
+
+std::u16string_view SavLGPE::otNameView() const
+{
+    return StringUtils::getStringView(data, 0x1000 + 0x38, 13);
 }
 
 u32 SavLGPE::money() const
@@ -255,6 +278,7 @@ u32 SavLGPE::money() const
 void SavLGPE::money(u32 v)
 {
     *(u32*)(data + 0x4C04) = v;
+    markDirty(0x4C04, 4);
 }
 
 u8 SavLGPE::badges() const
@@ -283,6 +307,7 @@ u16 SavLGPE::playedHours(void) const
 void SavLGPE::playedHours(u16 v)
 {
     *(u16*)(data + 0x45400) = v;
+    markDirty(0x45400, 2);
 }
 
 u8 SavLGPE::playedMinutes(void) const
@@ -293,6 +318,7 @@ u8 SavLGPE::playedMinutes(void) const
 void SavLGPE::playedMinutes(u8 v)
 {
     *(data + 0x45402) = v;
+    markDirty(0x45402);
 }
 
 u8 SavLGPE::playedSeconds(void) const
@@ -303,6 +329,7 @@ u8 SavLGPE::playedSeconds(void) const
 void SavLGPE::playedSeconds(u8 v)
 {
     *(data + 0x45403) = v;
+    markDirty(0x45403);
 }
     
 std::shared_ptr<PKX> SavLGPE::pkm(u8 slot) const
@@ -310,7 +337,7 @@ std::shared_ptr<PKX> SavLGPE::pkm(u8 slot) const
     u32 off = partyOffset(slot);
     if (off != 0)
     {
-        return std::make_shared<PB7>(data + off);
+        return PKX::create<PB7>(data + off);
     }
     else
     {
@@ -320,7 +347,7 @@ std::shared_ptr<PKX> SavLGPE::pkm(u8 slot) const
 
 std::shared_ptr<PKX> SavLGPE::pkm(u8 box, u8 slot, bool ekx) const
 {
-    return std::make_shared<PB7>(data + boxOffset(box, slot), ekx);
+    return PKX::create<PB7>(data + boxOffset(box, slot), ekx);
 }
 
 void SavLGPE::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
@@ -330,6 +357,12 @@ void SavLGPE::pkm(std::shared_ptr<PKX> pk, u8 box, u8 slot, bool applyTrade)
         trade(pk);
     }
     std::copy(pk->rawData(), pk->rawData() + pk->getLength(), data + boxOffset(box, slot));
+    markDirty(boxOffset(box, slot), pk->getLength());
+}
+
+PKX& SavLGPE::pkmView(PKXView& view, u8 box, u8 slot)
+{
+    return view.emplace<PB7>(data + boxOffset(box, slot), false, true);
 }
 
 void SavLGPE::pkm(std::shared_ptr<PKX> pk, u8 slot)
@@ -341,6 +374,7 @@ void SavLGPE::pkm(std::shared_ptr<PKX> pk, u8 slot)
         if (off != 0)
         {
             std::fill_n(data + off, 260, 0);
+            markDirty(off, 260);
         }
         partyBoxSlot(slot, 1001);
         return;
@@ -364,26 +398,27 @@ void SavLGPE::pkm(std::shared_ptr<PKX> pk, u8 slot)
     }
 
     std::copy(pk->rawData(), pk->rawData() + pk->getLength(), data + off);
+    markDirty(off, pk->getLength());
     partyBoxSlot(slot, newSlot);
 }
 
 void SavLGPE::trade(std::shared_ptr<PKX> pk)
 {
     PB7 *pb7 = (PB7*)pk.get();
-    if (pb7->egg() && !(otName() == pb7->otName() && TID() == pb7->TID() && SID() == pb7->SID() && gender() == pb7->otGender()))
+    if (pb7->egg() && !(otNameView() == pb7->otNameView() && TID() == pb7->TID() && SID() == pb7->SID() && gender() == pb7->otGender()))
     {
         pb7->metDay(Configuration::getInstance().day());
         pb7->metMonth(Configuration::getInstance().month());
         pb7->metYear(Configuration::getInstance().year() - 2000);
         pb7->metLocation(30002);
     }
-    else if (!(otName() == pb7->otName() && TID() == pb7->TID() && SID() == pb7->SID() && gender() == pb7->otGender()))
+    else if (!(otNameView() == pb7->otNameView() && TID() == pb7->TID() && SID() == pb7->SID() && gender() == pb7->otGender()))
     {
         pb7->currentHandler(0);
     }
     else
     {
-        if (pb7->htName() != otName())
+        if (pb7->htNameView() != otNameView())
         {
             pb7->htFriendship(pb7->currentFriendship());// copy friendship instead of resetting (don't alter CP)
             pb7->htAffection(0);
@@ -470,6 +505,7 @@ void SavLGPE::setDexFlags(int index, int gender, int shiny, int baseSpecies)
 
     int brSeen = shift * brSize;
     data[off + brSeen + bd] |= (u8)(1 << bm);
+    markDirty(off + brSeen + bd);
 
     bool displayed = false;
     for (u8 i = 0; i < 4; i++)
@@ -490,6 +526,7 @@ void SavLGPE::setDexFlags(int index, int gender, int shiny, int baseSpecies)
         return;
 
     data[off + (4 + shift) * brSize + bd] |= (u8)(1 << bm);
+    markDirty(off + (4 + shift) * brSize + bd);
 }
 
 void SavLGPE::dex(std::shared_ptr<PKX> pk)
@@ -517,15 +554,18 @@ void SavLGPE::dex(std::shared_ptr<PKX> pk)
         { // Already 2
             *(u32*)(data + PokeDex + 0x8E8 + shift*4) = pk->encryptionConstant();
             data[PokeDex + 0x84] |= (u8)(1 << shift);
+            markDirty(PokeDex + 0x8E8 + shift*4, 4);
         }
         else if ((data[PokeDex + 0x84] & (1 << shift)) == 0) 
         { // Not yet 1
             data[PokeDex + 0x84] |= (u8)(1 << shift); // 1
         }
+        markDirty(PokeDex + 0x84);
     }
 
     int off = PokeDex + 0x08 + 0x80;
     data[off + bd] |= (u8)(1 << bm);
+    markDirty(off + bd);
 
     int formstart = pk->alternativeForm();
     int formend = formstart;
@@ -542,7 +582,7 @@ void SavLGPE::dex(std::shared_ptr<PKX> pk)
         int bitIndex = bit;
         if (form > 0)
         {
-            u8 fc = dexFormCount(n); // TODO: PersonalLGPE::formCount(n);
+            u8 fc = dexFormCount(n); // TODO: Personal<Generation::LGPE>::formCount(n);
             if (fc > 1)
             { // actually has forms
                 int f = dexFormIndex(n, fc, MaxSpeciesID - 1);
@@ -562,7 +602,10 @@ void SavLGPE::dex(std::shared_ptr<PKX> pk)
         if (lang < 0) lang = 1;
         int lbit = bit * langCount + lang;
         if (lbit >> 3 < 920)
+        {
             data[PokeDexLanguageFlags + (lbit >> 3)] |= (u8)(1 << (lbit & 7));
+            markDirty(PokeDexLanguageFlags + (lbit >> 3));
+        }
     }
 }
 
@@ -599,22 +642,9 @@ int SavLGPE::dexCaught(void) const
 
 void SavLGPE::cryptBoxData(bool crypted)
 {
-    for (u8 box = 0; box < maxBoxes(); box++)
-    {
-        for (u8 slot = 0; slot < 30; slot++)
-        {
-            if (box * 30 + slot > 1000)
-            {
-                return;
-            }
-            auto pb7 = pkm(box, slot, crypted);
-            if (!crypted)
-            {
-                pb7->encrypt();
-            }
-            pkm(pb7, box, slot, false);
-        }
-    }
+    decryptedBoxes = crypted;
+    PKX::cryptBoxes(Generation::LGPE, data + boxOffset(0, 0), maxSlot(), 260, crypted);
+    markDirty(boxOffset(0, 0), maxSlot() * 260);
 }
 
 void SavLGPE::mysteryGift(WCX& wc, int& pos)
@@ -695,7 +725,7 @@ void SavLGPE::mysteryGift(WCX& wc, int& pos)
         }
         if (wb7->nickname((Language)language()).length() == 0)
         {
-            pkm->nickname(i18n::species(language(), pkm->species()));
+            pkm->nickname(std::string(i18n::species(language(), pkm->species())));
         }
         else
         {
@@ -714,7 +744,7 @@ void SavLGPE::mysteryGift(WCX& wc, int& pos)
             pkm->htName(otName());
             pkm->otGender(wb7->otGender());
             pkm->htGender(gender());
-            pkm->otFriendship(PersonalLGPE::baseFriendship(pkm->formSpecies()));
+            pkm->otFriendship(Personal<Generation::LGPE>::baseFriendship(pkm->formSpecies()));
             pkm->currentHandler(1);
         }
 
@@ -799,20 +829,22 @@ void SavLGPE::mysteryGift(WCX& wc, int& pos)
             pkm->eggYear(wb7->year());
             pkm->eggMonth(wb7->month());
             pkm->eggDay(wb7->day());
-            pkm->nickname(i18n::species(language(), pkm->species()));
+            pkm->nickname(std::string(i18n::species(language(), pkm->species())));
             pkm->nicknamed(true);
         }
 
         pkm->metDay(wb7->day());
         pkm->metMonth(wb7->month());
         pkm->metYear(wb7->year());
-        pkm->currentFriendship(PersonalLGPE::baseFriendship(pkm->formSpecies()));
+        pkm->currentFriendship(Personal<Generation::LGPE>::baseFriendship(pkm->formSpecies()));
 
         pkm->partyCP(pkm->CP());
-        pkm->partyCurrHP(pkm->stat(0));
+        std::array<u16, 6> stats;
+        pkm->stats(stats);
+        pkm->partyCurrHP(stats[0]);
         for (int i = 0; i < 6; i++)
         {
-            pkm->partyStat(pkm->stat(i));
+            pkm->partyStat(i, stats[i]);
         }
         
         pkm->height(randomNumbers() % 256);
@@ -990,6 +1022,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 60)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + slot * 4);
+                markDirty(slot * 4, writeData.second);
             }
             else
             {
@@ -1000,6 +1033,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 108)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0xF0 + slot * 4);
+                markDirty(0xF0 + slot * 4, writeData.second);
             }
             else
             {
@@ -1010,6 +1044,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 200)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0x2A0 + slot * 4);
+                markDirty(0x2A0 + slot * 4, writeData.second);
             }
             else
             {
@@ -1020,6 +1055,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 150)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0x5C0 + slot * 4);
+                markDirty(0x5C0 + slot * 4, writeData.second);
             }
             else
             {
@@ -1030,6 +1066,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 50)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0x818 + slot * 4);
+                markDirty(0x818 + slot * 4, writeData.second);
             }
             else
             {
@@ -1040,6 +1077,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 150)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0x8E0 + slot * 4);
+                markDirty(0x8E0 + slot * 4, writeData.second);
             }
             else
             {
@@ -1051,6 +1089,7 @@ void SavLGPE::item(Item& item, Pouch pouch, u16 slot)
             if (slot < 150)
             {
                 std::copy(writeData.first, writeData.first + writeData.second, data + 0xB38 + slot * 4);
+                markDirty(0xB38 + slot * 4, writeData.second);
             }
             else
             {
@@ -26,14 +26,13 @@
 
 #include "SavORAS.hpp"
 
-SavORAS::SavORAS(u8* dt)
+SavORAS::SavORAS(std::unique_ptr<u8[]> dt)
 {
     length = 0x76000;
     boxes = 31;
     game = Game::ORAS;
 
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
     TrainerCard = 0x14000;
     Trainer2 = 0x04200;
@@ -57,16 +56,22 @@ SavORAS::SavORAS(u8* dt)
 void SavORAS::resign(void)
 {
     const u8 blockCount = 58;
-    u8* tmp = new u8[*std::max_element(chklen, chklen + blockCount)];
     const u32 csoff = 0x75E1A;
 
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + chkofs[i], data + chkofs[i] + chklen[i], tmp);
-        *(u16*)(data + csoff + i*8) =  ccitt16(tmp, chklen[i]);
+        if (dirtyBlocks[i])
+        {
+            *(u16*)(data + csoff + i*8) = ccitt16(data + chkofs[i], chklen[i]);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
+}
+
+void SavORAS::markDirty(u32 offset, u32 size)
+{
+    markBlocks(chkofs, chklen, offset, size);
 }
 
 std::map<Pouch, std::vector<int>> SavORAS::validItems() const
@@ -27,17 +27,14 @@
 #include "SavPT.hpp"
 #include "PGT.hpp"
 
-SavPT::SavPT(u8* dt)
+SavPT::SavPT(std::unique_ptr<u8[]> dt)
 {
     length = 0x80000;
     boxes = 18;
     game = Game::Pt;
 
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
-    GBOOffset = 0xCF1C;
-    SBOOffset = 0x1F100;
     GBO();
     SBO();
 
@@ -26,14 +26,13 @@
 
 #include "SavSUMO.hpp"
 
-SavSUMO::SavSUMO(u8* dt)
+SavSUMO::SavSUMO(std::unique_ptr<u8[]> dt)
 {
     length = 0x6BE00;
     boxes = 32;
     game = Game::SM;
     
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
     TrainerCard = 0x1200;
     Misc = 0x4000;
@@ -57,16 +56,22 @@ SavSUMO::SavSUMO(u8* dt)
 void SavSUMO::resign(void)
 {
     const u8 blockCount = 37;
-    u8* tmp = new u8[*std::max_element(chklen, chklen + blockCount)];
     const u32 csoff = 0x6BC1A;
 
+    // The last resign wrote its signature into block 36 after checksumming that block, so the stored
+    // checksum covers the signature before it. Re-checksum the block every time, as resigning every
+    // block did, so the output stays the same
+    markDirty(0x6BB00, 0x80);
+
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + chkofs[i], data + chkofs[i] + chklen[i], tmp);
-        *(u16*)(data + csoff + i*8) = check16(tmp, *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        if (dirtyBlocks[i])
+        {
+            *(u16*)(data + csoff + i*8) = check16(data + chkofs[i], *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
 
     const u32 checksumTableOffset = 0x6BC00;
     const u32 checksumTableLength = 0x140;
@@ -89,6 +94,11 @@ void SavSUMO::resign(void)
     std::copy(currentSignature, currentSignature + 0x80, data + memecryptoOffset);
 }
 
+void SavSUMO::markDirty(u32 offset, u32 size)
+{
+    markBlocks(chkofs, chklen, offset, size);
+}
+
 int SavSUMO::dexFormIndex(int species, int formct, int start) const
 {
     int formindex = start;
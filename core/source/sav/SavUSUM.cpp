@@ -26,14 +26,13 @@
 
 #include "SavUSUM.hpp"
 
-SavUSUM::SavUSUM(u8* dt)
+SavUSUM::SavUSUM(std::unique_ptr<u8[]> dt)
 {
     length = 0x6CC00;
     boxes = 32;
     game = Game::USUM;
     
-    data = new u8[length];
-    std::copy(dt, dt + length, data);
+    data = dt.release();
 
     TrainerCard = 0x1400;
     Misc = 0x4400;
@@ -58,16 +57,22 @@ SavUSUM::SavUSUM(u8* dt)
 void SavUSUM::resign(void)
 {
     const u8 blockCount = 39;
-    u8* tmp = new u8[*std::max_element(chklen, chklen + blockCount)];
     const u32 csoff = 0x6CA1A;
 
+    // The last resign wrote its signature into block 36 after checksumming that block, so the stored
+    // checksum covers the signature before it. Re-checksum the block every time, as resigning every
+    // block did, so the output stays the same
+    markDirty(0x6C100, 0x80);
+
     for (u8 i = 0; i < blockCount; i++)
     {
-        std::copy(data + chkofs[i], data + chkofs[i] + chklen[i], tmp);
-        *(u16*)(data + csoff + i*8) = check16(tmp, *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        if (dirtyBlocks[i])
+        {
+            *(u16*)(data + csoff + i*8) = check16(data + chkofs[i], *(u16*)(data + csoff + i*8 - 2), chklen[i]);
+        }
     }
 
-    delete[] tmp;
+    dirtyBlocks.reset();
 
     const u32 checksumTableOffset = 0x6CA00;
     const u32 checksumTableLength = 0x150;
@@ -90,6 +95,11 @@ void SavUSUM::resign(void)
     std::copy(currentSignature, currentSignature + 0x80, data + memecryptoOffset);
 }
 
+void SavUSUM::markDirty(u32 offset, u32 size)
+{
+    markBlocks(chkofs, chklen, offset, size);
+}
+
 int SavUSUM::dexFormIndex(int species, int formct, int start) const
 {
     int formindex = start;
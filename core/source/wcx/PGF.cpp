@@ -116,7 +116,7 @@ u16 PGF::ability(void) const
 	else if (type == 4) abilitynum = 2;
 	else abilitynum = 0;
 
-	return PersonalBWB2W2::ability(species(), abilitynum);
+	return Personal<Generation::FIVE>::ability(species(), abilitynum);
 }
 
 u16 PGF::eggLocation(void) const { return *(u16*)(data + 0x38); }
@@ -135,12 +135,12 @@ u16 PGF::formSpecies(void) const
 {
 	u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalBWB2W2::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::FIVE>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalBWB2W2::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::FIVE>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
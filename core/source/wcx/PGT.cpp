@@ -214,12 +214,12 @@ u16 PGT::formSpecies(void) const
 {
     u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalDPPtHGSS::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::FOUR>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalDPPtHGSS::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::FOUR>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
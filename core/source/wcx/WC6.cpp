@@ -131,7 +131,7 @@ u16 WC6::ability(void) const
 	else if (type == 4) abilitynum = 2;
 	else abilitynum = 0;
 	
-	return PersonalXYORAS::ability(species(), abilitynum);
+	return Personal<Generation::SIX>::ability(species(), abilitynum);
 }
 
 u8 WC6::abilityType(void) const { return *(u8*)(data + 0xA2); }
@@ -182,12 +182,12 @@ u16 WC6::formSpecies(void) const
 {
 	u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalXYORAS::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::SIX>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalXYORAS::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::SIX>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;
@@ -148,7 +148,7 @@ u16 WC7::ability(void) const
 	else if (type == 4) abilitynum = 2;
 	else abilitynum = 0;
 
-	return PersonalSMUSUM::ability(species(), abilitynum);
+	return Personal<Generation::SEVEN>::ability(species(), abilitynum);
 }
 
 u8 WC7::abilityType(void) const { return *(u8*)(data + 0xA2); }
@@ -199,12 +199,12 @@ u16 WC7::formSpecies(void) const
 {
 	u16 tmpSpecies = species();
     u8 form = alternativeForm();
-    u8 formcount = PersonalSMUSUM::formCount(tmpSpecies);
+    u8 formcount = Personal<Generation::SEVEN>::formCount(tmpSpecies);
 
     if (form && form < formcount)
     {
         u16 backSpecies = tmpSpecies;
-        tmpSpecies = PersonalSMUSUM::formStatIndex(tmpSpecies);
+        tmpSpecies = Personal<Generation::SEVEN>::formStatIndex(tmpSpecies);
         if (!tmpSpecies)
         {
             tmpSpecies = backSpecies;